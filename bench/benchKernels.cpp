@@ -0,0 +1,386 @@
+//  
+//       ,---.     ,--,    .---.     ,--,    ,---.    .-. .-. 
+//       | .-'   .' .')   / .-. )  .' .'     | .-'    |  \| | 
+//       | `-.   |  |(_)  | | |(_) |  |  __  | `-.    |   | | 
+//       | .-'   \  \     | | | |  \  \ ( _) | .-'    | |\  | 
+//       |  `--.  \  `-.  \ `-' /   \  `-) ) |  `--.  | | |)| 
+//       /( __.'   \____\  )---'    )\____/  /( __.'  /(  (_) 
+//      (__)              (_)      (__)     (__)     (__)     
+//
+//  This file is part of ECOGEN.
+//
+//  ECOGEN is the legal property of its developers, whose names 
+//  are listed in the copyright file included with this source 
+//  distribution.
+//
+//  ECOGEN is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, 
+//  or (at your option) any later version.
+//  
+//  ECOGEN is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with ECOGEN (file LICENSE).  
+//  If not, see <http://www.gnu.org/licenses/>.
+
+
+//! \file      benchKernels.cpp
+//! \version   1.0
+//! \brief     Micro-benchmarks of the solver kernels (Riemann solvers, EOS, relaxations, limiters, gradients)
+//! \details   Standalone executable built with "make bench". Kernels are called on synthetic randomized
+//!            states on a single core, no MPI launch is required:
+//!            ./ECOGEN_bench [-n numberStates] [-r repetitions] [-s seed] [filter]
+//!            Only kernels whose name contains the filter string are run.
+
+#include <random>
+#include <iomanip>
+#include "../src/Run.h"
+
+using namespace std;
+using namespace tinyxml2;
+
+static volatile double sink(0.); //!<Result accumulator preventing the compiler to drop benchmarked calls
+
+//***********************************************************************
+
+//! \brief    Synthetic states for one flow model
+struct BenchModel
+{
+  BenchModel(const string &nameModel, Model *modelBench, const int &phases, bool wall, bool inflow, bool tank, bool outflow) :
+    name(nameModel), model(modelBench), numberPhases(phases), boundaries{ wall, inflow, tank, outflow } {}
+
+  string name;
+  Model *model;
+  int numberPhases;
+  bool boundaries[4];                //!<Wall, inflow, tank and outflow Riemann solvers available
+  vector<Cell*> cells;
+};
+
+//***********************************************************************
+
+class Bench
+{
+public:
+  Bench(const int &numberStates, const int &repetitions, const string &filter) :
+    m_numberStates(numberStates), m_repetitions(repetitions), m_filter(filter) {}
+
+  //! \brief    Time a kernel called on the numberStates synthetic states, repetitions times
+  //! \param    name      name of the kernel
+  //! \param    prepare   untimed functor called before each sweep (restoring states modified by the kernel)
+  //! \param    kernel    functor called with the state index and returning a value to accumulate
+  template<typename Prepare, typename Kernel>
+  void run(const string &name, Prepare prepare, Kernel kernel)
+  {
+    if (m_filter != "" && name.find(m_filter) == string::npos) return;
+    errors.clear();
+    double accumulate(0.), seconds(0.);
+    //Untimed warm-up sweep
+    prepare();
+    for (int i = 0; i < m_numberStates; i++) { accumulate += kernel(i); }
+    for (int r = 0; r < m_repetitions; r++) {
+      prepare();
+      double start(timeStats::wallTime());
+      for (int i = 0; i < m_numberStates; i++) { accumulate += kernel(i); }
+      seconds += timeStats::wallTime() - start;
+    }
+    sink = sink + accumulate;
+    double calls(static_cast<double>(m_numberStates)*m_repetitions);
+    cout << " " << left << setw(44) << name << right << fixed
+      << setprecision(1) << setw(12) << seconds / calls*1.e9
+      << setprecision(2) << setw(14) << calls / seconds*1.e-6;
+    if (errors.size()) cout << "   (" << errors.size() << " solver errors)";
+    cout << endl;
+    errors.clear();
+  }
+
+  template<typename Kernel>
+  void run(const string &name, Kernel kernel) { this->run(name, []() {}, kernel); }
+
+private:
+  int m_numberStates;
+  int m_repetitions;
+  string m_filter;
+};
+
+//***********************************************************************
+
+static double uniform(mt19937 &generator, const double &min, const double &max)
+{
+  return uniform_real_distribution<double>(min, max)(generator);
+}
+
+//***********************************************************************
+
+//! \brief    Build a stiffened gas EOS
+static Eos* createEosSG(int number, const string &name, double gamma, double pInf, double cv, double eRef, double sRef)
+{
+  vector<string> nameParameterEos;
+  Eos *eos = new EosSG(nameParameterEos, number);
+  eos->assignParametersEos(name, vector<double>{ gamma, pInf, cv, eRef, sRef });
+  return eos;
+}
+
+//***********************************************************************
+
+//! \brief    Build an ideal gas EOS
+static Eos* createEosIG(int number, const string &name, double gamma, double cv, double eRef, double sRef)
+{
+  vector<string> nameParameterEos;
+  Eos *eos = new EosIG(nameParameterEos, number);
+  eos->assignParametersEos(name, vector<double>{ gamma, cv, eRef, sRef });
+  return eos;
+}
+
+//***********************************************************************
+
+//! \brief    Fill a cell with a random state consistent with the requirements of its model fulfillState()
+static void randomState(Cell *cell, const string &model, Eos **eos, const int &numberPhases, mt19937 &generator)
+{
+  Coord velocity(uniform(generator, -1., 1.), uniform(generator, -1., 1.), uniform(generator, -1., 1.));
+  double pressure(uniform(generator, 0.8e5, 1.2e5));
+  double alpha(uniform(generator, 0.01, 0.99));
+  for (int k = 0; k < numberPhases; k++) {
+    Phase *phase(cell->getPhase(k));
+    phase->setEos(eos[k]);
+    phase->setAlpha(numberPhases == 1 ? 1. : (k == 0 ? alpha : 1. - alpha));
+  }
+  if (model == "EULER") {
+    Phase *phase(cell->getPhase(0));
+    phase->setDensity(uniform(generator, 0.5, 2.));
+    phase->setPressure(pressure);
+    phase->setVelocity(velocity);
+  }
+  else if (model == "KAPILA" || model == "MULTIP") {
+    //Phasic pressures are not in equilibrium so that relaxations have some work to do
+    cell->getPhase(0)->setDensity(uniform(generator, 950., 1050.));
+    cell->getPhase(1)->setDensity(uniform(generator, 0.4, 0.8));
+    for (int k = 0; k < numberPhases; k++) { cell->getPhase(k)->setPressure(pressure*uniform(generator, 0.9, 1.1)); }
+    cell->getMixture()->setVelocity(velocity);
+  }
+  else if (model == "THERMALEQ") {
+    cell->getMixture()->setPressure(pressure);
+    cell->getMixture()->setScalar(3, uniform(generator, 350., 450.)); //Temperature
+    cell->getMixture()->setVelocity(velocity);
+  }
+  else if (model == "EULERHOMOGENEOUS") {
+    cell->getMixture()->setPressure(pressure);
+    cell->getMixture()->setVelocity(velocity);
+  }
+  cell->completeFulfillState();
+}
+
+//***********************************************************************
+
+int main(int argc, char* argv[])
+{
+  //Single CPU, MPI is never initialized
+  rankCpu = 0;
+  Ncpu = 1;
+
+  int numberStates(4096), repetitions(200), seed(1);
+  string filter("");
+  for (int a = 1; a < argc; a++) {
+    string arg(argv[a]);
+    if (arg == "-n" && a + 1 < argc) { numberStates = atoi(argv[++a]); }
+    else if (arg == "-r" && a + 1 < argc) { repetitions = atoi(argv[++a]); }
+    else if (arg == "-s" && a + 1 < argc) { seed = atoi(argv[++a]); }
+    else if (arg == "-h" || arg == "--help") {
+      cout << "Usage: " << argv[0] << " [-n numberStates] [-r repetitions] [-s seed] [filter]" << endl;
+      return 0;
+    }
+    else { filter = arg; }
+  }
+  if (numberStates < 1 || repetitions < 1) { cerr << "numberStates and repetitions must be positive" << endl; return 1; }
+
+  mt19937 generator(seed);
+  Bench bench(numberStates, repetitions, filter);
+  TB = new Tools(2);
+  vector<AddPhys*> addPhys;
+  int numberTransports(0);
+
+  //Materials: air and water liquid/vapor (parameters for phase change from libEOS)
+  Eos *air(createEosIG(0, "air", 1.4, 717.5, 0., 0.));
+  Eos *liquid(createEosSG(0, "waterLiq", 2.35, 1.e9, 1816.2, -1.167e6, 0.));
+  Eos *vapor(createEosIG(1, "waterVap", 1.43, 1040.14, 2.03e6, -2.3e4));
+  Eos *eosAir[1] = { air };
+  Eos *eosWater[2] = { liquid, vapor };
+
+  cout << "************************************************************" << endl;
+  cout << "  ECOGEN kernel micro-benchmarks" << endl;
+  cout << "  " << numberStates << " random states, " << repetitions << " repetitions, seed " << seed << endl;
+  cout << "************************************************************" << endl;
+  cout << " " << left << setw(44) << "kernel" << right << setw(12) << "ns/call" << setw(14) << "Mcalls/s" << endl;
+
+  //1) Riemann solvers of each flow model
+  //-------------------------------------
+  vector<BenchModel> models;
+  models.push_back(BenchModel("EULER", new ModEuler(numberTransports), 1, true, true, true, true));
+  models.push_back(BenchModel("KAPILA", new ModKapila(numberTransports, 2), 2, true, true, true, true));
+  models.push_back(BenchModel("MULTIP", new ModMultiP(numberTransports, 2), 2, true, true, true, true));
+  models.push_back(BenchModel("THERMALEQ", new ModThermalEq(numberTransports, 2), 2, true, false, true, true));
+  models.push_back(BenchModel("EULERHOMOGENEOUS", new ModEulerHomogeneous(numberTransports, 0, 1), 2, false, false, false, false));
+
+  for (unsigned int m = 0; m < models.size(); m++) {
+    BenchModel &bm(models[m]);
+    Eos **eos(bm.numberPhases == 1 ? eosAir : eosWater);
+    for (int i = 0; i < numberStates + 1; i++) {
+      Cell *cell(new Cell);
+      cell->allocate(bm.numberPhases, numberTransports, addPhys, bm.model);
+      randomState(cell, bm.name, eos, bm.numberPhases, generator);
+      bm.cells.push_back(cell);
+    }
+    bm.cells[0]->allocateEos(bm.numberPhases, bm.model);
+    int n(bm.numberPhases);
+    double dx(1.e-3), dtMax(1.e10);
+    vector<Cell*> &cells(bm.cells);
+    Model *model(bm.model);
+
+    bench.run(bm.name + " solveRiemannIntern", [&](int i) {
+      model->solveRiemannIntern(*cells[i], *cells[i + 1], n, dx, dx, dtMax);
+      return dtMax;
+    });
+    if (bm.boundaries[0]) {
+      bench.run(bm.name + " solveRiemannWall", [&](int i) {
+        model->solveRiemannWall(*cells[i], n, dx, dtMax);
+        return dtMax;
+      });
+    }
+    //Boundary states taken from the first cell
+    double ak0[2], rhok0[2], pk0[2], debitSurf[2];
+    double p0(cells[0]->getPhase(0)->getPressure());
+    double T0(eos[0]->computeTemperature(cells[0]->getPhase(0)->getDensity(), p0));
+    for (int k = 0; k < n; k++) {
+      ak0[k] = cells[0]->getPhase(k)->getAlpha();
+      rhok0[k] = cells[0]->getPhase(k)->getDensity();
+      pk0[k] = cells[0]->getPhase(k)->getPressure();
+    }
+    if (bm.boundaries[1]) {
+      //Injection at 1 m/s toward the left cell (sign changed as in BoundCondInj)
+      double m0(0.);
+      for (int k = 0; k < n; k++) { m0 -= ak0[k] * rhok0[k]; }
+      bench.run(bm.name + " solveRiemannInflow", [&](int i) {
+        model->solveRiemannInflow(*cells[i], n, dx, dtMax, m0, ak0, rhok0, pk0);
+        return dtMax;
+      });
+    }
+    if (bm.boundaries[2]) {
+      double pTank(1.5*p0), TTank(T0), rhokTank[2];
+      for (int k = 0; k < n; k++) { rhokTank[k] = eos[k]->computeDensity(pTank, TTank); }
+      bench.run(bm.name + " solveRiemannTank", [&](int i) {
+        model->solveRiemannTank(*cells[i], n, dx, dtMax, ak0, rhokTank, pTank, TTank);
+        return dtMax;
+      });
+    }
+    if (bm.boundaries[3]) {
+      double pOut(0.9*p0);
+      bench.run(bm.name + " solveRiemannOutflow", [&](int i) {
+        model->solveRiemannOutflow(*cells[i], n, dx, dtMax, pOut, debitSurf);
+        return dtMax;
+      });
+    }
+  }
+
+  //2) Equations of state
+  //---------------------
+  vector<double> density(numberStates), pressure(numberStates), energy(numberStates), temperature(numberStates);
+  Eos *eosBench[2] = { liquid, vapor };
+  for (int e = 0; e < 2; e++) {
+    Eos *eos(eosBench[e]);
+    string name(eos->getType() == "SG" ? "EosSG" : "EosIG");
+    for (int i = 0; i < numberStates; i++) {
+      density[i] = (e == 0) ? uniform(generator, 950., 1050.) : uniform(generator, 0.4, 0.8);
+      pressure[i] = uniform(generator, 0.8e5, 1.2e5);
+      energy[i] = eos->computeEnergy(density[i], pressure[i]);
+      temperature[i] = eos->computeTemperature(density[i], pressure[i]);
+    }
+    bench.run(name + "::computeTemperature", [&](int i) { return eos->computeTemperature(density[i], pressure[i]); });
+    bench.run(name + "::computeEnergy", [&](int i) { return eos->computeEnergy(density[i], pressure[i]); });
+    bench.run(name + "::computePressure", [&](int i) { return eos->computePressure(density[i], energy[i]); });
+    bench.run(name + "::computeDensity", [&](int i) { return eos->computeDensity(pressure[i], temperature[i]); });
+    bench.run(name + "::computeSoundSpeed", [&](int i) { return eos->computeSoundSpeed(density[i], pressure[i]); });
+    bench.run(name + "::computeEntropy", [&](int i) { return eos->computeEntropy(temperature[i], pressure[i]); });
+    bench.run(name + "::computeDensityIsentropic", [&](int i) {
+      double drhodp(0.);
+      return eos->computeDensityIsentropic(pressure[i], density[i], 2.*pressure[i], &drhodp) + drhodp;
+    });
+    bench.run(name + "::computeDensityHugoniot", [&](int i) {
+      double drhodp(0.);
+      return eos->computeDensityHugoniot(pressure[i], density[i], 2.*pressure[i], &drhodp) + drhodp;
+    });
+  }
+
+  //3) Relaxations (on Kapila states, restored before each sweep)
+  //-------------------------------------------------------------
+  BenchModel &kapila(models[1]);
+  kapila.cells[0]->allocateEos(2, kapila.model);
+  vector<Cell*> relaxed;
+  for (int i = 0; i < numberStates; i++) {
+    Cell *cell(new Cell);
+    cell->allocate(2, numberTransports, addPhys, kapila.model);
+    relaxed.push_back(cell);
+  }
+  auto restore = [&]() {
+    for (int i = 0; i < numberStates; i++) {
+      for (int k = 0; k < 2; k++) { relaxed[i]->copyPhase(k, kapila.cells[i]->getPhase(k)); }
+      relaxed[i]->copyMixture(kapila.cells[i]->getMixture());
+    }
+  };
+  XMLDocument xmlRelaxation;
+  xmlRelaxation.Parse("<relaxation type=\"PTMu\"><dataPTMu/></relaxation>");
+  vector<pair<string, Relaxation*> > relaxations;
+  relaxations.push_back(make_pair(string("RelaxationP"), static_cast<Relaxation*>(new RelaxationP)));
+  relaxations.push_back(make_pair(string("RelaxationPT"), static_cast<Relaxation*>(new RelaxationPT)));
+  relaxations.push_back(make_pair(string("RelaxationPTMu"), static_cast<Relaxation*>(new RelaxationPTMu(xmlRelaxation.FirstChildElement("relaxation")))));
+  for (unsigned int r = 0; r < relaxations.size(); r++) {
+    Relaxation *relaxation(relaxations[r].second);
+    bench.run(relaxations[r].first + "::stiffRelaxation", restore, [&](int i) {
+      relaxation->stiffRelaxation(relaxed[i], 2);
+      return relaxed[i]->getPhase(0)->getPressure();
+    });
+  }
+
+  //4) Slope limiters
+  //-----------------
+  vector<double> slope1(numberStates), slope2(numberStates);
+  for (int i = 0; i < numberStates; i++) {
+    slope1[i] = uniform(generator, -1., 1.);
+    slope2[i] = uniform(generator, -1., 1.);
+  }
+  vector<pair<string, Limiter*> > limiters;
+  limiters.push_back(make_pair(string("LimiterMinmod"), static_cast<Limiter*>(new LimiterMinmod)));
+  limiters.push_back(make_pair(string("LimiterVanLeer"), static_cast<Limiter*>(new LimiterVanLeer)));
+  limiters.push_back(make_pair(string("LimiterVanAlbada"), static_cast<Limiter*>(new LimiterVanAlbada)));
+  limiters.push_back(make_pair(string("LimiterMC"), static_cast<Limiter*>(new LimiterMC)));
+  limiters.push_back(make_pair(string("LimiterSuperBee"), static_cast<Limiter*>(new LimiterSuperBee)));
+  limiters.push_back(make_pair(string("LimiterTHINC"), static_cast<Limiter*>(new LimiterTHINC)));
+  for (unsigned int l = 0; l < limiters.size(); l++) {
+    Limiter *limiter(limiters[l].second);
+    bench.run(limiters[l].first + "::limiteSlope", [&](int i) { return limiter->limiteSlope(slope1[i], slope2[i]); });
+  }
+
+  //5) Gradients on a 2D Cartesian mesh of Kapila cells
+  //---------------------------------------------------
+  int numberCellsX(max(2, static_cast<int>(sqrt(static_cast<double>(numberStates)))));
+  vector<stretchZone> noStretch;
+  vector<BoundCond*> boundCond; //Non-reflecting boundaries everywhere
+  Mesh *mesh(new MeshCartesian(1., numberCellsX, 1., numberCellsX, 1., 1, noStretch, noStretch, noStretch));
+  mesh->attributLimites(boundCond);
+  Cell **meshCells(0);
+  CellInterface **meshBoundaries(0);
+  mesh->initializeGeometrie(&meshCells, &meshBoundaries, false, "FIRSTORDER");
+  int numberCells(mesh->getNumberCells());
+  for (int i = 0; i < numberCells; i++) {
+    meshCells[i]->allocate(2, numberTransports, addPhys, kapila.model);
+    randomState(meshCells[i], "KAPILA", eosWater, 2, generator);
+  }
+  Bench benchMesh(numberCells, repetitions, filter);
+  benchMesh.run("Cell::computeGradient RHO", [&](int i) { return meshCells[i]->computeGradient("RHO", 0).norm(); });
+  benchMesh.run("Cell::computeGradient ALPHA", [&](int i) { return meshCells[i]->computeGradient("ALPHA", 0).norm(); });
+
+  cout << "************************************************************" << endl;
+  return 0;
+}
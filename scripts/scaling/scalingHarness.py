@@ -0,0 +1,277 @@
+#!/usr/bin/env python3
+#
+#       ,---.     ,--,    .---.     ,--,    ,---.    .-. .-.
+#       | .-'   .' .')   / .-. )  .' .'     | .-'    |  \| |
+#       | `-.   |  |(_)  | | |(_) |  |  __  | `-.    |   | |
+#       | .-'   \  \     | | | |  \  \ ( _) | .-'    | |\  |
+#       |  `--.  \  `-.  \ `-' /   \  `-) ) |  `--.  | | |)|
+#       /( __.'   \____\  )---'    )\____/  /( __.'  /(  (_)
+#      (__)              (_)      (__)     (__)     (__)
+#
+#  This file is part of ECOGEN.
+#
+#  ECOGEN is the legal property of its developers, whose names
+#  are listed in the copyright file included with this source
+#  distribution.
+#
+#  ECOGEN is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published
+#  by the Free Software Foundation, either version 3 of the License,
+#  or (at your option) any later version.
+#
+#  ECOGEN is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with ECOGEN (file LICENSE).
+#  If not, see <http://www.gnu.org/licenses/>.
+
+"""Strong/weak scaling harness over the ECOGEN reference test cases.
+
+Each selected case of libTests/referenceTestCases is copied in a scratch
+directory, its Cartesian mesh is refined, its time control is replaced by a
+fixed number of iterations and ECOGEN is run with mpirun for each requested
+number of CPUs. The cell updates per second, the parallel efficiency and the
+wall-clock profile printed by ECOGEN are gathered in a JSON file.
+
+  strong scaling: the mesh is refined by the same factor whatever the number
+                  of CPUs (fixed problem size).
+  weak scaling:   the number of cells is in addition multiplied by the number
+                  of CPUs (fixed problem size per CPU).
+
+Parallel efficiency is the cell updates per second per CPU divided by the one
+of the smallest number of CPUs run for the same case and refinement.
+
+Example (from the ECOGEN root folder, after make):
+  python3 scripts/scaling/scalingHarness.py --cases euler/2D/HPCenter \\
+      --cpus 1 2 4 --refinements 1 2 --iterations 50 --output scaling.json
+"""
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import re
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+import xml.etree.ElementTree as ET
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+CASES = os.path.join(ROOT, "libTests", "referenceTestCases")
+LIBRARIES = ["libEOS", "libMeshes", "libBoundCond"]
+AXES = ["x", "y", "z"]
+
+#***********************************************************************
+
+def parseArguments():
+  parser = argparse.ArgumentParser(description="Strong/weak scaling harness over libTests reference cases",
+                                   formatter_class=argparse.RawDescriptionHelpFormatter, epilog=__doc__)
+  parser.add_argument("--cases", nargs="+", default=["euler/2D/HPCenter"],
+                      help="cases relative to libTests/referenceTestCases (default: euler/2D/HPCenter)")
+  parser.add_argument("--cpus", nargs="+", type=int, default=[1, 2, 4], help="numbers of CPUs (default: 1 2 4)")
+  parser.add_argument("--refinements", nargs="+", type=int, default=[1],
+                      help="mesh refinement factors applied in each direction of Cartesian meshes (default: 1)")
+  parser.add_argument("--mode", choices=["strong", "weak"], default="strong", help="scaling mode (default: strong)")
+  parser.add_argument("--iterations", type=int, default=50,
+                      help="fixed number of iterations, 0 keeps the time control of the case (default: 50)")
+  parser.add_argument("--executable", default=os.path.join(ROOT, "ECOGEN"), help="ECOGEN executable")
+  parser.add_argument("--mpirun", default="mpirun", help="MPI launcher command (default: mpirun)")
+  parser.add_argument("--workdir", default=None, help="scratch folder kept after the runs (default: temporary)")
+  parser.add_argument("--output", default="scaling.json", help="JSON result file (default: scaling.json)")
+  return parser.parse_args()
+
+#***********************************************************************
+
+def writeXML(tree, fileName):
+  tree.write(fileName, encoding="UTF-8", xml_declaration=True)
+
+#***********************************************************************
+
+def prepareMain(caseFolder, iterations):
+  """Fix the number of iterations with a single output at the end. Returns the run name."""
+  fileName = os.path.join(caseFolder, "mainV5.xml")
+  tree = ET.parse(fileName)
+  root = tree.getroot()
+  if iterations > 0:
+    control = root.find("timeControlMode")
+    control.set("iterations", "true")
+    element = control.find("iterations")
+    if element is None: element = ET.SubElement(control, "iterations")
+    element.set("number", str(iterations))
+    element.set("iterFreq", str(iterations))
+    #Checkpoints would only add I/O to the measure
+    for element in root.findall("checkpoint"): root.remove(element)
+    writeXML(tree, fileName)
+  return root.find("run").text.strip()
+
+#***********************************************************************
+
+def refineMesh(caseFolder, refinement, multiplier):
+  """Multiply the number of cells of a Cartesian mesh by refinement in each active direction and
+  the total number of cells by multiplier (stretching zones are refined alike).
+  Returns the number of level-0 cells or None if the mesh can not be refined."""
+  fileName = os.path.join(caseFolder, "meshV5.xml")
+  tree = ET.parse(fileName)
+  cartesian = tree.getroot().find("cartesianMesh")
+  if cartesian is None or cartesian.find("numberCells") is None: return None
+  numberCells = cartesian.find("numberCells")
+  counts = [int(numberCells.get(axis, "1")) for axis in AXES]
+  dimension = sum(1 for n in counts if n > 1)
+  perDirection = refinement * multiplier**(1. / max(dimension, 1))
+  stretching = cartesian.find("meshStretching")
+  for a, axis in enumerate(AXES):
+    if counts[a] <= 1: continue
+    zones = [] if stretching is None else stretching.findall(axis.upper() + "Stretching/stretch")
+    if zones:
+      counts[a] = 0
+      for zone in zones:
+        zone.set("numberCells", str(max(1, int(round(int(zone.get("numberCells")) * perDirection)))))
+        counts[a] += int(zone.get("numberCells"))
+    else: counts[a] = max(2, int(round(counts[a] * perDirection)))
+    numberCells.set(axis, str(counts[a]))
+  writeXML(tree, fileName)
+  return counts[0] * counts[1] * counts[2]
+
+#***********************************************************************
+
+def readCellUpdates(resultFolder):
+  """Leaf-cell updates of all CPUs (AMR sub-steps included) and computation time in seconds written in
+  infoCalcul.out for each output. Returns (iterations, computation time, cell updates) at the last output."""
+  fileName = os.path.join(resultFolder, "infoCalcul.out")
+  with open(fileName) as infos:
+    lines = [line.split() for line in infos if line.strip()][1:]
+  if len(lines) < 2 or any(len(line) < 11 for line in lines):
+    raise ValueError("no throughput columns in " + fileName + " (ECOGEN version too old for this harness)")
+  #The first output is written at initialization, cell updates are counted from it
+  cellUpdates = sum(float(line[5]) for line in lines[1:])
+  return int(lines[-1][1]), float(lines[-1][10]), cellUpdates
+
+#***********************************************************************
+
+def readProfile(log):
+  """Last wall-clock profile printed by ECOGEN, as a dictionary indexed by timer paths."""
+  blocks = log.split("WALL-CLOCK PROFILE ON")
+  if len(blocks) < 2: return {}
+  profile, stack = {}, []
+  for line in blocks[-1].splitlines()[2:]:
+    match = re.match(r"T\d+ \|     ( *)(.+?)\s+(\S+)\s+(\S+)\s+(\S+)\s+(\S+)\s+(\d+)\s*$", line)
+    if match is None: break
+    depth = len(match.group(1)) // 2
+    stack = stack[:depth] + [match.group(2)]
+    profile["/".join(stack)] = {"avg": float(match.group(3)), "min": float(match.group(4)),
+                                "max": float(match.group(5)), "percentAvg": float(match.group(6)),
+                                "calls": int(match.group(7))}
+  return profile
+
+#***********************************************************************
+
+def runCase(arguments, case, numberCpus, refinement, scratch):
+  run = {"case": case, "cpus": numberCpus, "refinement": refinement, "status": "ok"}
+  folder = os.path.join(scratch, "%s_cpu%d_ref%d" % (case.strip("/").replace("/", "_"), numberCpus, refinement))
+  shutil.rmtree(folder, ignore_errors=True)
+  caseFolder = os.path.join(folder, "case")
+  shutil.copytree(os.path.join(CASES, case), caseFolder)
+  for library in LIBRARIES:
+    if os.path.isdir(os.path.join(ROOT, library)): os.symlink(os.path.join(ROOT, library), os.path.join(folder, library))
+  with open(os.path.join(folder, "ECOGEN.xml"), "w") as ecogen:
+    ecogen.write('<?xml version = "1.0" encoding = "UTF-8" standalone = "yes"?>\n')
+    ecogen.write("<ecogen>\n  <testCase>./case/</testCase>\n</ecogen>\n")
+
+  name = prepareMain(caseFolder, arguments.iterations)
+  #Weak scaling: the number of cells is also proportional to the number of CPUs
+  multiplier = numberCpus if arguments.mode == "weak" else 1
+  #Number of level-0 cells known for Cartesian meshes only (written as null otherwise)
+  numberCells = refineMesh(caseFolder, refinement, multiplier)
+  if numberCells is None and (refinement != 1 or multiplier != 1):
+    run["status"] = "skipped: mesh can not be refined (unstructured mesh)"
+    return run
+
+  command = shlex.split(arguments.mpirun) + ["-np", str(numberCpus), os.path.abspath(arguments.executable)]
+  start = time.time()
+  process = subprocess.run(command, cwd=folder, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+  run["elapsedTime"] = time.time() - start
+  with open(os.path.join(folder, "ECOGEN.log"), "w") as log: log.write(process.stdout)
+  run["log"] = os.path.join(folder, "ECOGEN.log")
+  resultFolder = os.path.join(folder, "results", name)
+  if process.returncode != 0 or "ERR" in process.stdout or not os.path.isfile(os.path.join(resultFolder, "infoCalcul.out")):
+    run["status"] = "failed (see log)"
+    return run
+
+  try: iterations, computationTime, cellUpdates = readCellUpdates(resultFolder)
+  except ValueError as error:
+    run["status"] = "failed: " + str(error)
+    return run
+  run.update({"numberCells": numberCells, "iterations": iterations, "computationTime": computationTime,
+              "cellUpdates": cellUpdates,
+              "cellUpdatesPerSecond": cellUpdates / computationTime if computationTime > 0. else None})
+  if run["cellUpdatesPerSecond"] is not None: run["cellUpdatesPerSecondPerCpu"] = run["cellUpdatesPerSecond"] / numberCpus
+  run["profile"] = readProfile(process.stdout)
+  return run
+
+#***********************************************************************
+
+def computeEfficiencies(runs):
+  groups = {}
+  for run in runs:
+    if "cellUpdatesPerSecondPerCpu" in run: groups.setdefault((run["case"], run["refinement"]), []).append(run)
+  for group in groups.values():
+    reference = min(group, key=lambda run: run["cpus"])
+    for run in group:
+      run["parallelEfficiency"] = run["cellUpdatesPerSecondPerCpu"] / reference["cellUpdatesPerSecondPerCpu"]
+      run["referenceCpus"] = reference["cpus"]
+
+#***********************************************************************
+
+def gitVersion():
+  try:
+    return subprocess.check_output(["git", "-C", ROOT, "describe", "--always", "--dirty"], stderr=subprocess.DEVNULL,
+                                   universal_newlines=True).strip()
+  except (OSError, subprocess.CalledProcessError):
+    return "unknown"
+
+#***********************************************************************
+
+def main():
+  arguments = parseArguments()
+  if not os.path.isfile(arguments.executable): sys.exit("ECOGEN executable not found: " + arguments.executable)
+  for case in arguments.cases:
+    if not os.path.isfile(os.path.join(CASES, case, "mainV5.xml")): sys.exit("Unknown reference case: " + case)
+  scratch = arguments.workdir if arguments.workdir else tempfile.mkdtemp(prefix="ecogenScaling_")
+  os.makedirs(scratch, exist_ok=True)
+
+  runs = []
+  for case in arguments.cases:
+    for refinement in arguments.refinements:
+      for numberCpus in sorted(arguments.cpus):
+        print("%s | %d CPU(s) | refinement %d ..." % (case, numberCpus, refinement), end=" ", flush=True)
+        run = runCase(arguments, case, numberCpus, refinement, scratch)
+        runs.append(run)
+        if "cellUpdatesPerSecond" in run:
+          print("%s cells, %.3e cell updates/s" % (run["numberCells"], run["cellUpdatesPerSecond"]))
+        else:
+          print(run["status"])
+  computeEfficiencies(runs)
+
+  results = {"version": gitVersion(), "date": datetime.datetime.now().isoformat(timespec="seconds"),
+             "host": platform.node(), "mode": arguments.mode, "iterations": arguments.iterations,
+             "executable": os.path.abspath(arguments.executable), "runs": runs}
+  with open(arguments.output, "w") as output: json.dump(results, output, indent=2)
+
+  print("\n%-40s %5s %5s %10s %14s %10s" % ("case", "cpus", "ref", "cells", "cell upd./s", "efficiency"))
+  for run in runs:
+    if "parallelEfficiency" in run:
+      print("%-40s %5d %5d %10s %14.3e %10.2f" % (run["case"][-40:], run["cpus"], run["refinement"], run["numberCells"],
+                                                  run["cellUpdatesPerSecond"], run["parallelEfficiency"]))
+  print("Results written in " + arguments.output + (" (runs kept in " + scratch + ")" if arguments.workdir else ""))
+  if not arguments.workdir: shutil.rmtree(scratch, ignore_errors=True)
+  return 0 if all(run["status"] == "ok" for run in runs) else 1
+
+if __name__ == "__main__":
+  sys.exit(main())
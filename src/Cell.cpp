@@ -43,6 +43,7 @@ Cell::Cell() : m_vecPhases(0), m_mixture(0), m_cons(0), m_vecTransports(0), m_co
   m_lvl = 0;
   m_xi = 0.;
 	m_split = false;
+  m_treeVersion = 0;
 }
 
 //***********************************************************************
@@ -53,6 +54,7 @@ Cell::Cell(int lvl) : m_vecPhases(0), m_mixture(0), m_cons(0), m_vecTransports(0
   m_lvl = lvl;
   m_xi = 0.;
 	m_split = false;
+  m_treeVersion = 0;
 }
 
 //***********************************************************************
@@ -260,11 +262,34 @@ void Cell::correctionEnergy(const int &numberPhases)
 
 //***********************************************************************
 
-void Cell::printPhasesMixture(const int &numberPhases, const int &numberTransports, ofstream &fileStream) const
+void Cell::printPhasesMixture(const int &numberPhases, const int &numberTransports, ofstream &fileStream, const vector<bool> *masqueChamps) const
 {
-  for (int k = 0; k < numberPhases; k++) { m_vecPhases[k]->printPhase(fileStream); }
-  m_mixture->printMixture(fileStream);
-  for (int k = 0; k < numberTransports; k++) { fileStream << m_vecTransports[k].getValue() << " "; }
+  if (masqueChamps == 0) {
+    for (int k = 0; k < numberPhases; k++) { m_vecPhases[k]->printPhase(fileStream); }
+    m_mixture->printMixture(fileStream);
+    for (int k = 0; k < numberTransports; k++) { fileStream << m_vecTransports[k].getValue() << " "; }
+  }
+  else {
+    //Only the selected columns are printed, same order as above
+    int colonne(0);
+    for (int k = 0; k < numberPhases; k++) {
+      for (int var = 1; var <= m_vecPhases[k]->getNumberScalars(); var++) {
+        if ((*masqueChamps)[colonne++]) fileStream << m_vecPhases[k]->returnScalar(var) << " ";
+      }
+      for (int var = 1; var <= m_vecPhases[k]->getNumberVectors(); var++) {
+        if ((*masqueChamps)[colonne++]) fileStream << m_vecPhases[k]->returnVector(var).norm() << " ";
+      }
+    }
+    for (int var = 1; var <= m_mixture->getNumberScalars(); var++) {
+      if ((*masqueChamps)[colonne++]) fileStream << m_mixture->returnScalar(var) << " ";
+    }
+    for (int var = 1; var <= m_mixture->getNumberVectors(); var++) {
+      if ((*masqueChamps)[colonne++]) fileStream << m_mixture->returnVector(var).norm() << " ";
+    }
+    for (int k = 0; k < numberTransports; k++) {
+      if ((*masqueChamps)[colonne++]) fileStream << m_vecTransports[k].getValue() << " ";
+    }
+  }
 }
 
 //***********************************************************************
@@ -1046,6 +1071,7 @@ void Cell::chooseUnrefine(const double &xiJoin, int &nbCellsTotalAMR)
 void Cell::refineCellAndBoundaries(const int &nbCellsY, const int &nbCellsZ, const vector<AddPhys*> &addPhys, Model *model)
 {
 	m_split = true;
+  m_treeVersion++;
 
   //--------------------------------------
   //Initializations (children and dimension)
@@ -1421,6 +1447,7 @@ void Cell::unrefineCellAndBoundaries()
   m_element->finalizeElementsChildren();
 
 	m_split = false;
+  m_treeVersion++;
 }
 
 //***********************************************************************
@@ -1521,7 +1548,7 @@ void Cell::buildLvlCellsAndLvlInternalBoundariesArrays(vector<Cell *> *cellsLvl,
 
 //***********************************************************************
 
-bool Cell::printGnuplotAMR(std::ofstream &fileStream, const int &dim, GeometricObject *objet)
+bool Cell::printGnuplotAMR(std::ofstream &fileStream, const int &dim, GeometricObject *objet, const std::vector<bool> *masqueChamps)
 {
   bool ecrit(true);
   int dimension(dim);
@@ -1541,15 +1568,19 @@ bool Cell::printGnuplotAMR(std::ofstream &fileStream, const int &dim, GeometricO
       if (dimension >= 1) fileStream << position.getX() << " ";
       if (dimension >= 2) fileStream << position.getY() << " ";
       if (dimension == 3)fileStream << position.getZ() << " ";
-      this->printPhasesMixture(m_numberPhases, m_numberTransports, fileStream);
-      fileStream << m_lvl << " " << m_xi << " ";
+      this->printPhasesMixture(m_numberPhases, m_numberTransports, fileStream, masqueChamps);
+      if (masqueChamps == 0) { fileStream << m_lvl << " " << m_xi << " "; }
+      else { //AMR level and Xi are the two last entries of the mask
+        if ((*masqueChamps)[masqueChamps->size() - 2]) fileStream << m_lvl << " ";
+        if (masqueChamps->back()) fileStream << m_xi << " ";
+      }
       fileStream << endl;
       if (objet != 0) { if (objet->getType() == 0) return true; } //probe specificity, unique.
     }
     else {
 
       for (unsigned int i = 0; i < m_childrenCells.size(); i++) {
-        m_childrenCells[i]->printGnuplotAMR(fileStream, dim, objet);
+        m_childrenCells[i]->printGnuplotAMR(fileStream, dim, objet, masqueChamps);
       }
     }
   }
@@ -1611,6 +1642,13 @@ bool Cell::getSplit()
 
 //***********************************************************************
 
+int Cell::getTreeVersion() const
+{
+  return m_treeVersion;
+}
+
+//***********************************************************************
+
 double Cell::getXi()
 {
   return m_xi;
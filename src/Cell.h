@@ -93,7 +93,7 @@ class Cell
         void buildCons(const int &numberPhases);
         void correctionEnergy(const int &numberPhases);
         void sourceTermIntegration(const double &dt, const int &numberPhases) {};
-        void printPhasesMixture(const int &numberPhases, const int &numberTransports, std::ofstream &fileStream) const;
+        void printPhasesMixture(const int &numberPhases, const int &numberTransports, std::ofstream &fileStream, const std::vector<bool> *masqueChamps = 0) const;
         virtual void completeFulfillState(Prim type = vecPhases);
         virtual void fulfillState(Prim type = vecPhases);
         virtual void localProjection(const Coord &normal, const Coord &tangent, const Coord &binormal, const int &numberPhases, Prim type = vecPhases);
@@ -178,7 +178,7 @@ class Cell
 
         //Printing
         //--------
-        bool printGnuplotAMR(std::ofstream &fileStream, const int &dim, GeometricObject *objet = 0);
+        bool printGnuplotAMR(std::ofstream &fileStream, const int &dim, GeometricObject *objet = 0, const std::vector<bool> *masqueChamps = 0);
         void computeIntegration(double &integration);
         void lookForPmax(double *pMax, double *pMaxWall);
 
@@ -199,6 +199,7 @@ class Cell
         void buildLvlCellsAndLvlInternalBoundariesArrays(std::vector<Cell *> *cellsLvl, std::vector<CellInterface *> *boundariesLvl);      /*!< Build new arrays of cells and boundaries for level (lvl+1), only internal boundaries are added here */
         int getLvl();                                                    /*!< Get the cell AMR level in the AMR tree */
         bool getSplit();                                                 /*!< Return true if the cells is plit, false otherwise */
+        int getTreeVersion() const;                                      /*!< Return the number of refinements and unrefinements of the cell */
         double getXi();                                                  /*!< Return Xi cell value */
         void setXi(double value);                                        /*!< Set the Xi cell value */
         void addFluxXi(double value);                                    /*!< Add xi cell flux */
@@ -256,6 +257,7 @@ class Cell
       double m_xi;                                                /*!< Criteria for refine/unrefine cell */
       double m_consXi;                                            /*!< Buffer variable for Xi fluxes */
 	  bool m_split;                                               /*!< Indicator for splitted cell (Do I possess children ?) */
+      int m_treeVersion;                                          /*!< Number of refinements and unrefinements of the cell (to check pointers cached in its subtree, e.g. probes) */
       std::vector<Cell*> m_childrenCells;                         /*!< Vector of children cells pointers */
       std::vector<CellInterface*> m_childrenInternalBoundaries;   /*!< Vector of Internal children boundaries pointers of the cell */
 
@@ -0,0 +1,229 @@
+//  
+//       ,---.     ,--,    .---.     ,--,    ,---.    .-. .-. 
+//       | .-'   .' .')   / .-. )  .' .'     | .-'    |  \| | 
+//       | `-.   |  |(_)  | | |(_) |  |  __  | `-.    |   | | 
+//       | .-'   \  \     | | | |  \  \ ( _) | .-'    | |\  | 
+//       |  `--.  \  `-.  \ `-' /   \  `-) ) |  `--.  | | |)| 
+//       /( __.'   \____\  )---'    )\____/  /( __.'  /(  (_) 
+//      (__)              (_)      (__)     (__)     (__)     
+//
+//  This file is part of ECOGEN.
+//
+//  ECOGEN is the legal property of its developers, whose names 
+//  are listed in the copyright file included with this source 
+//  distribution.
+//
+//  ECOGEN is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, 
+//  or (at your option) any later version.
+//  
+//  ECOGEN is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with ECOGEN (file LICENSE).  
+//  If not, see <http://www.gnu.org/licenses/>.
+
+//! \file      Checkpoint.cpp
+//! \version   1.0
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <stdint.h>
+#include "Checkpoint.h"
+#include "Input.h"
+#include "../Run.h"
+
+using namespace std;
+using namespace tinyxml2;
+
+//Identification of checkpoint files and version of the binary layout
+static const char identifiantCheckpoint[8] = { 'E', 'C', 'O', 'G', 'E', 'N', 'C', 'P' };
+static const int versionCheckpoint(1);
+static const int testEndian(0x01020304);
+
+//***********************************************************************
+//Constructeur checkpoint a partir d une lecture au format XML
+//ex :	<checkpoint iterFreq="500"/>
+
+Checkpoint::Checkpoint(string nameRun, XMLElement *element, string fileName, Input *entree) :
+  m_input(entree), m_freq(0), m_numCheckpoint(0)
+{
+  m_run = m_input->getRun();
+  m_dossierCheckpoints = "./results/" + nameRun + "/checkpoints/";
+
+  if (element != NULL) {
+    XMLError error(element->QueryIntAttribute("iterFreq", &m_freq));
+    if (error != XML_NO_ERROR) throw ErrorXMLAttribut("iterFreq", fileName, __FILE__, __LINE__);
+    if (m_freq < 0) m_freq = 0;
+  }
+
+  //Creation du dossier des checkpoints (le dossier du run est cree par la sortie principale)
+  if (rankCpu == 0) {
+    #ifdef WIN32
+      _mkdir(m_dossierCheckpoints.c_str());
+    #else
+      mkdir(m_dossierCheckpoints.c_str(), S_IRWXU);
+    #endif
+  }
+  MPI_Barrier(commCompute);
+}
+
+//***********************************************************************
+
+Checkpoint::~Checkpoint(){}
+
+//***********************************************************************
+
+bool Checkpoint::isCheckpointIteration(const int &iteration) const
+{
+  return (m_freq > 0 && iteration % m_freq == 0);
+}
+
+//***********************************************************************
+
+void Checkpoint::ecritCheckpoint(Mesh *mesh, vector<Cell *> *cellsLvl)
+{
+  try {
+    m_numCheckpoint++;
+    if (rankCpu == 0) cout << "T" << m_run->m_numTest << " | printing checkpoint number : " << m_numCheckpoint << "... ";
+    string file(m_dossierCheckpoints + creationNameFichier(m_numCheckpoint, rankCpu));
+    ofstream fileStream(file.c_str(), ios::out | ios::binary | ios::trunc);
+    if (!fileStream) throw ErrorECOGEN("checkpoint file can not be opened : " + file, __FILE__, __LINE__);
+
+    //1) Header: identification, layout and run metadata
+    //--------------------------------------------------
+    m_run->m_stat.updateComputationTime();
+    int numberVariables(numberVariablesCell(cellsLvl[0][0]));
+    int lvlMax(mesh->getLvlMax());
+    int entiers[12] = { versionCheckpoint, testEndian, Ncpu, rankCpu, m_run->m_numberPhases, m_run->m_numberTransports, numberVariables, lvlMax,
+      m_run->m_iteration, m_run->m_outPut->getNumSortie(), m_numCheckpoint, m_run->m_nbCellsTotalAMR };
+    double reels[2] = { m_run->m_physicalTime, m_run->m_dt };
+    int64_t computationTime(static_cast<int64_t>(m_run->m_stat.getComputationTime()));
+    fileStream.write(identifiantCheckpoint, sizeof(identifiantCheckpoint));
+    fileStream.write(reinterpret_cast<const char*>(entiers), sizeof(entiers));
+    fileStream.write(reinterpret_cast<const char*>(reels), sizeof(reels));
+    fileStream.write(reinterpret_cast<const char*>(&computationTime), sizeof(computationTime));
+
+    //2) Data of each AMR level: split flags, xi and primitive variables
+    //------------------------------------------------------------------
+    vector<char> splits;
+    vector<double> xi, primitives;
+    for (int lvl = 0; lvl <= lvlMax; lvl++) {
+      int numberCells(cellsLvl[lvl].size());
+      splits.resize(numberCells); xi.resize(numberCells);
+      primitives.resize(static_cast<size_t>(numberCells)*numberVariables);
+      int counter(-1);
+      for (int c = 0; c < numberCells; c++) {
+        splits[c] = cellsLvl[lvl][c]->getSplit();
+        xi[c] = cellsLvl[lvl][c]->getXi();
+        cellsLvl[lvl][c]->fillBufferPrimitives(&primitives[0], counter);
+      }
+      fileStream.write(reinterpret_cast<const char*>(&numberCells), sizeof(int));
+      if (numberCells == 0) continue;
+      fileStream.write(&splits[0], numberCells*sizeof(char));
+      fileStream.write(reinterpret_cast<const char*>(&xi[0]), numberCells*sizeof(double));
+      fileStream.write(reinterpret_cast<const char*>(&primitives[0]), primitives.size()*sizeof(double));
+    }
+    if (!fileStream) throw ErrorECOGEN("checkpoint file printing failed : " + file, __FILE__, __LINE__);
+    fileStream.close();
+    if (rankCpu == 0) cout << " ...OK" << endl;
+  }
+  catch (ErrorECOGEN &) { throw; }
+}
+
+//***********************************************************************
+
+void Checkpoint::readCheckpoint(Mesh *mesh, vector<Cell *> *cellsLvl, vector<CellInterface *> *boundariesLvl, const int number)
+{
+  try {
+    string file(m_dossierCheckpoints + creationNameFichier(number, rankCpu));
+    ifstream fileStream(file.c_str(), ios::in | ios::binary);
+    if (!fileStream) throw ErrorECOGEN("checkpoint file absent : " + file, __FILE__, __LINE__);
+
+    //1) Header verification and run metadata
+    //---------------------------------------
+    char identifiant[8];
+    int entiers[12];
+    double reels[2];
+    int64_t computationTime;
+    fileStream.read(identifiant, sizeof(identifiant));
+    fileStream.read(reinterpret_cast<char*>(entiers), sizeof(entiers));
+    fileStream.read(reinterpret_cast<char*>(reels), sizeof(reels));
+    fileStream.read(reinterpret_cast<char*>(&computationTime), sizeof(computationTime));
+    if (!fileStream || !equal(identifiant, identifiant + 8, identifiantCheckpoint)) throw ErrorECOGEN("not an ECOGEN checkpoint file : " + file, __FILE__, __LINE__);
+    if (entiers[0] != versionCheckpoint) throw ErrorECOGEN("checkpoint file version not supported : " + file, __FILE__, __LINE__);
+    if (entiers[1] != testEndian) throw ErrorECOGEN("checkpoint file printed with another endianness : " + file, __FILE__, __LINE__);
+    if (entiers[2] != Ncpu || entiers[3] != rankCpu) throw ErrorECOGEN("resume simulation not possible - number of CPU differs from checkpoint files", __FILE__, __LINE__);
+    int numberVariables(numberVariablesCell(cellsLvl[0][0]));
+    if (entiers[4] != m_run->m_numberPhases || entiers[5] != m_run->m_numberTransports || entiers[6] != numberVariables || entiers[7] != mesh->getLvlMax()) {
+      throw ErrorECOGEN("resume simulation not possible - model or AMR level differs from checkpoint files", __FILE__, __LINE__);
+    }
+    if (mesh->getLvlMax() > 0 && Ncpu > 1) throw ErrorECOGEN("Checkpoint::readCheckpoint: Resuming with AMR not available in parallel", __FILE__, __LINE__);
+
+    //2) Data of each AMR level: primitive variables, xi, then refinement of split cells
+    //----------------------------------------------------------------------------------
+    vector<char> splits;
+    vector<double> xi, primitives;
+    for (int lvl = 0; lvl <= mesh->getLvlMax(); lvl++) {
+      int numberCells(0);
+      fileStream.read(reinterpret_cast<char*>(&numberCells), sizeof(int));
+      if (numberCells != static_cast<int>(cellsLvl[lvl].size())) throw ErrorECOGEN("checkpoint file does not correspond to the mesh : " + file, __FILE__, __LINE__);
+      if (numberCells == 0) continue;
+      splits.resize(numberCells); xi.resize(numberCells);
+      primitives.resize(static_cast<size_t>(numberCells)*numberVariables);
+      fileStream.read(&splits[0], numberCells*sizeof(char));
+      fileStream.read(reinterpret_cast<char*>(&xi[0]), numberCells*sizeof(double));
+      fileStream.read(reinterpret_cast<char*>(&primitives[0]), primitives.size()*sizeof(double));
+      if (!fileStream) throw ErrorECOGEN("checkpoint file truncated : " + file, __FILE__, __LINE__);
+      int counter(-1);
+      for (int c = 0; c < numberCells; c++) {
+        cellsLvl[lvl][c]->getBufferPrimitives(&primitives[0], counter, m_run->m_eos);
+        cellsLvl[lvl][c]->setXi(xi[c]);
+        if (splits[c]) mesh->refineCell(cellsLvl[lvl][c], m_run->m_addPhys, m_run->m_model, m_run->m_nbCellsTotalAMR);
+      }
+      //Building cells and interface cells vectors of next level
+      if (lvl < mesh->getLvlMax()) {
+        cellsLvl[lvl + 1].clear();
+        boundariesLvl[lvl + 1].clear();
+        for (unsigned int i = 0; i < cellsLvl[lvl].size(); i++) { cellsLvl[lvl][i]->buildLvlCellsAndLvlInternalBoundariesArrays(cellsLvl, boundariesLvl); }
+        for (unsigned int i = 0; i < boundariesLvl[lvl].size(); i++) { boundariesLvl[lvl][i]->constructionTableauBordsExternesLvl(boundariesLvl); }
+      }
+    }
+    fileStream.close();
+
+    //3) Run metadata
+    //---------------
+    m_run->m_iteration = entiers[8];
+    m_run->m_outPut->setNumSortie(entiers[9]);
+    m_numCheckpoint = entiers[10];
+    m_run->m_nbCellsTotalAMR = entiers[11];
+    m_run->m_physicalTime = reels[0];
+    m_run->m_dt = reels[1];
+    m_run->m_stat.setCompTime(static_cast<clock_t>(computationTime));
+    m_run->m_outPut->eraseInfos(entiers[9]);
+  }
+  catch (ErrorECOGEN &) { throw; }
+}
+
+//***********************************************************************
+
+string Checkpoint::creationNameFichier(const int number, int proc) const
+{
+  stringstream num;
+  num << "checkpoint_CPU" << proc << "_NUM" << number << ".bin";
+  return num.str();
+}
+
+//***********************************************************************
+
+int Checkpoint::numberVariablesCell(Cell *cell) const
+{
+  return m_run->m_numberPhases * cell->getPhase(0)->numberOfTransmittedVariables() + cell->getMixture()->numberOfTransmittedVariables() + m_run->m_numberTransports;
+}
+
+//***********************************************************************
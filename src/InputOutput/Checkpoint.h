@@ -0,0 +1,75 @@
+//  
+//       ,---.     ,--,    .---.     ,--,    ,---.    .-. .-. 
+//       | .-'   .' .')   / .-. )  .' .'     | .-'    |  \| | 
+//       | `-.   |  |(_)  | | |(_) |  |  __  | `-.    |   | | 
+//       | .-'   \  \     | | | |  \  \ ( _) | .-'    | |\  | 
+//       |  `--.  \  `-.  \ `-' /   \  `-) ) |  `--.  | | |)| 
+//       /( __.'   \____\  )---'    )\____/  /( __.'  /(  (_) 
+//      (__)              (_)      (__)     (__)     (__)     
+//
+//  This file is part of ECOGEN.
+//
+//  ECOGEN is the legal property of its developers, whose names 
+//  are listed in the copyright file included with this source 
+//  distribution.
+//
+//  ECOGEN is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, 
+//  or (at your option) any later version.
+//  
+//  ECOGEN is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with ECOGEN (file LICENSE).  
+//  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+//! \file      Checkpoint.h
+//! \version   1.0
+
+#include <string>
+#include <vector>
+#include "../libTierces/tinyxml2.h"
+#include "../Errors.h"
+#include "../Meshes/HeaderMesh.h"
+#include "../Cell.h"
+
+class Input;
+class Run;
+
+//! \class     Checkpoint
+//! \brief     Binary checkpoints of the simulation state for fast restart (separate from the visualization outputs)
+//! \details   One file per CPU and per checkpoint, in native binary layout: versioned header with run metadata,
+//!            then for each AMR level the split flags, the xi indicators and the primitive variables of the cells
+class Checkpoint
+{
+  public:
+    //! \brief     Checkpoint constructor from the XML node <checkpoint iterFreq="..."/> (element may be NULL: no printing)
+    Checkpoint(std::string nameRun, tinyxml2::XMLElement *element, std::string fileName, Input *entree);
+    virtual ~Checkpoint();
+
+    //! \brief     Return true if a checkpoint has to be printed at this iteration
+    bool isCheckpointIteration(const int &iteration) const;
+    //! \brief     Print the checkpoint files (one per CPU) of the current state
+    void ecritCheckpoint(Mesh *mesh, std::vector<Cell *> *cellsLvl);
+    //! \brief     Restore the state (AMR tree, primitive variables and run metadata) from checkpoint files
+    void readCheckpoint(Mesh *mesh, std::vector<Cell *> *cellsLvl, std::vector<CellInterface *> *boundariesLvl, const int number);
+
+  private:
+    std::string creationNameFichier(const int number, int proc) const;
+    int numberVariablesCell(Cell *cell) const;
+
+    Input *m_input;                     //!<Pointer to input
+    Run *m_run;                         //!<Pointer to run
+    std::string m_dossierCheckpoints;   //!<Checkpoint files folder
+    int m_freq;                         //!<Checkpoint printing frequency in iterations (0: no printing)
+    int m_numCheckpoint;                //!<Number of the last printed/read checkpoint
+};
+
+#endif //CHECKPOINT_H
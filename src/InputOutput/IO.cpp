@@ -32,6 +32,7 @@
 //! \version   1.0
 //! \date      May 03 2018
 
+#include <zlib.h>
 #include "IO.h"
 #include "../Errors.h"
 
@@ -94,6 +95,67 @@ ostream& IO::writeb64Chaine(ostream &fluxSortie, char *chaine, int &tailleChaine
 
 //***********************************************************************
 
+void IO::compresseChaine(char *chaine, const int &tailleChaine, const int &niveau, vector<unsigned int> &header, vector<char> &chaineCompressee)
+{
+  const int tailleBloc(32768);
+  int numberBlocs((tailleChaine + tailleBloc - 1) / tailleBloc);
+  header.resize(3 + numberBlocs);
+  header[0] = numberBlocs;
+  header[1] = tailleBloc;
+  header[2] = tailleChaine % tailleBloc;
+
+  chaineCompressee.resize(numberBlocs * compressBound(tailleBloc));
+  uLong position(0);
+  for (int b = 0; b < numberBlocs; b++) {
+    uLong tailleSource(min(tailleBloc, tailleChaine - b*tailleBloc));
+    uLongf tailleCompressee(compressBound(tailleSource));
+    if (compress2(reinterpret_cast<Bytef*>(&chaineCompressee[position]), &tailleCompressee, reinterpret_cast<Bytef*>(chaine + b*tailleBloc), tailleSource, niveau) != Z_OK) {
+      throw ErrorECOGEN("IO::compresseChaine : compression zlib impossible", __FILE__, __LINE__);
+    }
+    header[3 + b] = static_cast<unsigned int>(tailleCompressee);
+    position += tailleCompressee;
+  }
+  chaineCompressee.resize(position);
+}
+
+//***********************************************************************
+
+ostream& IO::writeb64ChaineCompressee(ostream &fluxSortie, char *chaine, int &tailleChaine, const int &niveau)
+{
+  //The header and the compressed blocks are encoded in base64 separately
+  vector<unsigned int> header;
+  vector<char> chaineCompressee;
+  IO::compresseChaine(chaine, tailleChaine, niveau, header, chaineCompressee);
+  int tailleHeader(header.size()*sizeof(unsigned int));
+  IO::writeb64Chaine(fluxSortie, reinterpret_cast<char*>(&header[0]), tailleHeader);
+  int tailleDonnees(chaineCompressee.size());
+  if (tailleDonnees > 0) IO::writeb64Chaine(fluxSortie, &chaineCompressee[0], tailleDonnees);
+  return fluxSortie;
+}
+
+//***********************************************************************
+
+ostream& IO::writeChaineBrute(ostream &fluxSortie, char *chaine, int &tailleChaine)
+{
+  unsigned int header(tailleChaine);
+  fluxSortie.write(reinterpret_cast<char*>(&header), sizeof(header));
+  return fluxSortie.write(chaine, tailleChaine);
+}
+
+//***********************************************************************
+
+void IO::compresseChaineBrute(char *chaine, const int &taille, const int &niveau, vector<char> &chaineBrute)
+{
+  vector<unsigned int> header;
+  vector<char> chaineCompressee;
+  IO::compresseChaine(chaine, taille, niveau, header, chaineCompressee);
+  const char *chaineHeader(reinterpret_cast<const char*>(header.data()));
+  chaineBrute.assign(chaineHeader, chaineHeader + header.size()*sizeof(unsigned int));
+  chaineBrute.insert(chaineBrute.end(), chaineCompressee.begin(), chaineCompressee.end());
+}
+
+//***********************************************************************
+
 void IO::copieFichier(string file, string dossierSource, string dossierDestination)
 {
   try {
@@ -38,6 +38,7 @@
 #include <fstream>
 #include <algorithm>
 #include <sstream>
+#include <vector>
 
 class IO
 {
@@ -122,11 +123,26 @@ public:
   // //ATTENTION !!!!!!!!!!!Lecture non Fonctionnelle !!!!!!!!!!!!!!
 
   static std::ostream& writeb64Chaine(std::ostream &fluxSortie, char *chaineAEncoder, int &taille);
+  //! \brief     Print of a data array compressed with zlib in base64 (VTK format vtkZLibDataCompressor, UInt32 header)
+  //! \param     niveau        zlib compression level (1 to 9)
+  static std::ostream& writeb64ChaineCompressee(std::ostream &fluxSortie, char *chaineAEncoder, int &taille, const int &niveau);
+
+  //Format binary brut pour les donnees ajoutees (AppendedData raw) du XML VTK
+  //-----------------------------------------------------------------------
+  //! \brief     Raw print of a data array preceded by its size (UInt32 header)
+  static std::ostream& writeChaineBrute(std::ostream &fluxSortie, char *chaine, int &taille);
+  //! \brief     zlib compression of a data array into its raw appended layout (vtkZLibDataCompressor, UInt32 header followed by the blocks)
+  static void compresseChaineBrute(char *chaine, const int &taille, const int &niveau, std::vector<char> &chaineBrute);
 
   static void copieFichier(std::string file, std::string dossierSource, std::string dossierDestination);
 
 private:
 
+  //! \brief     zlib compression by blocks of a data array in the VTK layout
+  //! \param     header            [number of blocks, block size, size of the last partial block (0 if full), compressed size of each block]
+  //! \param     chaineCompressee  compressed blocks
+  static void compresseChaine(char *chaine, const int &taille, const int &niveau, std::vector<unsigned int> &header, std::vector<char> &chaineCompressee);
+
   //Swap Little <-> Big Endian
   template <typename T>
   static void endswap(T *objp)
@@ -121,6 +121,50 @@ void Input::entreeMain(string casTest)
     else if (format == "GNU") { m_run->m_outPut = new OutputGNU(casTest, xmlText->Value(), element, fileName.str(), this); }
     else { throw ErrorXMLDev(fileName.str(), __FILE__, __LINE__); }
 
+    //Lecture des checkpoints (optionnel)
+    element = computationParam->FirstChildElement("checkpoint");
+    m_run->m_checkpoint = new Checkpoint(xmlText->Value(), element, fileName.str(), this);
+
+    //Lecture du traceur d evenements (optionnel)
+    //ex :	<trace maxEvents="1000000" firstIteration="100" lastIteration="300"/>
+    element = computationParam->FirstChildElement("trace");
+    if (element != NULL) {
+      int maxEvents, firstIteration, lastIteration;
+      if (element->QueryIntAttribute("maxEvents", &maxEvents) != XML_NO_ERROR) maxEvents = 1000000; //default if not specified
+      if (maxEvents <= 0) throw ErrorXMLAttribut("maxEvents", fileName.str(), __FILE__, __LINE__);
+      if (element->QueryIntAttribute("firstIteration", &firstIteration) != XML_NO_ERROR) firstIteration = 0; //default if not specified
+      if (element->QueryIntAttribute("lastIteration", &lastIteration) != XML_NO_ERROR) lastIteration = -1; //default: until the end of the run
+      tracer.initialize("./results/" + string(xmlText->Value()) + "/", maxEvents, firstIteration, lastIteration);
+    }
+    else { tracer.deactivate(); }
+
+    //Lecture de la limite memoire (optionnel)
+    //ex :	<memory softLimit="4000" checkFrequency="10"/>
+    element = computationParam->FirstChildElement("memory");
+    if (element != NULL) {
+      double softLimit;
+      int checkFrequency;
+      if (element->QueryDoubleAttribute("softLimit", &softLimit) != XML_NO_ERROR || softLimit < 0.) throw ErrorXMLAttribut("softLimit", fileName.str(), __FILE__, __LINE__);
+      if (element->QueryIntAttribute("checkFrequency", &checkFrequency) != XML_NO_ERROR) checkFrequency = 10; //default if not specified
+      if (checkFrequency < 1) throw ErrorXMLAttribut("checkFrequency", fileName.str(), __FILE__, __LINE__);
+      m_run->m_memory.setSoftLimit(softLimit, checkFrequency);
+    }
+
+    //Lecture du reequilibrage de charge entre CPU pour l AMR (optionnel)
+    //ex :	<loadBalancing iterFreq="100" threshold="1.2"/>
+    element = computationParam->FirstChildElement("loadBalancing");
+    if (element != NULL) {
+      if (element->QueryIntAttribute("iterFreq", &m_run->m_loadBalancingFreq) != XML_NO_ERROR || m_run->m_loadBalancingFreq < 1) throw ErrorXMLAttribut("iterFreq", fileName.str(), __FILE__, __LINE__);
+      if (element->QueryDoubleAttribute("threshold", &m_run->m_loadBalancingThreshold) != XML_NO_ERROR) m_run->m_loadBalancingThreshold = 1.2; //default if not specified
+      if (m_run->m_loadBalancingThreshold < 1.) throw ErrorXMLAttribut("threshold", fileName.str(), __FILE__, __LINE__);
+    }
+
+    //Lecture des compteurs materiels (optionnel)
+    //ex :	<perfCounters/>
+    element = computationParam->FirstChildElement("perfCounters");
+    if (element != NULL) { profiler.initializeCounters(); }
+    else { profiler.deactivateCounters(); }
+
     //Lecture des cuts 1D
     element = computationParam->FirstChildElement("cut1D");
     while (element != NULL)
@@ -255,8 +299,11 @@ void Input::entreeMain(string casTest)
     //Reprise de Calcul depuis file resultat
     element = computationParam->FirstChildElement("resumeSimulation");
     if (element != NULL) {
-      error = element->QueryIntAttribute("fileNumber", &m_run->m_resumeSimulation);
-      if (error != XML_NO_ERROR) throw ErrorXMLAttribut("number", fileName.str(), __FILE__, __LINE__);
+      //Reprise depuis un checkpoint binaire si demande, sinon depuis un file resultat
+      if (element->QueryIntAttribute("checkpoint", &m_run->m_resumeCheckpoint) != XML_NO_ERROR) {
+        error = element->QueryIntAttribute("fileNumber", &m_run->m_resumeSimulation);
+        if (error != XML_NO_ERROR) throw ErrorXMLAttribut("number", fileName.str(), __FILE__, __LINE__);
+      }
     }
 
   }
@@ -305,7 +352,14 @@ void Input::entreeMesh(string casTest)
       if (element == NULL) throw ErrorXMLElement("file", fileName.str(), __FILE__, __LINE__);
       string fichierMesh(element->Attribute("name"));
       if (fichierMesh == "") throw ErrorXMLAttribut("name", fileName.str(), __FILE__, __LINE__);
-      m_run->m_mesh = new MeshUnStruct(fichierMesh);
+      //Recuperation utilisation du cache de geometrie (optionnel)
+      bool cacheGeometrie(false);
+      element = meshNS->FirstChildElement("cache");
+      if (element != NULL) {
+        error = element->QueryBoolAttribute("geometry", &cacheGeometrie);
+        if (error != XML_NO_ERROR) throw ErrorXMLAttribut("geometry", fileName.str(), __FILE__, __LINE__);
+      }
+      m_run->m_mesh = new MeshUnStruct(fichierMesh, cacheGeometrie);
       //Recuperation pretraitement parallele
       element = meshNS->FirstChildElement("parallel");
       if (element != NULL) {
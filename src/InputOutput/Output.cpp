@@ -40,14 +40,14 @@ using namespace tinyxml2;
 
 //***********************************************************************
 
-Output::Output(){}
+Output::Output() : m_compression(0), m_donneesAjoutees(false), m_octetsTamponBinaire(0) {}
 
 //***************************************************************
 //Constructeur sortie a partir d une lecture au format XML outputMode
 //ex :	<outputMode format="XML" binary="false"/>
 
 Output::Output(string casTest, string nameRun, XMLElement *element, string fileName, Input *entree) :
-  m_simulationName(casTest), m_dossierSortie(nameRun), m_numFichier(0), m_donneesSeparees(0), m_input(entree)
+  m_input(entree), m_simulationName(casTest), m_dossierSortie(nameRun), m_donneesSeparees(0), m_donneesAjoutees(false), m_octetsTamponBinaire(0), m_numFichier(0)
 {
   //Affectation pointeur run
   m_run = m_input->getRun();
@@ -75,6 +75,12 @@ Output::Output(string casTest, string nameRun, XMLElement *element, string fileN
   //Recuperation mode Ecriture
   error = element->QueryBoolAttribute("binary", &m_ecritBinaire);
   if (error != XML_NO_ERROR) throw ErrorXMLAttribut("binary", fileName, __FILE__, __LINE__);
+  //zlib compression level of binary data arrays (optional)
+  if (element->QueryIntAttribute("compression", &m_compression) != XML_NO_ERROR) m_compression = 0; //default if not specified
+  if (m_compression < 0 || m_compression > 9) throw ErrorXMLAttribut("compression", fileName, __FILE__, __LINE__);
+  if (m_compression > 0 && !m_ecritBinaire) throw ErrorECOGEN("Output::Output : compression of the data arrays requires binary=\"true\" (file " + fileName + ")", __FILE__, __LINE__);
+  //Selection des champs imprimes (optional)
+  this->lectureChamps(element);
 
   //Creation du dossier de sortie ou vidange /Macro selon OS Windows ou Linux
   if (rankCpu == 0) {
@@ -103,7 +109,7 @@ Output::Output(string casTest, string nameRun, XMLElement *element, string fileN
     }
     catch (ErrorECOGEN &) { throw; }
   }
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(commCompute);
 
   //Determination du mode Little / Big Endian
   //-----------------------------------------
@@ -128,6 +134,46 @@ void Output::prepareOutput(const Cell &cell)
   m_cellRef.copyMixture(cell.getMixture());
   for (int k = 0; k < m_run->m_numberTransports; k++) { m_cellRef.setTransport(cell.getTransport(k).getValue(), k); }
 
+  //Masque des champs imprimes et verification des names demandes
+  //-------------------------------------------------------------
+  if (!m_champs.empty()) {
+    vector<string> namesConnus;
+    m_masqueChamps.clear();
+    for (int k = 0; k < m_run->m_numberPhases; k++) {
+      for (int var = 1; var <= m_cellRef.getPhase(k)->getNumberScalars(); var++) {
+        string name(m_cellRef.getPhase(k)->returnNameScalar(var));
+        m_masqueChamps.push_back(imprimeVariablePhase(k, name));
+        namesConnus.push_back(name); namesConnus.push_back("F" + IO::toString(k) + "_" + name);
+      }
+      for (int var = 1; var <= m_cellRef.getPhase(k)->getNumberVectors(); var++) {
+        string name(m_cellRef.getPhase(k)->returnNameVector(var));
+        m_masqueChamps.push_back(imprimeVariablePhase(k, name));
+        namesConnus.push_back(name); namesConnus.push_back("F" + IO::toString(k) + "_" + name);
+      }
+    }
+    for (int var = 1; var <= m_cellRef.getMixture()->getNumberScalars(); var++) {
+      m_masqueChamps.push_back(imprimeChamp(m_cellRef.getMixture()->returnNameScalar(var)));
+      namesConnus.push_back(m_cellRef.getMixture()->returnNameScalar(var));
+    }
+    for (int var = 1; var <= m_cellRef.getMixture()->getNumberVectors(); var++) {
+      m_masqueChamps.push_back(imprimeChamp(m_cellRef.getMixture()->returnNameVector(var)));
+      namesConnus.push_back(m_cellRef.getMixture()->returnNameVector(var));
+    }
+    for (int k = 1; k <= m_run->m_numberTransports; k++) {
+      m_masqueChamps.push_back(imprimeChamp("T" + IO::toString(k)));
+      namesConnus.push_back("T" + IO::toString(k));
+    }
+    m_masqueChamps.push_back(imprimeChamp("lvl"));
+    m_masqueChamps.push_back(imprimeChamp("Xi"));
+    namesConnus.push_back("lvl"); namesConnus.push_back("Xi");
+    namesConnus.push_back("gradRho"); namesConnus.push_back("absoluteVelocityMRF");
+    for (unsigned int i = 0; i < m_champs.size(); i++) {
+      if (find(namesConnus.begin(), namesConnus.end(), m_champs[i]) == namesConnus.end()) {
+        throw ErrorECOGEN("Output::prepareOutput : unknown printed field " + m_champs[i], __FILE__, __LINE__);
+      }
+    }
+  }
+
   //Preparation propres au type de sortie
   //-------------------------------------
   try {
@@ -216,56 +262,108 @@ void Output::ecritInfos()
 
 //***********************************************************************
 
-void Output::ecritJeuDonnees(std::vector<double> jeuDonnees, std::ofstream &fileStream, TypeData typeData)
+void Output::ecritJeuDonnees(const std::vector<double> &jeuDonnees, std::ostream &fileStream, TypeData typeData)
 {
   if (m_precision != 0) fileStream.precision(m_precision);
   if (!m_ecritBinaire) {
     for (unsigned int k = 0; k < jeuDonnees.size(); k++) { fileStream << jeuDonnees[k] << " "; }
   }
   else {
-    int donneeInt; float donneeFloat; double donneeDouble; char donneeChar;
-    int taille;
-    switch (typeData) {
-    case DOUBLE:
-      taille = jeuDonnees.size()*sizeof(double); break;
-    case FLOAT:
-      taille = jeuDonnees.size()*sizeof(float); break;
-    case INT:
-      taille = jeuDonnees.size()*sizeof(int); break;
-    case CHAR:
-      taille = jeuDonnees.size()*sizeof(char); break;
+    int taille(convertitJeuDonnees(jeuDonnees, typeData));
+    char *chaineTampon = m_tamponBinaire.data();
+    if (m_donneesAjoutees) { IO::writeChaineBrute(fileStream, chaineTampon, taille); } //Compressed appended arrays are printed by OutputXML
+    else if (m_compression > 0) { IO::writeb64ChaineCompressee(fileStream, chaineTampon, taille, m_compression); }
+    else {
+      IO::writeb64(fileStream, taille);
+      IO::writeb64Chaine(fileStream, chaineTampon, taille);
     }
-    IO::writeb64(fileStream, taille);
-    char *chaineTampon = new char[taille]; int index = 0;
-    switch (typeData) {
-    case DOUBLE:
-      for (unsigned int k = 0; k < jeuDonnees.size(); k++) {
-        donneeDouble = static_cast<double>(jeuDonnees[k]);
-        IO::ajouteAlaChaine(chaineTampon, index, donneeDouble);
-      }
-      break;
-    case FLOAT:
-      for (unsigned int k = 0; k < jeuDonnees.size(); k++) {
-        donneeFloat = static_cast<float>(jeuDonnees[k]);
-        IO::ajouteAlaChaine(chaineTampon, index, donneeFloat);
-      }
-      break;
-    case INT:
-      for (unsigned int k = 0; k < jeuDonnees.size(); k++) {
-        donneeInt = static_cast<int>(jeuDonnees[k]);
-        IO::ajouteAlaChaine(chaineTampon, index, donneeInt);
-      }
-      break;
-    case CHAR:
-      for (unsigned int k = 0; k < jeuDonnees.size(); k++) {
-        donneeChar = static_cast<char>(jeuDonnees[k]);
-        IO::ajouteAlaChaine(chaineTampon, index, donneeChar);
-      }
-      break;
+  }
+}
+
+//***********************************************************************
+
+int Output::convertitJeuDonnees(const std::vector<double> &jeuDonnees, TypeData typeData)
+{
+  int donneeInt; float donneeFloat; double donneeDouble; char donneeChar;
+  int taille;
+  switch (typeData) {
+  case DOUBLE:
+    taille = jeuDonnees.size()*sizeof(double); break;
+  case FLOAT:
+    taille = jeuDonnees.size()*sizeof(float); break;
+  case INT:
+    taille = jeuDonnees.size()*sizeof(int); break;
+  case CHAR:
+    taille = jeuDonnees.size()*sizeof(char); break;
+  default:
+    throw ErrorECOGEN("Output::convertitJeuDonnees : unknown data type", __FILE__, __LINE__);
+  }
+  m_tamponBinaire.resize(taille);
+  m_octetsTamponBinaire = m_tamponBinaire.capacity();
+  char *chaineTampon = m_tamponBinaire.data(); int index = 0;
+  switch (typeData) {
+  case DOUBLE:
+    for (unsigned int k = 0; k < jeuDonnees.size(); k++) {
+      donneeDouble = static_cast<double>(jeuDonnees[k]);
+      IO::ajouteAlaChaine(chaineTampon, index, donneeDouble);
+    }
+    break;
+  case FLOAT:
+    for (unsigned int k = 0; k < jeuDonnees.size(); k++) {
+      donneeFloat = static_cast<float>(jeuDonnees[k]);
+      IO::ajouteAlaChaine(chaineTampon, index, donneeFloat);
+    }
+    break;
+  case INT:
+    for (unsigned int k = 0; k < jeuDonnees.size(); k++) {
+      donneeInt = static_cast<int>(jeuDonnees[k]);
+      IO::ajouteAlaChaine(chaineTampon, index, donneeInt);
     }
-    IO::writeb64Chaine(fileStream, chaineTampon, taille);
-    delete[]chaineTampon;
+    break;
+  case CHAR:
+    for (unsigned int k = 0; k < jeuDonnees.size(); k++) {
+      donneeChar = static_cast<char>(jeuDonnees[k]);
+      IO::ajouteAlaChaine(chaineTampon, index, donneeChar);
+    }
+    break;
   }
+  return taille;
+}
+
+//***********************************************************************
+
+void Output::lectureChamps(XMLElement *element)
+{
+  //ex : <fields>Pressure_Mixture F0_Alpha T1</fields>
+  m_champs.clear();
+  XMLElement *elementChamps = element->FirstChildElement("fields");
+  if (elementChamps == NULL || elementChamps->GetText() == NULL) return;
+  istringstream liste(elementChamps->GetText());
+  string name;
+  while (liste >> name) { m_champs.push_back(name); }
+}
+
+//***********************************************************************
+
+bool Output::imprimeChamp(const string &name) const
+{
+  if (m_champs.empty()) return true;
+  return (find(m_champs.begin(), m_champs.end(), name) != m_champs.end());
+}
+
+//***********************************************************************
+
+bool Output::imprimeVariablePhase(const int &phase, const string &name) const
+{
+  return (imprimeChamp(name) || imprimeChamp("F" + IO::toString(phase) + "_" + name));
+}
+
+//***********************************************************************
+
+const vector<bool>* Output::getMasqueChamps() const
+{
+  if (m_champs.empty()) return 0;
+  return &m_masqueChamps;
 }
 
 //***********************************************************************
@@ -330,7 +428,28 @@ void Output::afficheInfoEcriture() const
   cout << "T" << m_run->m_numTest << " | RESULTS FILE NUMBER : " << m_numFichier << ",  ITERATION " << m_run->m_iteration << endl;
   cout << "T" << m_run->m_numTest << " |     Physical time       = " << m_run->m_physicalTime << " s " << endl;
   cout << "T" << m_run->m_numTest << " |     Last time step      = " << m_run->m_dt << " s " << endl;
-  m_run->m_stat.printScreenStats(m_run->m_numTest);
+  m_run->m_stat.printScreenStats(m_run->m_numTest, m_run->m_throughputOutputs);
+}
+
+//***********************************************************************
+
+void Output::ecritStatsCommunications() const
+{
+  parallel.ecritStatsCommunications(m_dossierSortie);
+}
+
+//***********************************************************************
+
+void Output::ecritStatsMemory() const
+{
+  m_run->m_memory.printStats(m_run->m_numTest, m_dossierSortie);
+}
+
+//***********************************************************************
+
+void Output::ecritStatsCounters() const
+{
+  profiler.printCounters(m_run->m_numTest, m_run->m_stat.getCellUpdates(), m_dossierSortie);
 }
 
 //***********************************************************************
@@ -343,6 +462,12 @@ void Output::saveInfos() const
     fileStream.open((m_dossierSortie + m_infosCalcul).c_str(), ios::app);
     if(m_numFichier==0) fileStream << Ncpu << endl;
     fileStream << m_numFichier << " " << m_run->m_iteration << " " << m_run->m_physicalTime << " " << m_run->m_stat.getComputationTime() << " " << m_run->m_dt;
+    //Throughput since the previous output: leaf-cell updates of all CPUs, cell updates/s (all CPUs, slowest and fastest CPU), remaining time (s)
+    const Throughput &throughput(m_run->m_throughputOutputs);
+    fileStream << " " << throughput.getCellUpdatesGlobal() << " " << throughput.getCellUpdatesPerSecondGlobal() << " " << throughput.getCellUpdatesPerSecondMin()
+      << " " << throughput.getCellUpdatesPerSecondMax() << " " << throughput.getRemainingTime();
+    //Computation time in seconds (the one above is in CLOCKS_PER_SEC units)
+    fileStream << " " << m_run->m_stat.getComputationTimeSeconds();
 
     //Additional output with purpose to track the radius of a bubble over time and the maximum pressures.
     //To comment if not needed. Be carefull when using it, integration for bubble radius and maximum pressure at the wall are not generalized.
@@ -410,6 +535,28 @@ void Output::readInfos()
 
 //***********************************************************************
 
+void Output::eraseInfos(const int &numFichier)
+{
+  if (rankCpu == 0) {
+    fstream fileStream;
+    vector<string> lignes;
+    string ligne;
+    int numLigne;
+    fileStream.open((m_dossierSortie + m_infosCalcul).c_str(), ios::in);
+    if (std::getline(fileStream, ligne)) lignes.push_back(ligne); //CPU number
+    while (std::getline(fileStream, ligne)) {
+      istringstream chaine(ligne);
+      if (chaine >> numLigne && numLigne < numFichier) lignes.push_back(ligne);
+    }
+    fileStream.close();
+    fileStream.open((m_dossierSortie + m_infosCalcul).c_str(), ios::out | ios::trunc);
+    for (unsigned int i = 0; i < lignes.size(); i++) { fileStream << lignes[i] << endl; }
+    fileStream.close();
+  }
+}
+
+//***********************************************************************
+
 void Output::saveInfosMailles() const
 {
   try {
@@ -47,6 +47,7 @@
 #include <string>
 #include <fstream>
 #include <vector>
+#include <atomic>
 #include "../libTierces/tinyxml2.h"
 #include "../Errors.h"
 #include "../Meshes/HeaderMesh.h"
@@ -65,22 +66,38 @@ class Output
     virtual ~Output();
 
     virtual void locateProbeInMesh(Cell **cells, const int &nbCells, bool localSeeking = false) { try { throw ErrorECOGEN("locateProbeInMesh not available for requested output format"); } catch (ErrorECOGEN &) { throw; } };
-    virtual Cell* locateProbeInAMRSubMesh(std::vector<Cell*>* cells, const int &nbCells) { try { throw ErrorECOGEN("locateProbeInMesh not available for requested output format"); } catch (ErrorECOGEN &) { throw; } return 0; };
+    virtual Cell* locateProbeInAMRSubMesh(std::vector<Cell*>* cells, const int &nbCells, std::vector<Cell*> * /*path*/ = 0) { try { throw ErrorECOGEN("locateProbeInMesh not available for requested output format"); } catch (ErrorECOGEN &) { throw; } return 0; };
 
     void prepareOutput(const Cell &cell);
     virtual void prepareOutputInfos();
     virtual void ecritSolution(Mesh *mesh, std::vector<Cell *> *cellsLvl) { try { throw ErrorECOGEN("ecritSolution not available for requested output format"); } catch (ErrorECOGEN &) { throw; }};
+    //! \brief     Wait for the end of the printing of the last solution when it is printed in background
+    virtual void attendEcritureSolution() {};
+    //! \brief     Print the samples recorded in memory since the last flush (probes)
+    virtual void flushBuffer() {};
+    //! \brief     Locate again the output in the mesh after a repartition of the cells between CPUs (cuts and probes)
+    virtual void relocateInMesh() {};
+    //! \brief     Bytes held in memory for printing (binary conversion buffer, staged snapshot or recorded samples)
+    virtual long long getMemoryStaging() const { return m_octetsTamponBinaire; };
     void printTree(Mesh* mesh, std::vector<Cell *> *cellsLvl);
     virtual void ecritInfos();
+    //! \brief     Print the statistics of the parallel communications in the results folder (to be called by all CPUs)
+    void ecritStatsCommunications() const;
+    //! \brief     Print the memory statistics of the subsystems and the per-CPU high-water marks in the results folder (to be called by all CPUs)
+    void ecritStatsMemory() const;
+    void ecritStatsCounters() const;
 
     virtual void prepareSortieSpecifique() { try { throw ErrorECOGEN("prepareSortieSpecifique not available for requested output format"); } catch (ErrorECOGEN &) { throw; } };
 
     void readInfos();
+    //! \brief     Erase the lines of the infos file from the given results file number (resuming from a checkpoint)
+    void eraseInfos(const int &numFichier);
     virtual void readResults(Mesh *mesh, std::vector<Cell *> *cellsLvl, const int fileNumber) { try { throw ErrorECOGEN("readResutls not available for requested output format"); } catch (ErrorECOGEN &) { throw; } };
     void readTree(Mesh *mesh, std::vector<Cell *> *cellsLvl, std::vector<CellInterface *> *boundariesLvl, const int fileNumber, const std::vector<AddPhys*> &addPhys, Model *model, int &nbCellsTotalAMR);
 
     //Accesseur
     int getNumSortie() const { return m_numFichier; };
+    void setNumSortie(const int &numFichier) { m_numFichier = numFichier; };
     virtual double getNextTime() { try { throw ErrorECOGEN("getNextTime not available for requested output format"); } catch (ErrorECOGEN &) { throw; } return 0.; }
     virtual bool possesses() { try { throw ErrorECOGEN("possesses not available for requested output format"); } catch (ErrorECOGEN &) { throw; } return false; };
 
@@ -92,7 +109,20 @@ class Output
     void saveInfosMailles() const;
     std::string creationNameFichier(const char* name, int lvl = -1, int proc = -1, int numFichier = -1) const;
 
-    void ecritJeuDonnees(std::vector<double> jeuDonnees, std::ofstream &fileStream, TypeData typeData);
+    void ecritJeuDonnees(const std::vector<double> &jeuDonnees, std::ostream &fileStream, TypeData typeData);
+    //! \brief     Binary conversion of a data set into m_tamponBinaire
+    //! \return    size of the converted data set in bytes
+    int convertitJeuDonnees(const std::vector<double> &jeuDonnees, TypeData typeData);
+
+    //Selection des champs imprimes
+    //! \brief     Reading of the optional list of printed fields (child element "fields" of the output element)
+    void lectureChamps(tinyxml2::XMLElement *element);
+    //! \brief     Return true if the field is printed (all fields are printed when no list is given)
+    bool imprimeChamp(const std::string &name) const;
+    //! \brief     Phase variable selected either by its name (all phases) or by "F<phase>_<name>"
+    bool imprimeVariablePhase(const int &phase, const std::string &name) const;
+    //! \brief     Mask of the printed columns for gnuplot formats, 0 if all fields are printed
+    const std::vector<bool>* getMasqueChamps() const;
     void getJeuDonnees(std::istringstream &data, std::vector<double> &jeuDonnees, TypeData typeData);
 
 	  Input *m_input;												   //!<Pointeur vers entree
@@ -116,6 +146,13 @@ class Output
     bool m_ecritBinaire;                                //!<Choix print binary/ASCII
     bool m_donneesSeparees;                             //!<Choix print donnees dans des fichiers separes
     int m_precision;                                    //!<Output files precision (number of digits) //default: 0
+    int m_compression;                                  //!<zlib compression level of binary data arrays (1 to 9) //default: 0 (no compression)
+    bool m_donneesAjoutees;                             //!<Choix print binary brut des donnees en fin de file (VTK AppendedData)
+    std::vector<char> m_tamponBinaire;                  //!<Buffer for the binary conversion of the data arrays, reused between arrays
+    std::atomic<long long> m_octetsTamponBinaire;       //!<Capacity of m_tamponBinaire, read by the solver thread while the writer thread converts
+
+    std::vector<std::string> m_champs;                  //!<Names of the printed fields (empty: all fields are printed)
+    std::vector<bool> m_masqueChamps;                   //!<Printed columns in the order of Cell::printPhasesMixture, followed by AMR level and Xi
 
     int m_numFichier; 
     std::string m_endianMode;
@@ -91,6 +91,8 @@ OutputCutGNU::OutputCutGNU(string casTest, string run, XMLElement *element, stri
     else if (type == PLAN) { m_objet = new GOPlan(vertex, vecteur); }
     else { throw ErrorECOGEN("OutputCutGNU::OutputCutGNU : type de cut inconnu", __FILE__, __LINE__); }
 
+    //Selection des champs imprimes (optional)
+    this->lectureChamps(element);
   }
   catch (ErrorECOGEN &) { throw; }
 }
@@ -101,12 +103,24 @@ OutputCutGNU::~OutputCutGNU(){}
 
 //***********************************************************************
 
-void OutputCutGNU::ecritSolution(Mesh *mesh, std::vector<Cell *> *cellsLvl)
+void OutputCutGNU::prepareSortieSpecifique()
+{
+  m_cellsCut.clear();
+  for (unsigned int c = 0; c < m_run->m_cellsLvl[0].size(); c++) {
+    if (m_run->m_cellsLvl[0][c]->getElement()->traverseObjet(*m_objet)) m_cellsCut.push_back(m_run->m_cellsLvl[0][c]);
+  }
+}
+
+//***********************************************************************
+
+void OutputCutGNU::ecritSolution(Mesh *mesh, std::vector<Cell *> * /*cellsLvl*/)
 {
   ofstream fileStream;
   string file = m_dossierSortie + creationNameFichierGNU(m_fileNameResults.c_str(), -1, rankCpu, m_numFichier);
   fileStream.open(file.c_str());
-  mesh->ecritSolutionGnuplot(cellsLvl, fileStream, m_objet);
+  for (unsigned int c = 0; c < m_cellsCut.size(); c++) {
+    m_cellsCut[c]->printGnuplotAMR(fileStream, mesh->getGeometrie(), m_objet, getMasqueChamps());
+  }
   fileStream << endl;
   fileStream.close();
 
@@ -46,6 +46,10 @@ public:
   OutputCutGNU(std::string casTest, std::string run, tinyxml2::XMLElement *element, std::string fileName, TypeGO type, Input *entree);
   virtual ~OutputCutGNU();
 
+  //! \brief     Selection of the level-0 cells crossed by the cut (the cut and the level-0 cells do not move)
+  virtual void prepareSortieSpecifique();
+  virtual void relocateInMesh() { this->prepareSortieSpecifique(); };
+  //! \brief     Printing of the cut, only the selected level-0 cells and their AMR subtrees are tested against the cut
   virtual void ecritSolution(Mesh *mesh, std::vector<Cell *> *cellsLvl);
 
   virtual void prepareOutputInfos() {}; //Aucune infos a ecrire
@@ -53,6 +57,7 @@ public:
 
 private:
   GeometricObject *m_objet; //droite ou plan de cut
+  std::vector<Cell *> m_cellsCut;  //!<Level-0 cells crossed by the cut, in the order of the level-0 cells array
 };
 
 #endif //OUTPUTCUTGNU_H
\ No newline at end of file
@@ -63,7 +63,7 @@ void OutputGNU::ecritSolution(Mesh *mesh, std::vector<Cell *> *cellsLvl)
     string file = m_dossierSortie + creationNameFichierGNU(m_fileNameResults.c_str(), -1, rankCpu, m_numFichier);
     fileStream.open(file.c_str());
     if (!fileStream) { throw ErrorECOGEN("Impossible d ouvrir le file " + file, __FILE__, __LINE__); }
-    mesh->ecritSolutionGnuplot(cellsLvl, fileStream);
+    mesh->ecritSolutionGnuplot(cellsLvl, fileStream, 0, getMasqueChamps());
     fileStream << endl;
     fileStream.close();
 
@@ -114,11 +114,13 @@ void OutputGNU::ecritScriptGnuplot(const int &dim)
     {
       //Variables scalars
       for (int var = 1; var <= m_cellRef.getPhase(phase)->getNumberScalars(); var++) {
+        if (!imprimeVariablePhase(phase, m_cellRef.getPhase(phase)->returnNameScalar(var))) continue;
         fileStream << "set title '" << m_cellRef.getPhase(phase)->returnNameScalar(var) << "_" << m_cellRef.getPhase(phase)->getEos()->getName() << "'" << endl;
         printBlocGnuplot(fileStream, index, dim);
       } //Fin var scalar
       //Variables vectorielles (u)
       for (int var = 1; var <= m_cellRef.getPhase(phase)->getNumberVectors(); var++) {
+        if (!imprimeVariablePhase(phase, m_cellRef.getPhase(phase)->returnNameVector(var))) continue;
         fileStream << "set title '" << m_cellRef.getPhase(phase)->returnNameVector(var) << "_" << m_cellRef.getPhase(phase)->getEos()->getName() << "'" << endl;
         printBlocGnuplot(fileStream, index, dim);
       } //Fin var vectorielle
@@ -128,11 +130,13 @@ void OutputGNU::ecritScriptGnuplot(const int &dim)
    //--------------------
    //Variables scalars
     for (int var = 1; var <= m_cellRef.getMixture()->getNumberScalars(); var++) {
+      if (!imprimeChamp(m_cellRef.getMixture()->returnNameScalar(var))) continue;
       fileStream << "set title '" << m_cellRef.getMixture()->returnNameScalar(var) << "'" << endl;
       printBlocGnuplot(fileStream, index, dim);
     } //Fin var scalar
     //Variables vectorielle
     for (int var = 1; var <= m_cellRef.getMixture()->getNumberVectors(); var++) {
+      if (!imprimeChamp(m_cellRef.getMixture()->returnNameVector(var))) continue;
       fileStream << "set title '" << m_cellRef.getMixture()->returnNameVector(var) << "'" << endl;
       printBlocGnuplot(fileStream, index, dim);
     } //Fin var vectorielle
@@ -140,19 +144,24 @@ void OutputGNU::ecritScriptGnuplot(const int &dim)
     //3) Variables transports
     //-----------------------
     for (int var = 1; var <= m_cellRef.getNumberTransports(); var++) {
+      if (!imprimeChamp("T" + IO::toString(var))) continue;
       fileStream << "set title 'Transport" << var << "'" << endl;
       printBlocGnuplot(fileStream, index, dim);
     } //Fin var scalar
 
     //4) Ecriture niveaux AMR
     //-----------------------
-    fileStream << "set title 'Niveau AMR'" << endl;
-    printBlocGnuplot(fileStream, index, dim);
+    if (imprimeChamp("lvl")) {
+      fileStream << "set title 'Niveau AMR'" << endl;
+      printBlocGnuplot(fileStream, index, dim);
+    }
 
     //5) Ecriture variable detection gradients
     //----------------------------------------
-    fileStream << "set title 'Xi'" << endl;
-    printBlocGnuplot(fileStream, index, dim);
+    if (imprimeChamp("Xi")) {
+      fileStream << "set title 'Xi'" << endl;
+      printBlocGnuplot(fileStream, index, dim);
+    }
 
     fileStream.close();
 
@@ -172,9 +181,10 @@ void OutputGNU::printBlocGnuplot(std::ofstream &fileStream, int &index, const in
     for (int t = 0; t <= m_numFichier; t++) {
       for (int p = 0; p < Ncpu; p++) {
         fileStream << " \"";
-        if(dim==0){ fileStream << creationNameFichierGNU(m_fileNameResults.c_str(), -1, -1, -1); }
+        if(dim==0){ fileStream << nameFichierSonde(); }
         else { fileStream << creationNameFichierGNU(m_fileNameResults.c_str(), -1, p, t); }
         fileStream << "\"";
+        if (dim == 0) { fileStream << optionsLectureSonde(); }
         if (dim <= 1) { fileStream << " u 1:" << index; }
         else { fileStream << " u 1:2:" << index; }
         if (dim == 0) {
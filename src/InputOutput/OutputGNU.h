@@ -52,6 +52,9 @@ protected:
 
   std::string creationNameFichierGNU(const char* name, int lvl = -1, int proc = -1, int numFichier = -1, std::string nameVariable = "defaut") const;
   void printBlocGnuplot(std::ofstream &fileStream, int &index, const int &dim);
+  //! \brief     Probe data file name and gnuplot reading options, used for scripts of probes (dim 0)
+  virtual std::string nameFichierSonde() const { return creationNameFichierGNU(m_fileNameResults.c_str(), -1, -1, -1); };
+  virtual std::string optionsLectureSonde() const { return ""; };
 
   std::string m_fileNameVisu;
 };
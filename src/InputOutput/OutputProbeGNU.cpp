@@ -40,7 +40,7 @@ using namespace tinyxml2;
 
 //***************************************************************
 
-OutputProbeGNU::OutputProbeGNU(){}
+OutputProbeGNU::OutputProbeGNU() : m_binaryProbe(false), m_bufferSize(1), m_numberColumns(0), m_numberSamples(0) {}
 
 //***************************************************************
 
@@ -58,6 +58,8 @@ OutputProbeGNU::OutputProbeGNU(string casTest, string run, XMLElement *element,
     m_input = entree;
     m_run = m_input->getRun();
     m_possessesProbe = true;
+    m_numberColumns = 0;
+    m_numberSamples = 0;
 
     XMLElement *sousElement;
     XMLError error;
@@ -76,11 +78,20 @@ OutputProbeGNU::OutputProbeGNU(string casTest, string run, XMLElement *element,
     if (error != XML_NO_ERROR) throw ErrorXMLAttribut("z", fileName, __FILE__, __LINE__);
 
     m_objet = new GOVertex(vertex);
+    m_vertex = vertex;
+
+    //Optional binary probe file
+    if (element->QueryBoolAttribute("binary", &m_binaryProbe) != XML_NO_ERROR) m_binaryProbe = false;
 
     sousElement = element->FirstChildElement("timeControl");
     if (sousElement == NULL) throw ErrorXMLElement("timeControl", fileName, __FILE__, __LINE__);
     error = sousElement->QueryDoubleAttribute("acqFreq", &m_acqFreq);
     if (error != XML_NO_ERROR) throw ErrorXMLAttribut("acqFreq", fileName, __FILE__, __LINE__);
+    if (sousElement->QueryIntAttribute("bufferSize", &m_bufferSize) != XML_NO_ERROR) m_bufferSize = 1000; //default if not specified
+    if (m_bufferSize < 1) throw ErrorXMLAttribut("bufferSize", fileName, __FILE__, __LINE__);
+
+    //Selection of the printed fields (optional)
+    this->lectureChamps(element);
   }
   catch (ErrorECOGEN &) { throw; }
 }
@@ -96,6 +107,21 @@ OutputProbeGNU::~OutputProbeGNU()
 
 void OutputProbeGNU::locateProbeInMesh(Cell **cells, const int &nbCells, bool localSeeking)
 {
+  m_path.clear();
+
+  //Direct location with the spatial index of the mesh (containing cell)
+  int index;
+  if (m_run->m_mesh->locateCell(m_vertex, index)) {
+    int trouve(index >= 0), trouveGlobal(trouve);
+    if (!localSeeking && Ncpu != 1) MPI_Allreduce(&trouve, &trouveGlobal, 1, MPI_INT, MPI_MAX, commCompute);
+    if (trouveGlobal) {
+      if (trouve) m_cell = cells[index];
+      else m_possessesProbe = false;
+      return;
+    }
+    //Probe outside of the domain: nearest cell
+  }
+
   //Locate probe in mesh
   double minimumDistance(1.e12), distance;
   for (int i = 0; i < nbCells; i++) {
@@ -110,7 +136,7 @@ void OutputProbeGNU::locateProbeInMesh(Cell **cells, const int &nbCells, bool lo
     //Is probe belonging to this CPU ?
     if (Ncpu != 1) {
       double minimumAllCPU(minimumDistance);
-      MPI_Allreduce(&minimumDistance, &minimumAllCPU, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+      MPI_Allreduce(&minimumDistance, &minimumAllCPU, 1, MPI_DOUBLE, MPI_MIN, commCompute);
       if (abs(minimumAllCPU - minimumDistance) > 1.e-10) { m_possessesProbe = false; }
     }
   }
@@ -118,7 +144,19 @@ void OutputProbeGNU::locateProbeInMesh(Cell **cells, const int &nbCells, bool lo
 
 //***********************************************************************
 
-Cell* OutputProbeGNU::locateProbeInAMRSubMesh(std::vector<Cell*> *cells, const int &nbCells)
+void OutputProbeGNU::relocateInMesh()
+{
+  if (Ncpu != 1) {
+    double nextAcq(m_nextAcq);
+    MPI_Allreduce(&nextAcq, &m_nextAcq, 1, MPI_DOUBLE, MPI_MAX, commCompute);
+  }
+  m_possessesProbe = true;
+  locateProbeInMesh(m_run->m_cells, m_run->m_mesh->getNumberCells());
+}
+
+//***********************************************************************
+
+Cell* OutputProbeGNU::locateProbeInAMRSubMesh(std::vector<Cell*> *cells, const int &nbCells, std::vector<Cell*> *path)
 {
   int index = 0;
 
@@ -133,9 +171,10 @@ Cell* OutputProbeGNU::locateProbeInAMRSubMesh(std::vector<Cell*> *cells, const i
     }
   }
 
+  if (path != 0) path->push_back((*cells)[index]);
   if (!(*cells)[index]->getSplit()) { return (*cells)[index]; }
   else {
-    return locateProbeInAMRSubMesh((*cells)[index]->getChildVector(), (*cells)[index]->getChildVector()->size());
+    return locateProbeInAMRSubMesh((*cells)[index]->getChildVector(), (*cells)[index]->getChildVector()->size(), path);
   }
   return 0;
 }
@@ -150,13 +189,61 @@ void OutputProbeGNU::prepareSortieSpecifique()
   //Locate probe in mesh
   locateProbeInMesh(m_run->m_cells, m_run->m_mesh->getNumberCells());
 
+  //Columns of a sample: time and selected variables, same order as Cell::printGnuplotAMR
+  const vector<bool> *masque(getMasqueChamps());
+  vector<string> names;
+  int colonne(0);
+  names.push_back("t");
+  for (int k = 0; k < m_run->m_numberPhases; k++) {
+    for (int var = 1; var <= m_cellRef.getPhase(k)->getNumberScalars(); var++) {
+      if (masque == 0 || (*masque)[colonne]) names.push_back("F" + IO::toString(k) + "_" + m_cellRef.getPhase(k)->returnNameScalar(var));
+      colonne++;
+    }
+    for (int var = 1; var <= m_cellRef.getPhase(k)->getNumberVectors(); var++) {
+      if (masque == 0 || (*masque)[colonne]) names.push_back("F" + IO::toString(k) + "_" + m_cellRef.getPhase(k)->returnNameVector(var));
+      colonne++;
+    }
+  }
+  for (int var = 1; var <= m_cellRef.getMixture()->getNumberScalars(); var++) {
+    if (masque == 0 || (*masque)[colonne]) names.push_back(m_cellRef.getMixture()->returnNameScalar(var));
+    colonne++;
+  }
+  for (int var = 1; var <= m_cellRef.getMixture()->getNumberVectors(); var++) {
+    if (masque == 0 || (*masque)[colonne]) names.push_back(m_cellRef.getMixture()->returnNameVector(var));
+    colonne++;
+  }
+  for (int k = 1; k <= m_run->m_numberTransports; k++) {
+    if (masque == 0 || (*masque)[colonne]) names.push_back("T" + IO::toString(k));
+    colonne++;
+  }
+  if (masque == 0 || (*masque)[colonne]) names.push_back("lvl");
+  colonne++;
+  if (masque == 0 || (*masque)[colonne]) names.push_back("Xi");
+  m_numberColumns = names.size();
+  m_buffer.assign(m_bufferSize*m_numberColumns, 0.);
+  m_numberSamples = 0;
+
+  //Header line of binary probe files, followed by the float64 records
+  stringstream header;
+  header << "# ECOGEN probe " << m_fileNameResults << " : " << m_numberColumns << " float64 columns :";
+  for (unsigned int n = 0; n < names.size(); n++) {
+    replace(names[n].begin(), names[n].end(), ' ', '_');
+    header << " " << names[n];
+  }
+  header << endl;
+  m_header = header.str();
+
   //Preparing output files
   try {
     if (m_possessesProbe) {
       //Creating output file
       ofstream fileStream;
-      string file = m_dossierSortie + creationNameFichierGNU(m_fileNameResults.c_str(), -1, -1, -1);
-      fileStream.open(file.c_str());
+      string file = m_dossierSortie + nameFichierSonde();
+      if (m_binaryProbe) {
+        fileStream.open(file.c_str(), ios_base::binary);
+        fileStream << m_header;
+      }
+      else { fileStream.open(file.c_str()); }
       fileStream.close();
 
       //Gnuplot script printing for visualisation
@@ -170,21 +257,110 @@ void OutputProbeGNU::prepareSortieSpecifique()
 
 void OutputProbeGNU::ecritSolution(Mesh *mesh, std::vector<Cell *> *cellsLvl)
 {
-  ofstream fileStream;
-  string file = m_dossierSortie + creationNameFichierGNU(m_fileNameResults.c_str(), -1, -1, -1);
-  fileStream.open(file.c_str(), ios_base::app);
-  fileStream << m_run->m_physicalTime << " ";
-
-  //Printing solution with AMR treatement if necessary
+  //Recording solution with AMR treatement if necessary
   if (!m_cell->getSplit()) {  //if cell is not split
-    m_cell->printGnuplotAMR(fileStream, 0, m_objet);
+    fillSample(m_cell);
   }
-  else { //if cell is split, locate subCells in sub AMR mesh and printing
-    locateProbeInAMRSubMesh(m_cell->getChildVector(), m_cell->getChildVector()->size())->printGnuplotAMR(fileStream, 0, m_objet);
+  else { //if cell is split, leaf located in sub AMR mesh only if a cell of the path to the previous leaf changed since the last location
+    //Path checked from the level 0 cell: children of a changed cell may have been destroyed
+    bool pathUpToDate(!m_path.empty());
+    for (unsigned int c = 0; c < m_path.size() && pathUpToDate; c++) { pathUpToDate = (m_path[c]->getTreeVersion() == m_pathVersions[c]); }
+    if (!pathUpToDate) {
+      m_path.assign(1, m_cell);
+      locateProbeInAMRSubMesh(m_cell->getChildVector(), m_cell->getChildVector()->size(), &m_path);
+      m_pathVersions.resize(m_path.size());
+      for (unsigned int c = 0; c < m_path.size(); c++) { m_pathVersions[c] = m_path[c]->getTreeVersion(); }
+    }
+    fillSample(m_path.back());
   }
-
-  fileStream.close();
   m_nextAcq += m_acqFreq;
+
+  //Printing when the buffer is full
+  if (m_numberSamples == m_bufferSize) {
+    try { this->flushBuffer(); }
+    catch (ErrorECOGEN &) { throw; }
+  }
+}
+
+//***********************************************************************
+
+void OutputProbeGNU::fillSample(Cell *cell)
+{
+  double *sample(&m_buffer[m_numberSamples*m_numberColumns]);
+  const vector<bool> *masque(getMasqueChamps());
+  int valeur(0), colonne(0);
+
+  sample[valeur++] = m_run->m_physicalTime;
+  for (int k = 0; k < m_run->m_numberPhases; k++) {
+    for (int var = 1; var <= cell->getPhase(k)->getNumberScalars(); var++) {
+      if (masque == 0 || (*masque)[colonne]) sample[valeur++] = cell->getPhase(k)->returnScalar(var);
+      colonne++;
+    }
+    for (int var = 1; var <= cell->getPhase(k)->getNumberVectors(); var++) {
+      if (masque == 0 || (*masque)[colonne]) sample[valeur++] = cell->getPhase(k)->returnVector(var).norm();
+      colonne++;
+    }
+  }
+  for (int var = 1; var <= cell->getMixture()->getNumberScalars(); var++) {
+    if (masque == 0 || (*masque)[colonne]) sample[valeur++] = cell->getMixture()->returnScalar(var);
+    colonne++;
+  }
+  for (int var = 1; var <= cell->getMixture()->getNumberVectors(); var++) {
+    if (masque == 0 || (*masque)[colonne]) sample[valeur++] = cell->getMixture()->returnVector(var).norm();
+    colonne++;
+  }
+  for (int k = 0; k < m_run->m_numberTransports; k++) {
+    if (masque == 0 || (*masque)[colonne]) sample[valeur++] = cell->getTransport(k).getValue();
+    colonne++;
+  }
+  if (masque == 0 || (*masque)[colonne]) sample[valeur++] = cell->getLvl();
+  colonne++;
+  if (masque == 0 || (*masque)[colonne]) sample[valeur++] = cell->getXi();
+  m_numberSamples++;
+}
+
+//***********************************************************************
+
+void OutputProbeGNU::flushBuffer()
+{
+  if (!m_possessesProbe || m_numberSamples == 0) return;
+  try {
+    ofstream fileStream;
+    string file = m_dossierSortie + nameFichierSonde();
+    if (m_binaryProbe) {
+      fileStream.open(file.c_str(), ios_base::app | ios_base::binary);
+      fileStream.write(reinterpret_cast<const char*>(&m_buffer[0]), m_numberSamples*m_numberColumns*sizeof(double));
+    }
+    else {
+      fileStream.open(file.c_str(), ios_base::app);
+      for (int s = 0; s < m_numberSamples; s++) {
+        for (int v = 0; v < m_numberColumns; v++) { fileStream << m_buffer[s*m_numberColumns + v] << " "; }
+        fileStream << endl;
+      }
+    }
+    if (!fileStream) throw ErrorECOGEN("OutputProbeGNU::flushBuffer : impossible to print file " + file, __FILE__, __LINE__);
+    fileStream.close();
+    m_numberSamples = 0;
+  }
+  catch (ErrorECOGEN &) { throw; }
+}
+
+//***********************************************************************
+
+string OutputProbeGNU::nameFichierSonde() const
+{
+  if (m_binaryProbe) return m_fileNameResults + ".bin";
+  return OutputGNU::nameFichierSonde();
+}
+
+//***********************************************************************
+
+string OutputProbeGNU::optionsLectureSonde() const
+{
+  if (!m_binaryProbe) return "";
+  stringstream options;
+  options << " binary skip=" << m_header.size() << " format=\"%" << m_numberColumns << "float64\"";
+  return options.str();
 }
 
 //***************************************************************
@@ -48,9 +48,9 @@ public:
   OutputProbeGNU();
   //! \brief     Probe output constructor from a XML format reading
   //! \details   Reading data from XML file under the following format:
-  //!            ex: 	<probe name="capteur1">
+  //!            ex: 	<probe name="capteur1" binary="false">   <!-- binary optional, default false -->
   //!                   <vertex x = "0.3" y = "0.05" z = "0.05" / >
-  //!                   <timeControl acqFreq = "1e-5." / >       <!-- if negative or nul, recording at each time step-->
+  //!                   <timeControl acqFreq = "1e-5." bufferSize="1000"/ >       <!-- if negative or nul, recording at each time step, bufferSize optional-->
   //!                 </probe>
   //! \param     casTest           Folder name of test case input files
   //! \param     run               Resutls folder name (defined in 'mainVX.xml')
@@ -61,10 +61,16 @@ public:
   virtual ~OutputProbeGNU();
 
   virtual void locateProbeInMesh(Cell **cells, const int &nbCells, bool localSeeking = false);
-  virtual Cell* locateProbeInAMRSubMesh(std::vector<Cell*>* cells, const int &nbCells);
+  virtual Cell* locateProbeInAMRSubMesh(std::vector<Cell*>* cells, const int &nbCells, std::vector<Cell*> *path = 0);
 
   virtual void prepareSortieSpecifique();
+  //! \brief     Record the probe sample in the memory buffer, printed when the buffer is full
   virtual void ecritSolution(Mesh *mesh, std::vector<Cell *> *cellsLvl);
+  //! \brief     Print the buffered samples in a single file access
+  virtual void flushBuffer();
+  //! \brief     The probe may change of CPU, the next acquisition time is given by its previous owner
+  virtual void relocateInMesh();
+  virtual long long getMemoryStaging() const { return m_buffer.capacity()*sizeof(double) + Output::getMemoryStaging(); };
 
   virtual void prepareOutputInfos() {}; //nothing to print
   virtual void ecritInfos() {};
@@ -74,12 +80,30 @@ public:
   virtual bool possesses() { return m_possessesProbe; };
 
 
+protected:
+  virtual std::string nameFichierSonde() const;
+  virtual std::string optionsLectureSonde() const;
+
 private:
+  //! \brief     Append the selected variables of the cell to the current sample of the buffer
+  void fillSample(Cell *cell);
+
   double m_acqFreq;           //!< Acquisition time frequency
   double m_nextAcq;           //!< Next acquisition time
   Cell *m_cell;               //!< Pointer to the level 0 cell containing the probe
+  std::vector<Cell*> m_path;  //!< Cells from m_cell down to the AMR leaf containing the probe when m_cell is split (empty if not located yet)
+  std::vector<int> m_pathVersions; //!< Tree versions of the cells of m_path when the leaf was located
+  Coord m_vertex;             //!< Probe position
   GeometricObject *m_objet;   //!< To store position
   bool m_possessesProbe;      //!< True if the CPU possesses probe
+
+  //Recording buffer
+  bool m_binaryProbe;                //!< Binary probe file (float64 records after a text header line)
+  int m_bufferSize;                  //!< Maximum number of samples kept in memory before printing
+  int m_numberColumns;               //!< Number of values of a sample (time and selected variables)
+  int m_numberSamples;               //!< Number of samples currently in the buffer
+  std::vector<double> m_buffer;      //!< Recorded samples, m_numberColumns values per sample
+  std::string m_header;              //!< Header line of the binary probe file
 };
 
 #endif //OUTPUTPROBEGNU_H
\ No newline at end of file
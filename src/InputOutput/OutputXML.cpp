@@ -40,17 +40,36 @@ using namespace tinyxml2;
 
 //***********************************************************************
 
-OutputXML::OutputXML(){}
+OutputXML::OutputXML() : m_fichierUnique(false), m_offsetAjoute(0), m_octetsAjoutes(0), m_asynchrone(false), m_modeEcriture(ECRITURE_DIRECTE), m_typeMeshTampon(REC), m_lvlMaxTampon(0), m_octetsTampon(0) {}
 
 //***********************************************************************
 
+//ex :	<outputMode format="XML" binary="false" singleFile="true"/>
+//ex :	<outputMode format="XML" binary="false" asynchronous="true"/>
+//ex :	<outputMode format="XML" binary="true" appended="true"/>
+
 OutputXML::OutputXML(string casTest, string run, XMLElement *element, string fileName, Input *entree) :
-  Output(casTest, run, element, fileName, entree)
-{}
+  Output(casTest, run, element, fileName, entree), m_offsetAjoute(0), m_octetsAjoutes(0), m_modeEcriture(ECRITURE_DIRECTE), m_typeMeshTampon(REC), m_lvlMaxTampon(0), m_octetsTampon(0)
+{
+  //Single file per snapshot (optional)
+  if (element->QueryBoolAttribute("singleFile", &m_fichierUnique) != XML_NO_ERROR) m_fichierUnique = false; //default if not specified
+  //Background printing of the snapshots (optional)
+  if (element->QueryBoolAttribute("asynchronous", &m_asynchrone) != XML_NO_ERROR) m_asynchrone = false; //default if not specified
+  //The writer thread does not make MPI calls
+  if (m_asynchrone && m_fichierUnique) throw ErrorECOGEN("OutputXML: asynchronous and singleFile output modes are not compatible, file " + fileName, __FILE__, __LINE__);
+  //Raw binary data at the end of the files (optional)
+  if (element->QueryBoolAttribute("appended", &m_donneesAjoutees) != XML_NO_ERROR) m_donneesAjoutees = false; //default if not specified
+  if (m_donneesAjoutees && !m_ecritBinaire) throw ErrorECOGEN("OutputXML: appended output mode requires binary=\"true\", file " + fileName, __FILE__, __LINE__);
+  //Offsets of the appended data are local to each CPU piece
+  if (m_donneesAjoutees && m_fichierUnique) throw ErrorECOGEN("OutputXML: appended and singleFile output modes are not compatible, file " + fileName, __FILE__, __LINE__);
+}
 
 //***********************************************************************
 
-OutputXML::~OutputXML(){}
+OutputXML::~OutputXML()
+{
+  if (m_ecrivain.joinable()) m_ecrivain.join();
+}
 
 //***********************************************************************
 
@@ -80,10 +99,24 @@ void OutputXML::prepareSortieSpecifique()
 void OutputXML::ecritSolution(Mesh* mesh, vector<Cell *> *cellsLvl)
 {
   try {
-    //Ecriture des fichiers de sortie au format XML
-    ecritSolutionXML(mesh, cellsLvl);
-    //Ajout du file Collection pour grouper les niveaux, les temps, les CPU, etc.
-    if (rankCpu == 0) { ecritCollectionXML(mesh); }
+    if (!m_asynchrone) {
+      //Ecriture des fichiers de sortie au format XML
+      ecritSolutionXML(mesh, cellsLvl, m_numFichier);
+      //Ajout du file Collection pour grouper les niveaux, les temps, les CPU, etc.
+      if (rankCpu == 0) { ecritCollectionXML(mesh, m_numFichier); }
+    }
+    else {
+      //Back-pressure: the previous snapshot has to be printed before staging the new one
+      attendEcritureSolution();
+      //Copy of the data sets in the staging buffer, the solver then resumes while the writer thread formats and prints them
+      m_modeEcriture = MISE_EN_TAMPON;
+      m_octetsTampon = 0;
+      m_typeMeshTampon = mesh->getType();
+      m_lvlMaxTampon = mesh->getLvlMax();
+      ecritSolutionXML(mesh, cellsLvl, m_numFichier);
+      m_modeEcriture = RELECTURE_TAMPON;
+      m_ecrivain = thread(&OutputXML::ecritInstantaneDiffere, this, mesh, m_numFichier);
+    }
   }
   catch (ErrorECOGEN &) { throw; } // Renvoi au niveau suivant
   m_numFichier++;
@@ -91,15 +124,206 @@ void OutputXML::ecritSolution(Mesh* mesh, vector<Cell *> *cellsLvl)
 
 //***********************************************************************
 
+void OutputXML::attendEcritureSolution()
+{
+  if (m_ecrivain.joinable()) m_ecrivain.join();
+  m_modeEcriture = ECRITURE_DIRECTE;
+  //Exception of the writer thread thrown back in the solver thread
+  if (m_erreurEcrivain) {
+    exception_ptr erreur(m_erreurEcrivain);
+    m_erreurEcrivain = exception_ptr();
+    rethrow_exception(erreur);
+  }
+}
+
+//***********************************************************************
+
+void OutputXML::ecritInstantaneDiffere(Mesh *mesh, int numFichier)
+{
+  //Cells are not accessed while replaying the staged data sets
+  try {
+    ecritSolutionXML(mesh, 0, numFichier);
+    if (rankCpu == 0) { ecritCollectionXML(mesh, numFichier); }
+  }
+  catch (...) { m_erreurEcrivain = current_exception(); }
+  m_tamponJeux.clear();
+  m_tamponChaines.clear();
+  m_octetsTampon = 0;
+}
+
+//***********************************************************************
+
+void OutputXML::ecritJeuDonneesXML(vector<double> &jeuDonnees, ostream &fileStream, TypeData typeData)
+{
+  switch (m_modeEcriture) {
+  case MISE_EN_TAMPON:
+    m_tamponJeux.push_back(vector<double>());
+    m_tamponJeux.back().swap(jeuDonnees);
+    m_octetsTampon += m_tamponJeux.back().capacity()*sizeof(double);
+    break;
+  case RELECTURE_TAMPON:
+    m_octetsTampon -= m_tamponJeux.front().capacity()*sizeof(double);
+    jeuDonnees.swap(m_tamponJeux.front());
+    m_tamponJeux.pop_front();
+    this->ecritJeuDonnees(jeuDonnees, fileStream, typeData);
+    break;
+  default:
+    this->ecritJeuDonnees(jeuDonnees, fileStream, typeData);
+  }
+}
+
+//***********************************************************************
+
+void OutputXML::ecritDataArrayXML(vector<double> &jeuDonnees, ostream &fileStream, TypeData typeData, bool indentation)
+{
+  if (m_donneesAjoutees) {
+    //Only the offset in the appended data is printed in the tag, raw data are printed at the end of the file
+    fileStream << " format=\"appended\" offset=\"" << m_offsetAjoute << "\"/>" << endl;
+    if (m_modeEcriture == MISE_EN_TAMPON) { ecritJeuDonneesXML(jeuDonnees, fileStream, typeData); }
+    else {
+      if (m_modeEcriture == RELECTURE_TAMPON) {
+        m_octetsTampon -= m_tamponJeux.front().capacity()*sizeof(double);
+        jeuDonnees.swap(m_tamponJeux.front());
+        m_tamponJeux.pop_front();
+      }
+      ajouteJeuDonneesXML(jeuDonnees, typeData);
+    }
+  }
+  else {
+    if (!m_ecritBinaire) {
+      fileStream << " format=\"ascii\">" << endl;
+      if (indentation) fileStream << "          ";
+    }
+    else { fileStream << " format=\"binary\">" << endl; }
+    ecritJeuDonneesXML(jeuDonnees, fileStream, typeData);
+    fileStream << endl;
+    fileStream << "        </DataArray>" << endl;
+  }
+}
+
+//***********************************************************************
+
+void OutputXML::ajouteJeuDonneesXML(vector<double> &jeuDonnees, TypeData typeData)
+{
+  if (m_compression > 0) {
+    int taille(convertitJeuDonnees(jeuDonnees, typeData));
+    m_blocsCompresses.push_back(vector<char>());
+    IO::compresseChaineBrute(m_tamponBinaire.data(), taille, m_compression, m_blocsCompresses.back());
+    m_offsetAjoute += m_blocsCompresses.back().size();
+    m_octetsAjoutes += m_blocsCompresses.back().capacity();
+  }
+  else {
+    int tailleDonnee(0);
+    switch (typeData) {
+    case DOUBLE: tailleDonnee = sizeof(double); break;
+    case FLOAT: tailleDonnee = sizeof(float); break;
+    case INT: tailleDonnee = sizeof(int); break;
+    case CHAR: tailleDonnee = sizeof(char); break;
+    default: throw ErrorECOGEN("OutputXML::ajouteJeuDonneesXML : unknown data type", __FILE__, __LINE__);
+    }
+    m_offsetAjoute += sizeof(unsigned int) + jeuDonnees.size()*tailleDonnee;
+    m_jeuxAjoutes.push_back(vector<double>());
+    m_jeuxAjoutes.back().swap(jeuDonnees);
+    m_typesAjoutes.push_back(typeData);
+    m_octetsAjoutes += m_jeuxAjoutes.back().capacity()*sizeof(double);
+  }
+}
+
+//***********************************************************************
+
+void OutputXML::ecritDonneesAjouteesXML(ostream &fileStream)
+{
+  fileStream << "  <AppendedData encoding=\"raw\">" << endl << "   _";
+  while (!m_blocsCompresses.empty()) {
+    if (!m_blocsCompresses.front().empty()) fileStream.write(m_blocsCompresses.front().data(), m_blocsCompresses.front().size());
+    m_octetsAjoutes -= m_blocsCompresses.front().capacity();
+    m_blocsCompresses.pop_front();
+  }
+  while (!m_jeuxAjoutes.empty()) {
+    ecritJeuDonnees(m_jeuxAjoutes.front(), fileStream, m_typesAjoutes.front());
+    m_octetsAjoutes -= m_jeuxAjoutes.front().capacity()*sizeof(double);
+    m_jeuxAjoutes.pop_front();
+    m_typesAjoutes.pop_front();
+  }
+  fileStream << endl << "  </AppendedData>" << endl;
+  m_offsetAjoute = 0;
+}
+
+//***********************************************************************
+
+void OutputXML::ecritHeaderPieceXML(Mesh *mesh, vector<Cell *> *cellsLvl, ostream &fileStream, const int &lvl)
+{
+  ostringstream header;
+  switch (m_modeEcriture) {
+  case MISE_EN_TAMPON:
+    mesh->ecritHeaderPiece(header, cellsLvl, lvl);
+    m_tamponChaines.push_back(header.str());
+    m_octetsTampon += m_tamponChaines.back().capacity();
+    break;
+  case RELECTURE_TAMPON:
+    fileStream << m_tamponChaines.front();
+    m_octetsTampon -= m_tamponChaines.front().capacity();
+    m_tamponChaines.pop_front();
+    break;
+  default:
+    mesh->ecritHeaderPiece(fileStream, cellsLvl, lvl);
+  }
+}
+
+//***********************************************************************
+
+TypeM OutputXML::typeMeshXML(Mesh *mesh) const
+{
+  if (m_modeEcriture == RELECTURE_TAMPON) return m_typeMeshTampon;
+  return mesh->getType();
+}
+
+//***********************************************************************
+
+int OutputXML::lvlMaxXML(Mesh *mesh) const
+{
+  if (m_modeEcriture == RELECTURE_TAMPON) return m_lvlMaxTampon;
+  return mesh->getLvlMax();
+}
+
+//***********************************************************************
+
+string OutputXML::chaineExtentXML(Mesh *mesh, bool global)
+{
+  string extent;
+  switch (m_modeEcriture) {
+  case MISE_EN_TAMPON:
+    extent = mesh->recupereChaineExtent(rankCpu, global);
+    m_tamponChaines.push_back(extent);
+    m_octetsTampon += m_tamponChaines.back().capacity();
+    break;
+  case RELECTURE_TAMPON:
+    extent = m_tamponChaines.front();
+    m_octetsTampon -= m_tamponChaines.front().capacity();
+    m_tamponChaines.pop_front();
+    break;
+  default:
+    extent = mesh->recupereChaineExtent(rankCpu, global);
+  }
+  return extent;
+}
+
+//***********************************************************************
+
 void OutputXML::readResults(Mesh *mesh, vector<Cell *> *cellsLvl, const int fileNumber)
 {
   try {
+    //Results printed with a selection of fields do not contain the complete state
+    if (!m_champs.empty()) throw ErrorECOGEN("OutputXML::readResults : resuming impossible from results printed with a selection of fields (use checkpoints)", __FILE__, __LINE__);
+
     //Browsing through AMR levels
     for (int lvl = 0; lvl <= mesh->getLvlMax(); lvl++) {
 
       //1) Parsing XML file
       //-------------------
-      stringstream fileName(m_dossierSortie + creationNameFichierXML(m_fileNameResults.c_str(), mesh, lvl, rankCpu, m_numFichier));
+      int proc(rankCpu);
+      if (m_fichierUnique) proc = -1;
+      stringstream fileName(m_dossierSortie + creationNameFichierXML(m_fileNameResults.c_str(), mesh, lvl, proc, m_numFichier));
       XMLDocument xmlMain;
       XMLError error(xmlMain.LoadFile(fileName.str().c_str())); //Le file est parse ici
       if (error != XML_SUCCESS) throw ErrorXML(fileName.str(), __FILE__, __LINE__);
@@ -128,6 +352,13 @@ void OutputXML::readResults(Mesh *mesh, vector<Cell *> *cellsLvl, const int file
       }
       nodePiece = nodeGrid->FirstChildElement("Piece");
       if (nodePiece == NULL) throw ErrorXMLRacine("Piece", fileName.str(), __FILE__, __LINE__);
+      //Single file: pieces are ordered by CPU
+      if (m_fichierUnique) {
+        for (int p = 0; p < rankCpu; p++) {
+          nodePiece = nodePiece->NextSiblingElement("Piece");
+          if (nodePiece == NULL) throw ErrorECOGEN("OutputXML::readResults: fewer pieces than CPUs in " + fileName.str(), __FILE__, __LINE__);
+        }
+      }
       nodeCellData = nodePiece->FirstChildElement("CellData");
       if (nodeCellData == NULL) throw ErrorXMLRacine("CellData", fileName.str(), __FILE__, __LINE__);
 
@@ -243,7 +474,7 @@ string OutputXML::creationNameFichierXML(const char* name, Mesh *mesh, int lvl,
     if(mesh==0) num << ".pvd"; //Extension pour la collection
     else {
       num << "." << prefix;
-      switch (mesh->getType()) {
+      switch (typeMeshXML(mesh)) {
       case REC:
         num << "vtr"; break;
       case UNS:
@@ -263,30 +494,47 @@ string OutputXML::creationNameFichierXML(const char* name, Mesh *mesh, int lvl,
 
 //***********************************************************************
 
-void OutputXML::ecritSolutionXML(Mesh* mesh, vector<Cell *> *cellsLvl)
+void OutputXML::ecritSolutionXML(Mesh* mesh, vector<Cell *> *cellsLvl, int numFichier)
 {
-  ofstream fileStream;
-
   try {
     //On balaye les niveau pour AMR
-    for (int lvl = 0; lvl <= mesh->getLvlMax(); lvl++) {
+    for (int lvl = 0; lvl <= lvlMaxXML(mesh); lvl++) {
       
       //1) Ouverture / creation file
       //-------------------------------
-      string file = m_dossierSortie + creationNameFichierXML(m_fileNameResults.c_str(), mesh, lvl, rankCpu, m_numFichier);
-      fileStream.open(file.c_str(), ios::trunc);
-      if (!fileStream) { throw ErrorECOGEN("Impossible d ouvrir le file " + file, __FILE__, __LINE__); }
-      fileStream << "<?xml version=\"1.0\"?>" << endl;
+      //En mode file unique, chaque CPU formate son bloc en memoire : l entete est ecrite par le CPU 0, la fin de file par le dernier CPU
+      ofstream fileStream;
+      ostringstream blocMemoire;
+      ostream *flux(&fileStream);
+      bool entete(true), finFichier(true);
+      string file;
+      if (m_modeEcriture == MISE_EN_TAMPON) {
+        flux = &blocMemoire; //Staging of the data sets only, formatted text is not used
+      }
+      else if (m_fichierUnique) {
+        file = m_dossierSortie + creationNameFichierXML(m_fileNameResults.c_str(), mesh, lvl, -1, numFichier);
+        flux = &blocMemoire;
+        entete = (rankCpu == 0);
+        finFichier = (rankCpu == Ncpu - 1);
+      }
+      else {
+        file = m_dossierSortie + creationNameFichierXML(m_fileNameResults.c_str(), mesh, lvl, rankCpu, numFichier);
+        fileStream.open(file.c_str(), ios::trunc);
+        if (!fileStream) { throw ErrorECOGEN("Impossible d ouvrir le file " + file, __FILE__, __LINE__); }
+      }
+      if (entete) *flux << "<?xml version=\"1.0\"?>" << endl;
+      m_offsetAjoute = 0;
+      m_jeuxAjoutes.clear(); m_typesAjoutes.clear(); m_blocsCompresses.clear(); m_octetsAjoutes = 0;
       
       //2) Ecriture du mesh
       //-----------------------
-      switch (mesh->getType()) {
+      switch (typeMeshXML(mesh)) {
       case REC:
-        ecritMeshRectilinearXML(mesh, cellsLvl, fileStream); break;
+        ecritMeshRectilinearXML(mesh, cellsLvl, *flux, false, entete); break;
       case UNS:
-        ecritMeshUnstructuredXML(mesh, cellsLvl, fileStream, lvl); break;
+        ecritMeshUnstructuredXML(mesh, cellsLvl, *flux, lvl, false, entete); break;
       case AMR:
-        ecritMeshUnstructuredXML(mesh, cellsLvl, fileStream, lvl); break;
+        ecritMeshUnstructuredXML(mesh, cellsLvl, *flux, lvl, false, entete); break;
         //ecritMeshPolyDataXML(mesh, cellsLvl, fileStream, lvl); break;
       default:
         throw ErrorECOGEN("Output::ecritSolutionXML : type mesh inconnu", __FILE__, __LINE__); break;
@@ -294,22 +542,24 @@ void OutputXML::ecritSolutionXML(Mesh* mesh, vector<Cell *> *cellsLvl)
       
       //3) Ecriture des donnees phases fluides
       //--------------------------------------
-      ecritDonneesPhysiquesXML(mesh, cellsLvl, fileStream, lvl);
+      ecritDonneesPhysiquesXML(mesh, cellsLvl, *flux, lvl);
       
       //4) Finalisation file
       //-----------------------
-      switch (mesh->getType()) {
+      switch (typeMeshXML(mesh)) {
       case REC:
-        ecritFinFichierRectilinearXML(fileStream); break;
+        ecritFinFichierRectilinearXML(*flux, false, finFichier); break;
       case UNS:
-        ecritFinFichierUnstructuredXML(fileStream); break;
+        ecritFinFichierUnstructuredXML(*flux, false, finFichier); break;
       case AMR:
-        ecritFinFichierUnstructuredXML(fileStream); break;
+        ecritFinFichierUnstructuredXML(*flux, false, finFichier); break;
         //ecritFinFichierPolyDataXML(fileStream); break;
       default:
         throw ErrorECOGEN("Output::ecritSolutionXML : type mesh inconnu", __FILE__, __LINE__); break;
       }
-      fileStream.close();
+      if (m_modeEcriture == MISE_EN_TAMPON) {}
+      else if (m_fichierUnique) { ecritFichierUniqueMPI(file, blocMemoire.str()); }
+      else { fileStream.close(); }
 
     } //Fin lvl
   } //Fin try
@@ -318,7 +568,7 @@ void OutputXML::ecritSolutionXML(Mesh* mesh, vector<Cell *> *cellsLvl)
 
 //***********************************************************************
 
-void OutputXML::ecritCollectionXML(Mesh *mesh)
+void OutputXML::ecritCollectionXML(Mesh *mesh, int numFichier)
 {
   try {
     ofstream fileStream;
@@ -334,12 +584,17 @@ void OutputXML::ecritCollectionXML(Mesh *mesh)
     else { fileStream << m_endianMode.c_str() << "\" "; }
     fileStream << "compressor=\"vtkZLibDataCompressor\">";
     fileStream << endl << "    <Collection>" << endl;
-    for (int time = 0; time <= m_numFichier; time++) {
+    for (int time = 0; time <= numFichier; time++) {
       //fileStream2 >> a >> b >> realTime >> c >> d >> e >> f >> g >> h >> i >> j >> k >> l >> m; //For real-time file name
       //fileStream2 >> a >> b >> realTime >> c >> d;                                              //For real-time file name
-      for (int p = 0; p < Ncpu; p++) {
-        for (int lvl = 0; lvl <= mesh->getLvlMax(); lvl++) {
-          string file = creationNameFichierXML(m_fileNameResults.c_str(), mesh, lvl, p, time);
+      //Single file: one dataset per time and AMR level
+      int numberFichiersCpu(Ncpu);
+      if (m_fichierUnique) numberFichiersCpu = 1;
+      for (int p = 0; p < numberFichiersCpu; p++) {
+        for (int lvl = 0; lvl <= lvlMaxXML(mesh); lvl++) {
+          int proc(p);
+          if (m_fichierUnique) proc = -1;
+          string file = creationNameFichierXML(m_fileNameResults.c_str(), mesh, lvl, proc, time);
           fileStream << "        <DataSet timestep=\"" << time << "\" part=\"" << p << "\" file=\"" << file.c_str() << "\"/>" << endl;
           //fileStream << "        <DataSet timestep=\"" << realTime << "\" part=\"" << p << "\" file=\"" << file.c_str() << "\"/>" << endl; //For real-time file name
         }
@@ -355,7 +610,7 @@ void OutputXML::ecritCollectionXML(Mesh *mesh)
 
 //***********************************************************************
 
-void OutputXML::ecritDonneesPhysiquesXML(Mesh *mesh, vector<Cell *> *cellsLvl, std::ofstream &fileStream, const int &lvl, bool parallel)
+void OutputXML::ecritDonneesPhysiquesXML(Mesh *mesh, vector<Cell *> *cellsLvl, std::ostream &fileStream, const int &lvl, bool parallel)
 {
   vector<double> jeuDonnees;
 
@@ -363,9 +618,6 @@ void OutputXML::ecritDonneesPhysiquesXML(Mesh *mesh, vector<Cell *> *cellsLvl, s
   if (parallel) { prefix = "P"; }
   else { prefix = ""; }
 
-  string format = "ascii";
-  if (m_ecritBinaire) format = "binary";
-
   fileStream << "      <" << prefix << "CellData>" << endl;
 
   //1) Ecriture des variables des phases
@@ -374,26 +626,22 @@ void OutputXML::ecritDonneesPhysiquesXML(Mesh *mesh, vector<Cell *> *cellsLvl, s
   {
     //Ecriture des variables scalars
     for (int var = 1; var <= m_cellRef.getPhase(phase)->getNumberScalars(); var++) {
+      if (!imprimeVariablePhase(phase, m_cellRef.getPhase(phase)->returnNameScalar(var))) continue;
       fileStream << "        <" << prefix << "DataArray type=\"Float32\" Name=\"F" << phase << "_" << m_cellRef.getPhase(phase)->returnNameScalar(var) << "_" << m_cellRef.getPhase(phase)->getEos()->getName() << "\"";
       if (!parallel) {
-        fileStream << " format=\"" << format << "\">" << endl;
-        mesh->recupereDonnees(cellsLvl, jeuDonnees, var, phase, lvl);
-        this->ecritJeuDonnees(jeuDonnees, fileStream, FLOAT);
-        fileStream << endl;
-        fileStream << "        </" << prefix << "DataArray>" << endl;
+        if (m_modeEcriture != RELECTURE_TAMPON) mesh->recupereDonnees(cellsLvl, jeuDonnees, var, phase, lvl);
+        ecritDataArrayXML(jeuDonnees, fileStream, FLOAT);
       }
       else { fileStream << "\"/>" << endl; }
     }
     //Ecriture des variables vectorielles
     for (int var = 1; var <= m_cellRef.getPhase(phase)->getNumberVectors(); var++)
     {
+      if (!imprimeVariablePhase(phase, m_cellRef.getPhase(phase)->returnNameVector(var))) continue;
       fileStream << "        <" << prefix << "DataArray type=\"Float32\" Name=\"F" << phase << "_" << m_cellRef.getPhase(phase)->returnNameVector(var) << "_" << m_cellRef.getPhase(phase)->getEos()->getName() << "\" NumberOfComponents=\"3\"";
       if (!parallel) {
-        fileStream << " format=\"" << format << "\">" << endl;
-        mesh->recupereDonnees(cellsLvl, jeuDonnees, -var, phase, lvl);
-        this->ecritJeuDonnees(jeuDonnees, fileStream, FLOAT);
-        fileStream << endl;
-        fileStream << "        </" << prefix << "DataArray>" << endl;
+        if (m_modeEcriture != RELECTURE_TAMPON) mesh->recupereDonnees(cellsLvl, jeuDonnees, -var, phase, lvl);
+        ecritDataArrayXML(jeuDonnees, fileStream, FLOAT);
       }
       else { fileStream << "\"/>" << endl; }
     }
@@ -407,26 +655,22 @@ void OutputXML::ecritDonneesPhysiquesXML(Mesh *mesh, vector<Cell *> *cellsLvl, s
     //Ecriture des variables scalars du mixture
     for (int var = 1; var <= m_cellRef.getMixture()->getNumberScalars(); var++)
     {
+      if (!imprimeChamp(m_cellRef.getMixture()->returnNameScalar(var))) continue;
       fileStream << "        <" << prefix << "DataArray type=\"Float32\" Name=\"" << m_cellRef.getMixture()->returnNameScalar(var) << "\"";
       if (!parallel) {
-        fileStream << " format=\"" << format << "\">" << endl;
-        mesh->recupereDonnees(cellsLvl, jeuDonnees, var, mixture, lvl);
-        this->ecritJeuDonnees(jeuDonnees, fileStream, FLOAT);
-        fileStream << endl;
-        fileStream << "        </" << prefix << "DataArray>" << endl;
+        if (m_modeEcriture != RELECTURE_TAMPON) mesh->recupereDonnees(cellsLvl, jeuDonnees, var, mixture, lvl);
+        ecritDataArrayXML(jeuDonnees, fileStream, FLOAT);
       }
       else { fileStream << "\"/>" << endl; }
     }
     //Ecriture des variables vectorielles du mixture
     for (int var = 1; var <= m_cellRef.getMixture()->getNumberVectors(); var++)
     {
+      if (!imprimeChamp(m_cellRef.getMixture()->returnNameVector(var))) continue;
       fileStream << "        <" << prefix << "DataArray type=\"Float32\" Name=\"" << m_cellRef.getMixture()->returnNameVector(var) << "\" NumberOfComponents=\"3\"";
       if (!parallel) {
-        fileStream << " format=\"" << format << "\">" << endl;
-        mesh->recupereDonnees(cellsLvl, jeuDonnees, -var, mixture, lvl);
-        this->ecritJeuDonnees(jeuDonnees, fileStream, FLOAT);
-        fileStream << endl;
-        fileStream << "        </" << prefix << "DataArray>" << endl;
+        if (m_modeEcriture != RELECTURE_TAMPON) mesh->recupereDonnees(cellsLvl, jeuDonnees, -var, mixture, lvl);
+        ecritDataArrayXML(jeuDonnees, fileStream, FLOAT);
       }
       else { fileStream << "\"/>" << endl; }
     }
@@ -437,55 +681,46 @@ void OutputXML::ecritDonneesPhysiquesXML(Mesh *mesh, vector<Cell *> *cellsLvl, s
   int transport = -2;
   for (int var = 1; var <= m_run->m_numberTransports; var++)
   {
+    if (!imprimeChamp("T" + IO::toString(var))) continue;
     fileStream << "        <" << prefix << "DataArray type=\"Float32\" Name=\"T" << var << "\"";
     if (!parallel) {
-      fileStream << " format=\"" << format << "\">" << endl;
-      mesh->recupereDonnees(cellsLvl, jeuDonnees, var, transport, lvl);
-      this->ecritJeuDonnees(jeuDonnees, fileStream, FLOAT);
-      fileStream << endl;
-      fileStream << "        </" << prefix << "DataArray>" << endl;
+      if (m_modeEcriture != RELECTURE_TAMPON) mesh->recupereDonnees(cellsLvl, jeuDonnees, var, transport, lvl);
+      ecritDataArrayXML(jeuDonnees, fileStream, FLOAT);
     }
     else { fileStream << "\"/>" << endl; }
   }
 
   //4) Ecriture indicateur xi
   //-------------------------
-  if (mesh->getType() == AMR) {
+  if (typeMeshXML(mesh) == AMR && imprimeChamp("Xi")) {
     int xi = -3;
     fileStream << "        <" << prefix << "DataArray type=\"Float32\" Name=\"Xi\"";
     if (!parallel) {
-      fileStream << " format=\"" << format << "\">" << endl;
-      mesh->recupereDonnees(cellsLvl, jeuDonnees, 1, xi, lvl);
-      this->ecritJeuDonnees(jeuDonnees, fileStream, FLOAT);
-      fileStream << endl;
-      fileStream << "        </" << prefix << "DataArray>" << endl;
+      if (m_modeEcriture != RELECTURE_TAMPON) mesh->recupereDonnees(cellsLvl, jeuDonnees, 1, xi, lvl);
+      ecritDataArrayXML(jeuDonnees, fileStream, FLOAT);
     }
     else { fileStream << "\"/>" << endl; }
   }
 
   //5) Ecriture gradient rho
   //------------------------
-  int gradRho = -4;
-  fileStream << "        <" << prefix << "DataArray type=\"Float32\" Name=\"gradRho\"";
-  if (!parallel) {
-    fileStream << " format=\"" << format << "\">" << endl;
-    mesh->recupereDonnees(cellsLvl, jeuDonnees, 1, gradRho, lvl);
-    this->ecritJeuDonnees(jeuDonnees, fileStream, FLOAT);
-    fileStream << endl;
-    fileStream << "        </" << prefix << "DataArray>" << endl;
+  if (imprimeChamp("gradRho")) {
+    int gradRho = -4;
+    fileStream << "        <" << prefix << "DataArray type=\"Float32\" Name=\"gradRho\"";
+    if (!parallel) {
+      if (m_modeEcriture != RELECTURE_TAMPON) mesh->recupereDonnees(cellsLvl, jeuDonnees, 1, gradRho, lvl);
+      ecritDataArrayXML(jeuDonnees, fileStream, FLOAT);
+    }
+    else { fileStream << "\"/>" << endl; }
   }
-  else { fileStream << "\"/>" << endl; }
 
   //6) Absolute velocity printing for Moving Reference Frame computations
   //---------------------------------------------------------------------
-  if (m_run->m_MRF!=-1) {
+  if (m_run->m_MRF!=-1 && imprimeChamp("absoluteVelocityMRF")) {
     fileStream << "        <" << prefix << "DataArray type=\"Float32\" Name=\"absoluteVelocityMRF\" NumberOfComponents=\"3\"";
     if (!parallel) {
-      fileStream << " format=\"" << format << "\">" << endl;
-      mesh->extractAbsVeloxityMRF(cellsLvl, jeuDonnees, m_run->m_sources[m_run->m_MRF], lvl);
-      this->ecritJeuDonnees(jeuDonnees, fileStream, FLOAT);
-      fileStream << endl;
-      fileStream << "        </" << prefix << "DataArray>" << endl;
+      if (m_modeEcriture != RELECTURE_TAMPON) mesh->extractAbsVeloxityMRF(cellsLvl, jeuDonnees, m_run->m_sources[m_run->m_MRF], lvl);
+      ecritDataArrayXML(jeuDonnees, fileStream, FLOAT);
     }
     else { fileStream << "\"/>" << endl; }
   }
@@ -496,7 +731,7 @@ void OutputXML::ecritDonneesPhysiquesXML(Mesh *mesh, vector<Cell *> *cellsLvl, s
 
 //***********************************************************************
 
-void OutputXML::ecritMeshRectilinearXML(Mesh *mesh, vector<Cell *> *cellsLvl, std::ofstream &fileStream, bool parallel)
+void OutputXML::ecritMeshRectilinearXML(Mesh *mesh, vector<Cell *> *cellsLvl, std::ostream &fileStream, bool parallel, bool entete)
 {
   vector<double> jeuDonnees;
 
@@ -506,62 +741,57 @@ void OutputXML::ecritMeshRectilinearXML(Mesh *mesh, vector<Cell *> *cellsLvl, st
   
   //0) Header
   //---------
-  fileStream << "<VTKFile type=\"" << prefix << "RectilinearGrid\" version=\"0.1\" byte_order=\"";
-  if (!m_ecritBinaire) fileStream << "LittleEndian\">" << endl;
-  else fileStream << m_endianMode.c_str() << "\">" << endl;
+  if (entete) {
+    fileStream << "<VTKFile type=\"" << prefix << "RectilinearGrid\" version=\"0.1\" byte_order=\"";
+    if (!m_ecritBinaire) fileStream << "LittleEndian\">" << endl;
+    else {
+      fileStream << m_endianMode.c_str() << "\"";
+      if (m_compression > 0) fileStream << " compressor=\"vtkZLibDataCompressor\"";
+      fileStream << ">" << endl;
+    }
+  }
   if (!parallel) {
-    fileStream << "  <RectilinearGrid WholeExtent=\"" << mesh->recupereChaineExtent(rankCpu) << "\">" << endl;
-    fileStream << "    <Piece Extent=\"" << mesh->recupereChaineExtent(rankCpu) << "\">" << endl;
+    //Whole extent of the complete domain if all CPUs print in the same file
+    if (entete) fileStream << "  <RectilinearGrid WholeExtent=\"" << chaineExtentXML(mesh, m_fichierUnique) << "\">" << endl;
+    fileStream << "    <Piece Extent=\"" << chaineExtentXML(mesh) << "\">" << endl;
   }
   else {
-    fileStream << "  <PRectilinearGrid WholeExtent = \"" << mesh->recupereChaineExtent(rankCpu, true) << "\" GhostLevel=\"0\">" << endl;
+    fileStream << "  <PRectilinearGrid WholeExtent = \"" << chaineExtentXML(mesh, true) << "\" GhostLevel=\"0\">" << endl;
   }
   
   //1) Ecriture des Coordonnees des noeuds
   //--------------------------------------
   fileStream << "      <" << prefix << "Coordinates>" << endl;
   //Coordonnees en X
-  fileStream << "        <" << prefix << "DataArray type=\"Float32\" ";
+  fileStream << "        <" << prefix << "DataArray type=\"Float32\"";
   if (!parallel) {
-    if (!m_ecritBinaire) { fileStream << "format=\"ascii\">" << endl << "          "; }
-    else { fileStream << "format=\"binary\">" << endl; }
     jeuDonnees.clear();
-    mesh->recupereCoord(cellsLvl, jeuDonnees, X);
-    ecritJeuDonnees(jeuDonnees, fileStream, FLOAT);
-    fileStream << endl;
-    fileStream << "        </" << prefix << "DataArray>" << endl;
+    if (m_modeEcriture != RELECTURE_TAMPON) mesh->recupereCoord(cellsLvl, jeuDonnees, X);
+    ecritDataArrayXML(jeuDonnees, fileStream, FLOAT, true);
   }
-  else { fileStream << "/>" << endl; }
+  else { fileStream << " />" << endl; }
   //Coordonnees en Y
-  fileStream << "        <" << prefix << "DataArray type=\"Float32\" ";
+  fileStream << "        <" << prefix << "DataArray type=\"Float32\"";
   if (!parallel) {
-    if (!m_ecritBinaire) { fileStream << "format=\"ascii\">" << endl << "          "; }
-    else { fileStream << "format=\"binary\">" << endl; }
     jeuDonnees.clear();
-    mesh->recupereCoord(cellsLvl, jeuDonnees, Y);
-    ecritJeuDonnees(jeuDonnees, fileStream, FLOAT);
-    fileStream << endl;
-    fileStream << "        </" << prefix << "DataArray>" << endl;
+    if (m_modeEcriture != RELECTURE_TAMPON) mesh->recupereCoord(cellsLvl, jeuDonnees, Y);
+    ecritDataArrayXML(jeuDonnees, fileStream, FLOAT, true);
   }
-  else { fileStream << "/>" << endl; }
+  else { fileStream << " />" << endl; }
   //Coordonnees en Z
-  fileStream << "        <" << prefix << "DataArray type=\"Float32\" ";
+  fileStream << "        <" << prefix << "DataArray type=\"Float32\"";
   if (!parallel) {
-    if (!m_ecritBinaire) { fileStream << "format=\"ascii\">" << endl << "          "; }
-    else { fileStream << "format=\"binary\">" << endl; }
     jeuDonnees.clear();
-    mesh->recupereCoord(cellsLvl, jeuDonnees, Z);
-    ecritJeuDonnees(jeuDonnees, fileStream, FLOAT);
-    fileStream << endl;
-    fileStream << "        </" << prefix << "DataArray>" << endl;
+    if (m_modeEcriture != RELECTURE_TAMPON) mesh->recupereCoord(cellsLvl, jeuDonnees, Z);
+    ecritDataArrayXML(jeuDonnees, fileStream, FLOAT, true);
   }
-  else { fileStream << "/>" << endl; }
+  else { fileStream << " />" << endl; }
   fileStream << "      </" << prefix << "Coordinates>" << endl;
 }
 
 //***********************************************************************
 
-void OutputXML::ecritMeshUnstructuredXML(Mesh *mesh, vector<Cell *> *cellsLvl, std::ofstream &fileStream, const int &lvl, bool parallel)
+void OutputXML::ecritMeshUnstructuredXML(Mesh *mesh, vector<Cell *> *cellsLvl, std::ostream &fileStream, const int &lvl, bool parallel, bool entete)
 {
   vector<double> jeuDonnees;
 
@@ -571,79 +801,69 @@ void OutputXML::ecritMeshUnstructuredXML(Mesh *mesh, vector<Cell *> *cellsLvl, s
 
   //0) Header
   //---------
-  fileStream << "<VTKFile type=\"" << prefix << "UnstructuredGrid\" version=\"0.1\" byte_order=\"";
-  if (!m_ecritBinaire) fileStream << "LittleEndian\">" << endl;
-  else fileStream << m_endianMode.c_str() << "\">" << endl;
+  if (entete) {
+    fileStream << "<VTKFile type=\"" << prefix << "UnstructuredGrid\" version=\"0.1\" byte_order=\"";
+    if (!m_ecritBinaire) fileStream << "LittleEndian\">" << endl;
+    else {
+      fileStream << m_endianMode.c_str() << "\"";
+      if (m_compression > 0) fileStream << " compressor=\"vtkZLibDataCompressor\"";
+      fileStream << ">" << endl;
+    }
+  }
 
   if (parallel) {
     fileStream << "  <PUnstructuredGrid GhostLevel=\"0\">" << endl;
   }
   else {
-    fileStream << "  <UnstructuredGrid>" << endl;
-    mesh->ecritHeaderPiece(fileStream, cellsLvl, lvl);
+    if (entete) fileStream << "  <UnstructuredGrid>" << endl;
+    ecritHeaderPieceXML(mesh, cellsLvl, fileStream, lvl);
   }
   
   //1) Ecriture des Noeuds
   //----------------------
   fileStream << "      <" << prefix << "Points>" << endl;
-  fileStream << "        <" << prefix << "DataArray type=\"Float32\" NumberOfComponents=\"3\" ";
+  fileStream << "        <" << prefix << "DataArray type=\"Float32\" NumberOfComponents=\"3\"";
   if (!parallel) {
-    if (!m_ecritBinaire) { fileStream << "format=\"ascii\">" << endl << "          "; }
-    else { fileStream << "format=\"binary\">" << endl; }
     jeuDonnees.clear();
-    mesh->recupereNoeuds(jeuDonnees, lvl);
-    ecritJeuDonnees(jeuDonnees, fileStream, FLOAT);
-    fileStream << endl;
-    fileStream << "        </" << prefix << "DataArray>" << endl;
+    if (m_modeEcriture != RELECTURE_TAMPON) mesh->recupereNoeuds(jeuDonnees, lvl);
+    ecritDataArrayXML(jeuDonnees, fileStream, FLOAT, true);
   }
-  else { fileStream << "/>" << endl; }
+  else { fileStream << " />" << endl; }
   fileStream << "      </" << prefix << "Points>" << endl;
 
   //2) Ecriture des Cells
   //------------------------
   fileStream << "      <" << prefix << "Cells>" << endl;
   //Connectivite
-  fileStream << "        <" << prefix << "DataArray type=\"Int32\" Name=\"connectivity\" ";
+  fileStream << "        <" << prefix << "DataArray type=\"Int32\" Name=\"connectivity\"";
   if (!parallel) {
-    if (!m_ecritBinaire) { fileStream << "format=\"ascii\">" << endl << "          "; }
-    else { fileStream << "format=\"binary\">" << endl; }
     jeuDonnees.clear();
-    mesh->recupereConnectivite(jeuDonnees, lvl);
-    ecritJeuDonnees(jeuDonnees, fileStream, INT);
-    fileStream << endl;
-    fileStream << "        </" << prefix << "DataArray>" << endl;
+    if (m_modeEcriture != RELECTURE_TAMPON) mesh->recupereConnectivite(jeuDonnees, lvl);
+    ecritDataArrayXML(jeuDonnees, fileStream, INT, true);
   }
-  else { fileStream << "/>" << endl; }
+  else { fileStream << " />" << endl; }
   //Offsets
-  fileStream << "        <" << prefix << "DataArray type=\"Int32\" Name=\"offsets\" ";
+  fileStream << "        <" << prefix << "DataArray type=\"Int32\" Name=\"offsets\"";
   if (!parallel) {
-    if (!m_ecritBinaire) { fileStream << "format=\"ascii\">" << endl << "          "; }
-    else { fileStream << "format=\"binary\">" << endl; }
     jeuDonnees.clear();
-    mesh->recupereOffsets(jeuDonnees, lvl);
-    ecritJeuDonnees(jeuDonnees, fileStream, INT);
-    fileStream << endl;
-    fileStream << "        </" << prefix << "DataArray>" << endl;
+    if (m_modeEcriture != RELECTURE_TAMPON) mesh->recupereOffsets(jeuDonnees, lvl);
+    ecritDataArrayXML(jeuDonnees, fileStream, INT, true);
   }
-  else { fileStream << "/>" << endl; }
+  else { fileStream << " />" << endl; }
   //Type de cells
-  fileStream << "        <" << prefix << "DataArray type=\"UInt8\" Name=\"types\" ";
+  fileStream << "        <" << prefix << "DataArray type=\"UInt8\" Name=\"types\"";
   if (!parallel) {
-    if (!m_ecritBinaire) { fileStream << "format=\"ascii\">" << endl << "          "; }
-    else { fileStream << "format=\"binary\">" << endl; }
     jeuDonnees.clear();
-    mesh->recupereTypeCell(jeuDonnees, lvl);
-    ecritJeuDonnees(jeuDonnees, fileStream, CHAR);
-    fileStream << endl;
-    fileStream << "        </" << prefix << "DataArray>" << endl;
+    if (m_modeEcriture != RELECTURE_TAMPON) mesh->recupereTypeCell(jeuDonnees, lvl);
+    ecritDataArrayXML(jeuDonnees, fileStream, CHAR, true);
   }
-  else { fileStream << "/>" << endl; }
+  else { fileStream << " />" << endl; }
   fileStream << "      </" << prefix << "Cells>" << endl;
 }
 
 //***********************************************************************
 
-void OutputXML::ecritMeshPolyDataXML(Mesh *mesh, vector<Cell *> *cellsLvl, std::ofstream &fileStream, const int &lvl, bool parallel)
+void OutputXML::ecritMeshPolyDataXML(Mesh *mesh, vector<Cell *> *cellsLvl, std::ostream &fileStream, const int &lvl, bool parallel)
 {
   vector<double> jeuDonnees;
 
@@ -655,7 +875,11 @@ void OutputXML::ecritMeshPolyDataXML(Mesh *mesh, vector<Cell *> *cellsLvl, std::
   //---------
   fileStream << "<VTKFile type=\"" << prefix << "PolyData\" version=\"0.1\" byte_order=\"";
   if (!m_ecritBinaire) fileStream << "LittleEndian\">" << endl;
-  else fileStream << m_endianMode.c_str() << "\">" << endl;
+  else {
+    fileStream << m_endianMode.c_str() << "\"";
+    if (m_compression > 0) fileStream << " compressor=\"vtkZLibDataCompressor\"";
+    fileStream << ">" << endl;
+  }
 
   if (parallel) {
     fileStream << "  <PPolyData GhostLevel=\"0\">" << endl;
@@ -713,33 +937,37 @@ void OutputXML::ecritMeshPolyDataXML(Mesh *mesh, vector<Cell *> *cellsLvl, std::
 
 //***********************************************************************
 
-void OutputXML::ecritFinFichierRectilinearXML(std::ofstream &fileStream, bool parallel)
+void OutputXML::ecritFinFichierRectilinearXML(std::ostream &fileStream, bool parallel, bool finFichier)
 {
   string prefix;
   if (parallel) { prefix = "P"; }
   else { prefix = ""; }
 
   if (!parallel) fileStream << "    </Piece>" << endl;
+  if (!finFichier) return;
   fileStream << "  </" << prefix << "RectilinearGrid>" << endl;
+  if (m_donneesAjoutees && !parallel) ecritDonneesAjouteesXML(fileStream);
   fileStream << "</VTKFile>" << endl;
 }
 
 //***********************************************************************
 
-void OutputXML::ecritFinFichierUnstructuredXML(std::ofstream &fileStream, bool parallel)
+void OutputXML::ecritFinFichierUnstructuredXML(std::ostream &fileStream, bool parallel, bool finFichier)
 {
   string prefix;
   if (parallel) { prefix = "P"; }
   else { prefix = ""; }
 
   if (!parallel) fileStream << "    </Piece>" << endl;
+  if (!finFichier) return;
   fileStream << "  </" << prefix << "UnstructuredGrid>" << endl;
+  if (m_donneesAjoutees && !parallel) ecritDonneesAjouteesXML(fileStream);
   fileStream << "</VTKFile>" << endl;
 }
 
 //***********************************************************************
 
-void OutputXML::ecritFinFichierPolyDataXML(std::ofstream &fileStream, bool parallel)
+void OutputXML::ecritFinFichierPolyDataXML(std::ostream &fileStream, bool parallel)
 {
   string prefix;
   if (parallel) { prefix = "P"; }
@@ -752,6 +980,38 @@ void OutputXML::ecritFinFichierPolyDataXML(std::ofstream &fileStream, bool paral
 
 //***********************************************************************
 
+void OutputXML::ecritFichierUniqueMPI(const string &file, const string &bloc) const
+{
+  //Offset of the current CPU block = sum of the block sizes of the previous CPUs
+  MPI_Offset tailleBloc(static_cast<MPI_Offset>(bloc.size())), offset(0), tailleTotale(0);
+  MPI_Exscan(&tailleBloc, &offset, 1, MPI_OFFSET, MPI_SUM, commCompute);
+  if (rankCpu == 0) offset = 0; //Undefined on CPU 0 after MPI_Exscan
+  MPI_Allreduce(&tailleBloc, &tailleTotale, 1, MPI_OFFSET, MPI_SUM, commCompute);
+
+  MPI_File fichier;
+  MPI_Status status;
+  if (MPI_File_open(commCompute, const_cast<char*>(file.c_str()), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fichier) != MPI_SUCCESS) {
+    throw ErrorECOGEN("Impossible d ouvrir le file " + file, __FILE__, __LINE__);
+  }
+  //Truncation of a previous file with the same name (resumed simulation)
+  MPI_File_set_size(fichier, tailleTotale);
+  //The count of MPI_File_write_at_all is an int: blocks above 2 GB are printed in chunks, every CPU takes part in each collective call
+  const MPI_Offset tailleMorceau(1 << 30);
+  long long numberMorceaux((tailleBloc + tailleMorceau - 1) / tailleMorceau), numberMorceauxMax(0);
+  MPI_Allreduce(&numberMorceaux, &numberMorceauxMax, 1, MPI_LONG_LONG, MPI_MAX, commCompute);
+  int erreur(MPI_SUCCESS);
+  for (long long m = 0; m < numberMorceauxMax; m++) {
+    MPI_Offset debut(min(m*tailleMorceau, tailleBloc));
+    int taille(static_cast<int>(min(tailleMorceau, tailleBloc - debut)));
+    int erreurMorceau = MPI_File_write_at_all(fichier, offset + debut, const_cast<char*>(bloc.data()) + debut, taille, MPI_CHAR, &status);
+    if (erreurMorceau != MPI_SUCCESS) erreur = erreurMorceau;
+  }
+  MPI_File_close(&fichier);
+  if (erreur != MPI_SUCCESS) { throw ErrorECOGEN("Ecriture MPI-IO impossible dans le file " + file, __FILE__, __LINE__); }
+}
+
+//***********************************************************************
+
 //Old
 
 //***********************************************************************
@@ -35,8 +35,14 @@
 //! \version   1.0
 //! \date      July 20 2018
 
+#include <deque>
+#include <thread>
+#include <exception>
 #include "Output.h"
 
+//! \brief     Printing mode of the XML writers: direct, staging of the data sets only (solver thread), or replay of the staged data sets (writer thread)
+typedef enum ModeEcritureXML { ECRITURE_DIRECTE, MISE_EN_TAMPON, RELECTURE_TAMPON } ModeEcritureXML;
+
 class OutputXML :  public Output
 {
 public:
@@ -46,6 +52,8 @@ public:
 
   virtual void prepareSortieSpecifique();
   virtual void ecritSolution(Mesh *mesh, std::vector<Cell *> *cellsLvl);
+  virtual void attendEcritureSolution();
+  virtual long long getMemoryStaging() const { return Output::getMemoryStaging() + m_octetsTampon + m_octetsAjoutes; };
 
   virtual void readResults(Mesh *mesh, std::vector<Cell *> *cellsLvl, const int fileNumber);
 
@@ -55,17 +63,60 @@ protected:
 
   std::string creationNameFichierXML(const char* name, Mesh *mesh=0, int lvl=-1, int proc=-1, int numFichier=-1, std::string nameVariable ="defaut");
 
-  void ecritSolutionXML(Mesh *mesh, std::vector<Cell *> *cellsLvl);
-  void ecritCollectionXML(Mesh *mesh);
-  void ecritDonneesPhysiquesXML(Mesh *mesh, std::vector<Cell *> *cellsLvl, std::ofstream &fileStream, const int &lvl, bool parallel = false);
+  void ecritSolutionXML(Mesh *mesh, std::vector<Cell *> *cellsLvl, int numFichier);
+  void ecritCollectionXML(Mesh *mesh, int numFichier);
+  //! \brief     Writer thread: formatting and printing of the staged snapshot
+  //! \details   The mesh pointer only tells result files from the collection file apart, the mesh is never dereferenced
+  void ecritInstantaneDiffere(Mesh *mesh, int numFichier);
+  //! \brief     Data set printing according to the printing mode (see ModeEcritureXML)
+  //! \details   If the data set is replayed, it has been staged and no mesh access is made by the caller
+  void ecritJeuDonneesXML(std::vector<double> &jeuDonnees, std::ostream &fileStream, TypeData typeData);
+  void ecritHeaderPieceXML(Mesh *mesh, std::vector<Cell *> *cellsLvl, std::ostream &fileStream, const int &lvl);
+  //! \brief     Mesh type, number of AMR levels and extents of the snapshot: read from the mesh, or from the staging buffer when replayed
+  TypeM typeMeshXML(Mesh *mesh) const;
+  int lvlMaxXML(Mesh *mesh) const;
+  std::string chaineExtentXML(Mesh *mesh, bool global = false);
+  //! \brief     End of the opening tag of a DataArray and its data (inline) or its offset in the appended data
+  //! \param     indentation       indentation of ASCII data
+  void ecritDataArrayXML(std::vector<double> &jeuDonnees, std::ostream &fileStream, TypeData typeData, bool indentation = false);
+  //! \brief     Registration of a data set in the appended data of the current file and update of the next offset
+  void ajouteJeuDonneesXML(std::vector<double> &jeuDonnees, TypeData typeData);
+  //! \brief     AppendedData element: the "_" marker, then the size and the raw bytes of each array printed from its buffer
+  void ecritDonneesAjouteesXML(std::ostream &fileStream);
+  void ecritDonneesPhysiquesXML(Mesh *mesh, std::vector<Cell *> *cellsLvl, std::ostream &fileStream, const int &lvl, bool parallel = false);
 
   //Dependant du type de mesh
-  void ecritMeshRectilinearXML(Mesh *mesh, std::vector<Cell *> *cellsLvl, std::ofstream &fileStream, bool parallel = false);
-  void ecritMeshUnstructuredXML(Mesh *mesh, std::vector<Cell *> *cellsLvl, std::ofstream &fileStream, const int &lvl, bool parallel = false);
-  void ecritMeshPolyDataXML(Mesh *mesh, std::vector<Cell *> *cellsLvl, std::ofstream &fileStream, const int &lvl, bool parallel = false);
-  void ecritFinFichierRectilinearXML(std::ofstream &fileStream, bool parallel = false);
-  void ecritFinFichierUnstructuredXML(std::ofstream &fileStream, bool parallel = false);
-  void ecritFinFichierPolyDataXML(std::ofstream &fileStream, bool parallel = false);
+  //Avec entete = false (resp. finFichier = false), seul le bloc <Piece> est ecrit (sortie dans un file unique)
+  void ecritMeshRectilinearXML(Mesh *mesh, std::vector<Cell *> *cellsLvl, std::ostream &fileStream, bool parallel = false, bool entete = true);
+  void ecritMeshUnstructuredXML(Mesh *mesh, std::vector<Cell *> *cellsLvl, std::ostream &fileStream, const int &lvl, bool parallel = false, bool entete = true);
+  void ecritMeshPolyDataXML(Mesh *mesh, std::vector<Cell *> *cellsLvl, std::ostream &fileStream, const int &lvl, bool parallel = false);
+  void ecritFinFichierRectilinearXML(std::ostream &fileStream, bool parallel = false, bool finFichier = true);
+  void ecritFinFichierUnstructuredXML(std::ostream &fileStream, bool parallel = false, bool finFichier = true);
+  void ecritFinFichierPolyDataXML(std::ostream &fileStream, bool parallel = false);
+
+  //! \brief     Collective MPI-IO print of the block of each CPU into a single file at offsets given by the ranks order
+  //! \param     file            path of the shared file
+  //! \param     bloc            formatted data of the current CPU (header included on CPU 0, footer on the last CPU)
+  void ecritFichierUniqueMPI(const std::string &file, const std::string &bloc) const;
+
+  bool m_fichierUnique;   //!<All CPUs print in one single file per snapshot and AMR level (collective MPI-IO)
+  //Appended data of the current file, printed in the AppendedData element at the end of the file
+  long long m_offsetAjoute;                            //!<Offset of the next appended array
+  std::deque<std::vector<double> > m_jeuxAjoutes;      //!<Data sets of the appended arrays (no compression), printed from these buffers
+  std::deque<TypeData> m_typesAjoutes;                 //!<Data types of the appended arrays (no compression)
+  std::deque<std::vector<char> > m_blocsCompresses;    //!<Compressed appended arrays, kept compressed since their size gives the offsets
+  std::atomic<long long> m_octetsAjoutes;              //!<Bytes held by the appended arrays not printed yet
+
+  //Asynchronous printing
+  bool m_asynchrone;                                   //!<Snapshot printed by a background writer thread
+  ModeEcritureXML m_modeEcriture;                      //!<Current printing mode of the writers
+  std::deque<std::vector<double> > m_tamponJeux;       //!<Staged data sets of the snapshot, in printing order
+  std::deque<std::string> m_tamponChaines;             //!<Staged mesh dependent headers and extents of the snapshot, in printing order
+  TypeM m_typeMeshTampon;                              //!<Mesh type of the staged snapshot
+  int m_lvlMaxTampon;                                  //!<Maximum AMR level of the staged snapshot
+  std::thread m_ecrivain;                              //!<Writer thread of the previous snapshot
+  std::exception_ptr m_erreurEcrivain;                 //!<Exception thrown in the writer thread, rethrown by the solver thread
+  std::atomic<long long> m_octetsTampon;               //!<Bytes staged and not printed yet by the writer thread
 
   //Non utilise
   void ecritFichierParallelXML(Mesh *mesh, std::vector<Cell *> *cellsLvl);
@@ -76,10 +76,10 @@ int Mesh::getNumFichier() const
 
 //***********************************************************************
 
-void Mesh::ecritSolutionGnuplot(std::vector<Cell *> *cellsLvl, std::ofstream &fileStream, GeometricObject *objet) const
+void Mesh::ecritSolutionGnuplot(std::vector<Cell *> *cellsLvl, std::ofstream &fileStream, GeometricObject *objet, const std::vector<bool> *masqueChamps) const
 {
   for (unsigned int c = 0; c < cellsLvl[0].size(); c++) {
-    if (cellsLvl[0][c]->printGnuplotAMR(fileStream, m_geometrie, objet)) break;
+    if (cellsLvl[0][c]->printGnuplotAMR(fileStream, m_geometrie, objet, masqueChamps)) break;
   }
 }
 
@@ -72,6 +72,8 @@ public:
   int getGeometrie() const { return m_geometrie; };
   int getNumberCells() const;
   int getNumberCellsTotal() const;
+  //! \brief     Number of ghost cells of this CPU (all AMR levels)
+  virtual int getNumberCellsGhost() const { return m_numberCellsTotal - m_numberCellsCalcul; };
   int getNumberFaces() const;
   int getNumFichier() const;
   virtual double getdX() const { return 0; };
@@ -79,11 +81,18 @@ public:
   virtual double getdZ() const { return 0; };
   TypeM getType() const { return m_type; };
   virtual int getLvlMax() const { return 0; };
+  //! \brief     Direct location of the local level-0 cell containing a point
+  //! \param     point            coordinates of the point
+  //! \param     index            index of the local cell containing the point, -1 if the point is not in the local mesh
+  //! \return    false if the mesh has no spatial index (search over cells left to the caller)
+  virtual bool locateCell(const Coord &, int &index) const { index = -1; return false; };
+  //! \brief     Allow or forbid the refinement of the AMR tree (unrefinement remains allowed)
+  virtual void setRefinementAllowed(const bool &/*allowed*/) {};
 
   //Printing
   //--------
-  void ecritSolutionGnuplot(std::vector<Cell *> *cellsLvl, std::ofstream &fileStream, GeometricObject *objet = 0) const;
-  virtual void ecritHeaderPiece(std::ofstream &fileStream, std::vector<Cell *> *cellsLvl, int lvl = 0) const { Errors::errorMessage("ecritHeaderPiece non prevu pour mesh considere"); };
+  void ecritSolutionGnuplot(std::vector<Cell *> *cellsLvl, std::ofstream &fileStream, GeometricObject *objet = 0, const std::vector<bool> *masqueChamps = 0) const;
+  virtual void ecritHeaderPiece(std::ostream &fileStream, std::vector<Cell *> *cellsLvl, int lvl = 0) const { Errors::errorMessage("ecritHeaderPiece non prevu pour mesh considere"); };
   virtual std::string recupereChaineExtent(int localRank, bool global = false) const { Errors::errorMessage("recupereChaineExtent non prevu pour mesh considere"); return 0; };
   virtual void recupereCoord(std::vector<Cell *> *cellsLvl, std::vector<double> &jeuDonnees, Axe axe) const { Errors::errorMessage("recupereCoord non prevu pour mesh considere"); };
   virtual void recupereNoeuds(std::vector<double> &jeuDonnees, int lvl = 0) const { Errors::errorMessage("recupereNoeuds non prevu pour mesh considere"); };
@@ -133,6 +142,17 @@ public:
 	virtual void communicationsAddPhys(const std::vector<AddPhys*> &addPhys, Cell **cells, const int &lvl);
   virtual void communicationsTransports(Cell **cells, const int &lvl);
 	virtual void finalizeParallele(const int &lvlMax);
+  //! \brief     Printing of the load balance between CPUs (AMR only)
+  //! \param     numTest          number of the test case, for the printing prefix
+  virtual void printLoadBalance(const int &/*numTest*/) const {}
+  //! \brief     Repartition of the level-0 cells between CPUs along a space-filling curve, weighted by their AMR subtree (AMR only)
+  //! \details   Cells, their trees and the ghost cells migrate between CPUs and the persistent communications are rebuilt.
+  //!            Arrays of cells and boundaries are reallocated.
+  //! \param     threshold        imbalance of the CPU loads (max/avg) above which the cells are moved
+  //! \return    true if the cells have been moved
+  virtual bool repartitionCells(Cell ***/*cells*/, CellInterface ***/*bord*/, std::vector<Cell *> **/*cellsLvl*/, std::vector<CellInterface *> **/*boundariesLvl*/,
+    const std::vector<AddPhys*> &/*addPhys*/, Model */*model*/, Eos **/*eos*/, int &/*nbCellsTotalAMR*/, const double &/*threshold*/, std::string /*ordreCalcul*/,
+    const int &/*numTest*/) { return false; }
   
 protected:
   mutable int m_numFichier;
@@ -161,6 +161,40 @@ void MeshCartesian::construitIGlobal(const int &i, const int &j, const int &k, i
 
 //***********************************************************************
 
+bool MeshCartesian::locateCell(const Coord &point, int &index) const
+{
+  index = -1;
+  //Global indexes (a direction with a single cell is ignored as in construitIGlobal)
+  int i(0), j(0), k(0);
+  if (m_numberCellsXGlobal != 1) i = locateIndexAxis(point.getX(), m_posXi, m_dXi);
+  if (m_numberCellsYGlobal != 1) j = locateIndexAxis(point.getY(), m_posYj, m_dYj);
+  if (m_numberCellsZGlobal != 1) k = locateIndexAxis(point.getZ(), m_posZk, m_dZk);
+  if (i < 0 || j < 0 || k < 0) return true;
+  //Local indexes
+  i -= m_offsetX; j -= m_offsetY; k -= m_offsetZ;
+  if (i < 0 || i >= m_numberCellsX || j < 0 || j >= m_numberCellsY || k < 0 || k >= m_numberCellsZ) return true;
+  construitIGlobal(i, j, k, index);
+  return true;
+}
+
+//***********************************************************************
+
+int MeshCartesian::locateIndexAxis(const double &x, const vector<double> &pos, const vector<double> &d) const
+{
+  int size(pos.size());
+  if (x < pos[0] - 0.5*d[0] || x > pos[size - 1] + 0.5*d[size - 1]) return -1;
+  //First cell whose upper face is beyond x (the upper face of the domain belongs to the last cell)
+  int debut(0), fin(size - 1);
+  while (debut < fin) {
+    int milieu((debut + fin) / 2);
+    if (x < pos[milieu] + 0.5*d[milieu]) fin = milieu;
+    else debut = milieu + 1;
+  }
+  return debut;
+}
+
+//***********************************************************************
+
 int MeshCartesian::initializeGeometrie(Cell ***cells, CellInterface ***bord, bool pretraitementParallele, string ordreCalcul)
 {
   this->meshStretching();
@@ -592,9 +626,9 @@ void MeshCartesian::initializeGeometrieParallele(Cell ***cells, CellInterface **
 
     //CFL lenght
     double lCFL(1.e10);
-    if (m_numberCellsX != 1) { lCFL = min(lCFL, m_dXi[ix]); }
-    if (m_numberCellsY != 1) { lCFL = min(lCFL, m_dYj[iy]); }
-    if (m_numberCellsZ != 1) { lCFL = min(lCFL, m_dZk[iz]); }
+    if (m_numberCellsX != 1) { lCFL = min(lCFL, m_dXi[m_offsetX + ix]); }
+    if (m_numberCellsY != 1) { lCFL = min(lCFL, m_dYj[m_offsetY + iy]); }
+    if (m_numberCellsZ != 1) { lCFL = min(lCFL, m_dZk[m_offsetZ + iz]); }
     if (m_geometrie > 1) lCFL *= 0.6;
 
     (*cells)[i]->getElement()->setLCFL(lCFL);
@@ -1038,6 +1072,78 @@ void MeshCartesian::initializeGeometrieParallele(Cell ***cells, CellInterface **
 
 //***********************************************************************
 
+void MeshCartesian::choixTopologieCpu()
+{
+  //Mininum # of stencils (5) times order of the method (always considered as second order) gives the minimum number of cells in one direction
+  int minCellNumberOneDirection(2);
+  //Cost of the exchange of one ghost cell relative to the update of one cell
+  double poidsCommunication(2.);
+
+  int numberCells[3] = { m_numberCellsXGlobal, m_numberCellsYGlobal, m_numberCellsZGlobal };
+  int numberCpu[3] = { 1, 1, 1 };
+  double coutMin(1.e300), surfaceMin(1.e300);
+  int error(-1);
+
+  //Evaluation of every factorization of Ncpu on the split directions (z only in 3D)
+  int numberCpuZMax(1);
+  if (m_geometrie == 3) numberCpuZMax = Ncpu;
+  for (int i = 1; i <= Ncpu; i++) {
+    if (Ncpu % i != 0) continue;
+    for (int j = 1; j <= Ncpu / i; j++) {
+      if ((Ncpu / i) % j != 0) continue;
+      int k(Ncpu / (i*j));
+      if (k > numberCpuZMax) continue;
+      int candidat[3] = { i, j, k };
+      bool valide(true);
+      double cellsBloc(1.); //Cells of the largest block (uneven splits give one more cell to the first CPUs)
+      int tailleBloc[3];
+      for (int d = 0; d < 3; d++) {
+        if (candidat[d] > 1 && numberCells[d] / candidat[d] < minCellNumberOneDirection) valide = false;
+        tailleBloc[d] = (numberCells[d] + candidat[d] - 1) / candidat[d];
+        cellsBloc *= tailleBloc[d];
+      }
+      if (!valide) continue;
+      //Ghost cells of the largest block when it is inside the topology, and total surface of the cuts
+      double fantomesBloc(0.), surface(0.);
+      for (int d = 0; d < 3; d++) {
+        if (candidat[d] == 1) continue;
+        double faceBloc(cellsBloc / tailleBloc[d]);
+        fantomesBloc += min(candidat[d] - 1, 2) * faceBloc;
+        surface += (candidat[d] - 1) * static_cast<double>(numberCells[0]) * numberCells[1] * numberCells[2] / numberCells[d];
+      }
+      double coutBloc(cellsBloc + poidsCommunication * fantomesBloc);
+      if (coutBloc < coutMin || (coutBloc == coutMin && surface < surfaceMin)) {
+        coutMin = coutBloc;
+        surfaceMin = surface;
+        for (int d = 0; d < 3; d++) numberCpu[d] = candidat[d];
+        error = 0;
+      }
+    }
+  }
+
+  //Verifying that a valid decomposition of the computational domain has been established. If not, the simulation exits.
+  if (rankCpu == 0 && error == -1) {
+    Errors::errorMessage("Unsupported combination of values of number of CPU, cells in x-, y- and z-directions");
+  }
+  m_numberCpuX = numberCpu[0];
+  m_numberCpuY = numberCpu[1];
+  m_numberCpuZ = numberCpu[2];
+
+  if (rankCpu == 0) {
+    double cellsMoyen(static_cast<double>(m_numberCellsXGlobal) * m_numberCellsYGlobal * m_numberCellsZGlobal / Ncpu);
+    double cellsMin(1.), cellsMax(1.);
+    for (int d = 0; d < 3; d++) {
+      cellsMin *= numberCells[d] / numberCpu[d];
+      cellsMax *= (numberCells[d] + numberCpu[d] - 1) / numberCpu[d];
+    }
+    cout << "Cartesian CPU topology : " << m_numberCpuX << " x " << m_numberCpuY << " x " << m_numberCpuZ
+      << " / cells per CPU : " << cellsMin << " to " << cellsMax << " (max/avg = " << cellsMax / cellsMoyen << ")"
+      << " / cut surface : " << surfaceMin << " faces" << endl;
+  }
+}
+
+//***********************************************************************
+
 void MeshCartesian::decoupageParallele()
 {
   int ix, iy, iz;
@@ -1128,38 +1234,8 @@ void MeshCartesian::decoupageParallele()
     //2D Cartesian Processor Topology
     //-------------------------------
 
-    //Mininum # of stencils (5) times order of the method (always considered as second order) gives the minimum number of cells in one direction
-    int minCellNumberOneDirection(2);
-
-    //Initial estimate of optimal processor topology
-    m_numberCpuX = 1;      //Optimal number of processors in the x-direction
-    m_numberCpuY = Ncpu;   //Optimal number of processors in the y-direction
-    int error(-1);
-
-    //Benchmarking the quality of this initial guess
-    double tempNumberCpuX(static_cast<double>(m_numberCpuX)); //Non-optimal number of processors in the x-direction
-    double tempNumberCpuY(static_cast<double>(m_numberCpuY)); //Non-optimal number of processors in the y-direction
-    double CpuFactorizationMin;                               //Processor factorization (fct) minimization parameter
-    CpuFactorizationMin = 10.*abs(static_cast<double>(m_numberCellsXGlobal) / tempNumberCpuX - static_cast<double>(m_numberCellsYGlobal) / tempNumberCpuY);
-
-    //Optimization of the initial processor topology
-    for (int i = 1; i <= Ncpu; i++) {
-      if ((Ncpu % i == 0) && (m_numberCellsXGlobal / i >= minCellNumberOneDirection)) {
-        tempNumberCpuX = i;
-        tempNumberCpuY = Ncpu / i;
-        if (CpuFactorizationMin >= abs(m_numberCellsXGlobal / tempNumberCpuX -m_numberCellsYGlobal / tempNumberCpuY) && m_numberCellsYGlobal / tempNumberCpuY >= minCellNumberOneDirection) {
-          m_numberCpuX = i;
-          m_numberCpuY = Ncpu / i;
-          CpuFactorizationMin = abs(m_numberCellsXGlobal / tempNumberCpuX - m_numberCellsYGlobal / tempNumberCpuY);
-          error = 0;
-        }
-      }
-    }
-
-    //Verifying that a valid decomposition of the computational domain has been established. If not, the simulation exits.
-    if (rankCpu == 0 && error == -1) {
-      Errors::errorMessage("Unsupported combination of values of number of CPU, cells in x- and y-directions");
-    }
+    //Choice of the processor topology
+    this->choixTopologieCpu();
 
     //Coordinates of the current CPU
     int rest;
@@ -1319,48 +1395,8 @@ void MeshCartesian::decoupageParallele()
     //3D Cartesian Processor Topology
     //-------------------------------
 
-    //Mininum # of stencils (5) times order of the method (always considered as second order) gives the minimum number of cells in one direction
-    int minCellNumberOneDirection(2);
-
-    //Initial estimate of optimal processor topology
-    m_numberCpuX = 1;
-    m_numberCpuY = 1;
-    m_numberCpuZ = Ncpu;
-    int error(-1);
-
-    //Benchmarking the quality of this initial guess
-    double tempNumberCpuX(static_cast<double>(m_numberCpuX)); //Non-optimal number of processors in the x-direction
-    double tempNumberCpuY(static_cast<double>(m_numberCpuY)); //Non-optimal number of processors in the y-direction
-    double tempNumberCpuZ(static_cast<double>(m_numberCpuZ)); //Non-optimal number of processors in the z-direction
-    double CpuFactorizationMin;                               //Processor factorization (fct) minimization parameter
-    CpuFactorizationMin = 10.*abs(static_cast<double>(m_numberCellsXGlobal) / tempNumberCpuX - static_cast<double>(m_numberCellsYGlobal) / tempNumberCpuY)
-      + 10.*abs(static_cast<double>(m_numberCellsYGlobal) / tempNumberCpuY - static_cast<double>(m_numberCellsZGlobal) / tempNumberCpuZ);
-
-    //Optimization of the initial processor topology
-    for (int i = 1; i <= Ncpu; i++) {
-      if ((Ncpu % i == 0) && (m_numberCellsXGlobal / i >= minCellNumberOneDirection)) {
-        for (int j = 1; j <= Ncpu/i; j++) {
-          if ((Ncpu/i % j == 0) && (m_numberCellsYGlobal / j >= minCellNumberOneDirection)) {
-            tempNumberCpuX = i;
-            tempNumberCpuY = j;
-            tempNumberCpuZ = Ncpu / (i*j);
-            if (CpuFactorizationMin >= abs(m_numberCellsXGlobal / tempNumberCpuX - m_numberCellsYGlobal / tempNumberCpuY) + abs(m_numberCellsYGlobal / tempNumberCpuY - m_numberCellsZGlobal / tempNumberCpuZ)
-              && m_numberCellsZGlobal / tempNumberCpuZ >= minCellNumberOneDirection) {
-              m_numberCpuX = i;
-              m_numberCpuY = j;
-              m_numberCpuZ = Ncpu / (i*j);
-              CpuFactorizationMin = abs(m_numberCellsXGlobal / tempNumberCpuX - m_numberCellsYGlobal / tempNumberCpuY) + abs(m_numberCellsYGlobal / tempNumberCpuY - m_numberCellsZGlobal / tempNumberCpuZ);
-              error = 0;
-            }
-          }
-        }
-      }
-    }
-
-    //Verifying that a valid decomposition of the computational domain has been established. If not, the simulation exits.
-    if (rankCpu == 0 && error == -1) {
-      Errors::errorMessage("Unsupported combination of values of number of CPU, cells in x- and y-directions");
-    }
+    //Choice of the processor topology
+    this->choixTopologieCpu();
 
     //Coordinates of the current CPU
     int rest;
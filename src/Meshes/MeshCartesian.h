@@ -56,7 +56,12 @@ public:
   virtual void initializeGeometrieParallele(Cell ***cells, CellInterface ***bord, std::string ordreCalcul);
   virtual void effetsMesh(CellInterface **face, const int &numberPhases) const {};
   void decoupageParallele();
+  //! \brief     Choice of the Cartesian processor topology
+  //! \details   Among the factorizations of the number of CPUs, keeps the one minimizing the cost of the largest block (cells + weighted ghost cells), then the total cut surface
+  void choixTopologieCpu();
   virtual std::string whoAmI() const;
+  //! \brief     Location of the cell containing a point by binary search on the (stretched) cell positions of each axis
+  virtual bool locateCell(const Coord &point, int &index) const;
 
   //Printing / Reading
   virtual std::string recupereChaineExtent(int localRank, bool global = false) const;
@@ -65,6 +70,9 @@ public:
   virtual void setDataSet(std::vector<double> &jeuDonnees, std::vector<Cell *> *cellsLvl, const int var, int phase, int lvl = 0) const;
 
 protected:
+  //! \brief     Global index along an axis of the cell containing the coordinate, -1 if outside of the domain
+  int locateIndexAxis(const double &x, const std::vector<double> &pos, const std::vector<double> &d) const;
+
   ElementCartesian *m_elements;
   FaceCartesian *m_faces;
 
@@ -34,6 +34,7 @@
 
 #include <iostream>
 #include <algorithm>
+#include <cmath>
 #include <sstream>
 
 #include "MeshCartesianAMR.h"
@@ -46,7 +47,7 @@ MeshCartesianAMR::MeshCartesianAMR(double lX, int numberCellsX, double lY, int n
   std::vector<stretchZone> stretchX, std::vector<stretchZone> stretchY, std::vector<stretchZone> stretchZ,
 	int lvlMax, double criteriaVar, bool varRho, bool varP, bool varU, bool varAlpha, double xiSplit, double xiJoin) :
   MeshCartesian(lX, numberCellsX, lY, numberCellsY, lZ, numberCellsZ, stretchX, stretchY, stretchZ),
-  m_lvlMax(lvlMax), m_criteriaVar(criteriaVar), m_varRho(varRho), m_varP(varP), m_varU(varU), m_varAlpha(varAlpha), m_xiSplit(xiSplit), m_xiJoin(xiJoin)
+  m_lvlMax(lvlMax), m_criteriaVar(criteriaVar), m_varRho(varRho), m_varP(varP), m_varU(varU), m_varAlpha(varAlpha), m_xiSplit(xiSplit), m_xiJoin(xiJoin), m_refinementAllowed(true), m_numberPrimitiveVariables(0)
 {
   m_type = AMR;
 }
@@ -76,6 +77,15 @@ void MeshCartesianAMR::genereTableauxCellsBordsLvl(Cell **cells, CellInterface *
 		for (int i = m_numberCellsCalcul; i < m_numberCellsTotal; i++) {
 			m_cellsLvlGhost[0].push_back(cells[i]);
 		}
+    //Global indexes of the level-0 cells of the Cartesian block (given by the repartition otherwise)
+    if (m_splitKeys.empty()) {
+      m_globalIndex.resize(m_numberCellsCalcul);
+      int ix, iy, iz;
+      for (int i = 0; i < m_numberCellsCalcul; i++) {
+        this->recupereIJK(i, ix, iy, iz);
+        m_globalIndex[i] = (ix + m_offsetX) + (iy + m_offsetY)*m_numberCellsXGlobal + (iz + m_offsetZ)*m_numberCellsXGlobal*m_numberCellsYGlobal;
+      }
+    }
 	}
 }
 
@@ -156,7 +166,9 @@ void MeshCartesianAMR::procedureRaffinement(vector<Cell *> *cellsLvl, vector<Cel
     int lvlPlus1 = lvl + 1;
     //3) Raffinement des cells et boundaries
     //------------------------------------
-    for (unsigned int i = 0; i < cellsLvl[lvl].size(); i++) { cellsLvl[lvl][i]->chooseRefine(m_xiSplit, m_numberCellsY, m_numberCellsZ, addPhys, model, nbCellsTotalAMR); }
+    if (m_refinementAllowed) {
+      for (unsigned int i = 0; i < cellsLvl[lvl].size(); i++) { cellsLvl[lvl][i]->chooseRefine(m_xiSplit, m_numberCellsY, m_numberCellsZ, addPhys, model, nbCellsTotalAMR); }
+    }
 
     //4) Deraffinement des cells et boundaries
     //--------------------------------------
@@ -190,6 +202,16 @@ void MeshCartesianAMR::procedureRaffinement(vector<Cell *> *cellsLvl, vector<Cel
 
 //***********************************************************************
 
+int MeshCartesianAMR::getNumberCellsGhost() const
+{
+  if (Ncpu == 1) return 0;
+  int numberCellsGhost(0);
+  for (int lvl = 0; lvl <= m_lvlMax; lvl++) { numberCellsGhost += m_cellsLvlGhost[lvl].size(); }
+  return numberCellsGhost;
+}
+
+//***********************************************************************
+
 string MeshCartesianAMR::whoAmI() const
 {
   return "CARTESIAN_AMR";
@@ -199,7 +221,7 @@ string MeshCartesianAMR::whoAmI() const
 //******************************** PRINTING ********************************
 //**************************************************************************
 
-void MeshCartesianAMR::ecritHeaderPiece(std::ofstream &fileStream, std::vector<Cell *> *cellsLvl, int lvl) const
+void MeshCartesianAMR::ecritHeaderPiece(std::ostream &fileStream, std::vector<Cell *> *cellsLvl, int lvl) const
 {
   int numberCells = 0, numberPointsParMaille = 4;
   for (unsigned int i = 0; i < cellsLvl[lvl].size(); i++) {
@@ -415,7 +437,7 @@ void MeshCartesianAMR::initializePersistentCommunications(const int numberPhases
 	int numberVariablesPhaseATransmettre = cells[0]->getPhase(0)->numberOfTransmittedVariables();
 	numberVariablesPhaseATransmettre *= m_numberPhases;
 	int numberVariablesMixtureATransmettre = cells[0]->getMixture()->numberOfTransmittedVariables();
-	int m_numberPrimitiveVariables = numberVariablesPhaseATransmettre + numberVariablesMixtureATransmettre + m_numberTransports;
+	m_numberPrimitiveVariables = numberVariablesPhaseATransmettre + numberVariablesMixtureATransmettre + m_numberTransports;
   int m_numberSlopeVariables(0);
   if (ordreCalcul == "SECONDORDER") {
     int numberSlopesPhaseATransmettre = cells[0]->getPhase(0)->numberOfTransmittedSlopes();
@@ -468,4 +490,480 @@ void MeshCartesianAMR::finalizeParallele(const int &lvlMax)
 	parallel.finalizeAMR(lvlMax);
 }
 
-//***********************************************************************
\ No newline at end of file
+//***********************************************************************
+
+//***********************************************************************
+
+//Cost of an AMR subtree: each cell is advanced 2^lvl times per level-0 time step
+static double subtreeWeight(Cell *cell)
+{
+  double weight(pow(2., cell->getLvl()));
+  for (int c = 0; c < cell->getNumberCellsChildren(); c++) { weight += subtreeWeight(cell->getCellChild(c)); }
+  return weight;
+}
+
+//***********************************************************************
+
+//Morton key by interleaving of the bits of the global indexes (21 bits per direction)
+static unsigned long long mortonKey(int i, int j, int k)
+{
+  unsigned long long key(0);
+  for (int b = 0; b < 21; b++) {
+    key |= ((static_cast<unsigned long long>(i) >> b) & 1ULL) << (3 * b);
+    key |= ((static_cast<unsigned long long>(j) >> b) & 1ULL) << (3 * b + 1);
+    key |= ((static_cast<unsigned long long>(k) >> b) & 1ULL) << (3 * b + 2);
+  }
+  return key;
+}
+
+//***********************************************************************
+
+void MeshCartesianAMR::recupereIJKGlobal(const int &index, int &i, int &j, int &k) const
+{
+  int reste;
+  k = m_globalIndex[index] / (m_numberCellsXGlobal*m_numberCellsYGlobal);
+  reste = m_globalIndex[index] % (m_numberCellsXGlobal*m_numberCellsYGlobal);
+  j = reste / m_numberCellsXGlobal;
+  i = reste % m_numberCellsXGlobal;
+}
+
+//***********************************************************************
+
+int MeshCartesianAMR::ownerCpu(const int &i, const int &j, const int &k) const
+{
+  return upper_bound(m_splitKeys.begin(), m_splitKeys.end(), mortonKey(i, j, k)) - m_splitKeys.begin();
+}
+
+//***********************************************************************
+
+bool MeshCartesianAMR::locateCell(const Coord &point, int &index) const
+{
+  if (m_splitKeys.empty()) return MeshCartesian::locateCell(point, index);
+  index = -1;
+  int i(0), j(0), k(0);
+  if (m_numberCellsXGlobal != 1) i = locateIndexAxis(point.getX(), m_posXi, m_dXi);
+  if (m_numberCellsYGlobal != 1) j = locateIndexAxis(point.getY(), m_posYj, m_dYj);
+  if (m_numberCellsZGlobal != 1) k = locateIndexAxis(point.getZ(), m_posZk, m_dZk);
+  if (i < 0 || j < 0 || k < 0) return true;
+  //Local cells are sorted by global index after a repartition
+  int global(i + j*m_numberCellsXGlobal + k*m_numberCellsXGlobal*m_numberCellsYGlobal);
+  vector<int>::const_iterator cell(lower_bound(m_globalIndex.begin(), m_globalIndex.end(), global));
+  if (cell != m_globalIndex.end() && *cell == global) index = cell - m_globalIndex.begin();
+  return true;
+}
+
+//***********************************************************************
+
+void MeshCartesianAMR::computeRepartition(vector<unsigned long long> &splitKeys, double &averageWeight, double &maxWeight, int &heaviestCpu, double &maxWeightCurve) const
+{
+  //1) Weights and Morton keys of the level-0 cells of the CPU
+  vector<unsigned long long> keys(m_numberCellsCalcul);
+  vector<double> weights(m_numberCellsCalcul);
+  int ix, iy, iz;
+  for (int i = 0; i < m_numberCellsCalcul; i++) {
+    this->recupereIJKGlobal(i, ix, iy, iz);
+    keys[i] = mortonKey(ix, iy, iz);
+    weights[i] = subtreeWeight((*m_cellsLvl)[0][i]);
+  }
+
+  //2) Gathering on CPU 0
+  int numberCells(m_numberCellsCalcul);
+  vector<int> numberCellsCPU(Ncpu), displacements(Ncpu);
+  MPI_Gather(&numberCells, 1, MPI_INT, &numberCellsCPU[0], 1, MPI_INT, 0, commCompute);
+  int numberCellsGlobal(0);
+  if (rankCpu == 0) {
+    for (int p = 0; p < Ncpu; p++) { displacements[p] = numberCellsGlobal; numberCellsGlobal += numberCellsCPU[p]; }
+  }
+  vector<unsigned long long> keysGlobal(max(numberCellsGlobal, 1));
+  vector<double> weightsGlobal(max(numberCellsGlobal, 1));
+  MPI_Gatherv(&keys[0], numberCells, MPI_UNSIGNED_LONG_LONG, &keysGlobal[0], &numberCellsCPU[0], &displacements[0], MPI_UNSIGNED_LONG_LONG, 0, commCompute);
+  MPI_Gatherv(&weights[0], numberCells, MPI_DOUBLE, &weightsGlobal[0], &numberCellsCPU[0], &displacements[0], MPI_DOUBLE, 0, commCompute);
+
+  double loads[4] = { 0., 0., 0., 0. };
+  splitKeys.clear();
+  if (rankCpu == 0) {
+    //3) Current load of each CPU
+    double totalWeight(0.);
+    maxWeight = 0.; heaviestCpu = 0;
+    for (int p = 0; p < Ncpu; p++) {
+      double weightCpu(0.);
+      for (int i = displacements[p]; i < displacements[p] + numberCellsCPU[p]; i++) { weightCpu += weightsGlobal[i]; }
+      totalWeight += weightCpu;
+      if (weightCpu > maxWeight) { maxWeight = weightCpu; heaviestCpu = p; }
+    }
+    averageWeight = totalWeight / Ncpu;
+
+    //4) Repartition along the space-filling curve: consecutive chunks with cumulated weight as close as possible to the average
+    vector< pair<unsigned long long, double> > curve(numberCellsGlobal);
+    for (int i = 0; i < numberCellsGlobal; i++) { curve[i] = make_pair(keysGlobal[i], weightsGlobal[i]); }
+    sort(curve.begin(), curve.end());
+    double weightChunk(0.), cumulated(0.);
+    maxWeightCurve = 0.;
+    int chunk(0);
+    for (int i = 0; i < numberCellsGlobal; i++) {
+      double target((chunk + 1) * averageWeight);
+      //Closing the chunk if adding the cell overshoots the target more than leaving it
+      if (chunk < Ncpu - 1 && weightChunk > 0. && cumulated + curve[i].second - target > target - cumulated) {
+        maxWeightCurve = max(maxWeightCurve, weightChunk);
+        weightChunk = 0.; chunk++;
+        splitKeys.push_back(curve[i].first);
+      }
+      weightChunk += curve[i].second;
+      cumulated += curve[i].second;
+    }
+    maxWeightCurve = max(maxWeightCurve, weightChunk);
+    //A CPU without cell is not handled by the geometry
+    if (chunk < Ncpu - 1) splitKeys.clear();
+    loads[0] = averageWeight; loads[1] = maxWeight; loads[2] = heaviestCpu; loads[3] = maxWeightCurve;
+  }
+
+  //5) Same loads and split keys on every CPU
+  MPI_Bcast(loads, 4, MPI_DOUBLE, 0, commCompute);
+  averageWeight = loads[0]; maxWeight = loads[1]; heaviestCpu = static_cast<int>(loads[2]); maxWeightCurve = loads[3];
+  int numberSplitKeys(splitKeys.size());
+  MPI_Bcast(&numberSplitKeys, 1, MPI_INT, 0, commCompute);
+  splitKeys.resize(numberSplitKeys);
+  if (numberSplitKeys > 0) MPI_Bcast(&splitKeys[0], numberSplitKeys, MPI_UNSIGNED_LONG_LONG, 0, commCompute);
+}
+
+//***********************************************************************
+
+void MeshCartesianAMR::printLoadBalance(const int &numTest) const
+{
+  if (Ncpu == 1) return;
+
+  vector<unsigned long long> splitKeys;
+  double averageWeight, maxWeight, maxWeightCurve;
+  int heaviestCpu;
+  this->computeRepartition(splitKeys, averageWeight, maxWeight, heaviestCpu, maxWeightCurve);
+
+  if (rankCpu == 0) cout << "T" << numTest << " | AMR load balance : max/avg = " << maxWeight / averageWeight << " (CPU " << heaviestCpu << ")"
+    << " / space-filling curve repartition : max/avg = " << maxWeightCurve / averageWeight << endl;
+}
+
+//***********************************************************************
+
+bool MeshCartesianAMR::repartitionCells(Cell ***cells, CellInterface ***bord, vector<Cell *> **cellsLvl, vector<CellInterface *> **boundariesLvl,
+  const vector<AddPhys*> &addPhys, Model *model, Eos **eos, int &nbCellsTotalAMR, const double &threshold, string ordreCalcul, const int &numTest)
+{
+  if (Ncpu == 1) return false;
+
+  //1) Repartition along the space-filling curve, kept only if it lowers the load of the heaviest CPU
+  //-------------------------------------------------------------------------------------------------
+  vector<unsigned long long> splitKeys;
+  double averageWeight, maxWeight, maxWeightCurve;
+  int heaviestCpu;
+  this->computeRepartition(splitKeys, averageWeight, maxWeight, heaviestCpu, maxWeightCurve);
+  if (splitKeys.empty() || maxWeight <= threshold*averageWeight || maxWeightCurve >= maxWeight) return false;
+
+  //2) Trees packed for their new CPU
+  //---------------------------------
+  //Global index and number of cells of the tree, then split flag, xi and primitive variables of each cell (breadth-first order)
+  int sizeCell(m_numberPrimitiveVariables + 2), numberMoved(0);
+  vector< vector<double> > trees(Ncpu);
+  int ix, iy, iz;
+  for (int i = 0; i < m_numberCellsCalcul; i++) {
+    this->recupereIJKGlobal(i, ix, iy, iz);
+    int cpu(upper_bound(splitKeys.begin(), splitKeys.end(), mortonKey(ix, iy, iz)) - splitKeys.begin());
+    if (cpu != rankCpu) numberMoved++;
+    vector<Cell *> tree(1, (*cells)[i]);
+    for (unsigned int c = 0; c < tree.size(); c++) {
+      for (int child = 0; child < tree[c]->getNumberCellsChildren(); child++) { tree.push_back(tree[c]->getCellChild(child)); }
+    }
+    vector<double> &buffer(trees[cpu]);
+    buffer.push_back(m_globalIndex[i]);
+    buffer.push_back(tree.size());
+    int counter(buffer.size() - 1);
+    buffer.resize(buffer.size() + tree.size()*sizeCell);
+    for (unsigned int c = 0; c < tree.size(); c++) {
+      buffer[++counter] = tree[c]->getSplit();
+      buffer[++counter] = tree[c]->getXi();
+      tree[c]->fillBufferPrimitives(&buffer[0], counter);
+    }
+  }
+
+  //3) Exchange of the trees
+  //------------------------
+  vector<int> numberSend(Ncpu), numberReceive(Ncpu), displacementsSend(Ncpu), displacementsReceive(Ncpu);
+  vector<double> bufferSend;
+  for (int p = 0; p < Ncpu; p++) {
+    numberSend[p] = trees[p].size();
+    displacementsSend[p] = bufferSend.size();
+    bufferSend.insert(bufferSend.end(), trees[p].begin(), trees[p].end());
+    vector<double>().swap(trees[p]);
+  }
+  MPI_Alltoall(&numberSend[0], 1, MPI_INT, &numberReceive[0], 1, MPI_INT, commCompute);
+  int sizeReceive(0);
+  for (int p = 0; p < Ncpu; p++) { displacementsReceive[p] = sizeReceive; sizeReceive += numberReceive[p]; }
+  bufferSend.resize(max(static_cast<int>(bufferSend.size()), 1));
+  vector<double> bufferReceive(max(sizeReceive, 1));
+  MPI_Alltoallv(&bufferSend[0], &numberSend[0], &displacementsSend[0], MPI_DOUBLE,
+    &bufferReceive[0], &numberReceive[0], &displacementsReceive[0], MPI_DOUBLE, commCompute);
+  vector<double>().swap(bufferSend);
+
+  //Received trees sorted by global index of their level-0 cell
+  vector< pair<int, int> > receivedTrees;
+  for (int position = 0; position < sizeReceive; position += 2 + static_cast<int>(bufferReceive[position + 1])*sizeCell) {
+    receivedTrees.push_back(make_pair(static_cast<int>(bufferReceive[position]), position));
+  }
+  sort(receivedTrees.begin(), receivedTrees.end());
+
+  //4) Release of the cells, boundaries and persistent communications of the current partition
+  //-----------------------------------------------------------------------------------------
+  for (int i = 0; i < m_numberFacesTotal; i++) { delete (*bord)[i]; }
+  delete[] *bord;
+  for (int i = 0; i < m_numberCellsTotal; i++) { delete (*cells)[i]; }
+  delete[] *cells;
+  delete[] m_elements;
+  delete[] m_faces;
+  delete[] *cellsLvl;
+  delete[] *boundariesLvl;
+  delete[] m_cellsLvlGhost;
+  parallel.finalizeAMR(m_lvlMax);
+  parallel.resetNeighbours();
+
+  //5) Level-0 cells and ghost cells of the new partition
+  //------------------------------------------------------
+  m_splitKeys = splitKeys;
+  m_globalIndex.resize(receivedTrees.size());
+  for (unsigned int t = 0; t < receivedTrees.size(); t++) { m_globalIndex[t] = receivedTrees[t].first; }
+  this->initializeGeometrieRepartition(cells, bord, ordreCalcul);
+  for (int i = 0; i < m_numberCellsTotal; i++) { (*cells)[i]->allocate(m_numberPhases, m_numberTransports, addPhys, model); }
+  for (int i = 0; i < m_numberFacesTotal; i++) { (*bord)[i]->associeModel(model); }
+  int allocateSlopeLocal = 0;
+  for (int i = 0; i < m_numberFacesTotal; i++) { (*bord)[i]->allocateSlopes(m_numberPhases, m_numberTransports, allocateSlopeLocal); }
+  this->genereTableauxCellsBordsLvl(*cells, *bord, cellsLvl, boundariesLvl);
+  this->initializePersistentCommunications(m_numberPhases, m_numberTransports, *cells, ordreCalcul);
+
+  //6) Trees built again level by level
+  //------------------------------------
+  //Cells of the level are filled from their record, ghost cells are updated, then split cells are refined as in procedureRaffinement
+  vector<int> position(receivedTrees.size());
+  vector< vector<Cell *> > cellsTreeLvl(receivedTrees.size());
+  for (unsigned int t = 0; t < receivedTrees.size(); t++) {
+    position[t] = receivedTrees[t].second + 2;
+    cellsTreeLvl[t].assign(1, (*cells)[t]);
+  }
+  nbCellsTotalAMR = m_numberCellsCalcul;
+  for (int lvl = 0; lvl <= m_lvlMax; lvl++) {
+    for (unsigned int t = 0; t < receivedTrees.size(); t++) {
+      vector<Cell *> cellsTreeLvlPlus1;
+      for (unsigned int c = 0; c < cellsTreeLvl[t].size(); c++) {
+        Cell *cell(cellsTreeLvl[t][c]);
+        bool split(bufferReceive[position[t]] > 0.5);
+        cell->setXi(bufferReceive[position[t] + 1]);
+        int counter(position[t] + 1);
+        cell->getBufferPrimitives(&bufferReceive[0], counter, eos);
+        //Phases copied onto themselves so that second order states also get their EOS, as in GeometricalDomain::fillIn
+        for (int k = 0; k < m_numberPhases; k++) { cell->copyPhase(k, cell->getPhase(k)); }
+        position[t] += sizeCell;
+        if (split && lvl < m_lvlMax) {
+          this->refineCell(cell, addPhys, model, nbCellsTotalAMR);
+          for (int child = 0; child < cell->getNumberCellsChildren(); child++) { cellsTreeLvlPlus1.push_back(cell->getCellChild(child)); }
+        }
+      }
+      cellsTreeLvl[t].swap(cellsTreeLvlPlus1);
+    }
+    parallel.communicationsPrimitivesAMR(*cells, eos, lvl);
+    if (lvl == 0) {
+      for (unsigned int i = 0; i < m_cellsLvlGhost[0].size(); i++) {
+        for (int k = 0; k < m_numberPhases; k++) { m_cellsLvlGhost[0][i]->copyPhase(k, m_cellsLvlGhost[0][i]->getPhase(k)); }
+      }
+    }
+
+    if (lvl < m_lvlMax) {
+      int lvlPlus1 = lvl + 1;
+      //Ghost cells refined as their owner
+      parallel.communicationsSplit(*cells, lvl);
+      m_cellsLvlGhost[lvlPlus1].clear();
+      for (unsigned int i = 0; i < m_cellsLvlGhost[lvl].size(); i++) { m_cellsLvlGhost[lvl][i]->chooseRefineDeraffineGhost(m_numberCellsY, m_numberCellsZ, addPhys, model, m_cellsLvlGhost); }
+      parallel.communicationsNumberGhostCells(*cells, lvlPlus1);
+      parallel.updatePersistentCommunicationsLvl(lvlPlus1, m_geometrie);
+      //Cells and boundaries of level lvl + 1
+      (*cellsLvl)[lvlPlus1].clear();
+      (*boundariesLvl)[lvlPlus1].clear();
+      for (unsigned int i = 0; i < (*cellsLvl)[lvl].size(); i++) { (*cellsLvl)[lvl][i]->buildLvlCellsAndLvlInternalBoundariesArrays(*cellsLvl, *boundariesLvl); }
+      for (unsigned int i = 0; i < (*boundariesLvl)[lvl].size(); i++) { (*boundariesLvl)[lvl][i]->constructionTableauBordsExternesLvl(*boundariesLvl); }
+    }
+  }
+
+  int numberMovedGlobal(0);
+  MPI_Reduce(&numberMoved, &numberMovedGlobal, 1, MPI_INT, MPI_SUM, 0, commCompute);
+  if (rankCpu == 0) cout << "T" << numTest << " | AMR load balancing : " << numberMovedGlobal << " level-0 cells moved, max/avg = "
+    << maxWeight / averageWeight << " -> " << maxWeightCurve / averageWeight << endl;
+  return true;
+}
+
+//***********************************************************************
+
+//Boundary of a level-0 cell shared with a cell of another CPU
+struct FaceRepartition
+{
+  int cpu;        //CPU of the neighbour cell
+  int globalMin;  //Lowest global index of the two cells
+  int globalMax;  //Highest global index of the two cells
+  int face;       //Number of the boundary
+  bool operator<(const FaceRepartition &other) const
+  {
+    if (cpu != other.cpu) return cpu < other.cpu;
+    if (globalMin != other.globalMin) return globalMin < other.globalMin;
+    return globalMax < other.globalMax;
+  }
+};
+
+//***********************************************************************
+
+void MeshCartesianAMR::initializeGeometrieRepartition(Cell ***cells, CellInterface ***bord, string ordreCalcul)
+{
+  //Local numbering is replaced by the global one
+  m_numberCellsX = m_numberCellsXGlobal;
+  m_numberCellsY = m_numberCellsYGlobal;
+  m_numberCellsZ = m_numberCellsZGlobal;
+  m_offsetX = 0; m_offsetY = 0; m_offsetZ = 0;
+  m_numberCellsCalcul = m_globalIndex.size();
+
+  int numberCells[3] = { m_numberCellsX, m_numberCellsY, m_numberCellsZ };
+  int stride[3] = { 1, m_numberCellsX, m_numberCellsX*m_numberCellsY };
+  const vector<double> *sizes[3] = { &m_dXi, &m_dYj, &m_dZk };
+  BoundCond *limites[3][2] = { { m_limXm, m_limXp }, { m_limYm, m_limYp }, { m_limZm, m_limZp } };
+  //Side of this CPU for the neighbour when the ghost cell is on the minus / plus side of the cell
+  string whichCpuAmIForNeighbour[3][2] = { { "RIGHT", "LEFT" }, { "TOP", "BOTTOM" }, { "FRONT", "BACK" } };
+  //Normal, tangent and binormal of the faces of the minus / plus side of the cells
+  Coord normals[3][2], tangents[3][2], binormals[3][2];
+  normals[0][0].setXYZ(-1., 0., 0.); tangents[0][0].setXYZ(0., -1., 0.); binormals[0][0].setXYZ(0., 0., 1.);
+  normals[0][1].setXYZ(1., 0., 0.);  tangents[0][1].setXYZ(0., 1., 0.);  binormals[0][1].setXYZ(0., 0., 1.);
+  normals[1][0].setXYZ(0., -1., 0.); tangents[1][0].setXYZ(1., 0., 0.);  binormals[1][0].setXYZ(0., 0., 1.);
+  normals[1][1].setXYZ(0., 1., 0.);  tangents[1][1].setXYZ(-1., 0., 0.); binormals[1][1].setXYZ(0., 0., 1.);
+  normals[2][0].setXYZ(0., 0., -1.); tangents[2][0].setXYZ(-1., 0., 0.); binormals[2][0].setXYZ(0., 1., 0.);
+  normals[2][1].setXYZ(0., 0., 1.);  tangents[2][1].setXYZ(1., 0., 0.);  binormals[2][1].setXYZ(0., 1., 0.);
+
+  //1) Boundaries of the level-0 cells
+  //----------------------------------
+  //Internal boundaries first (normal along increasing indexes), then physical boundaries and boundaries shared with another CPU
+  vector<int> faceCell, faceAxis, faceSide, faceNeighbour;   //Local cell, axis, side (0 minus, 1 plus) and local (internal) or global (parallel) neighbour
+  vector<FaceRepartition> facesParallel;
+  int ijk[3], neighbour[3];
+  for (int axis = 0; axis < 3; axis++) {
+    if (numberCells[axis] == 1) continue;
+    for (int i = 0; i < m_numberCellsCalcul; i++) {
+      this->recupereIJKGlobal(i, ijk[0], ijk[1], ijk[2]);
+      if (ijk[axis] + 1 == numberCells[axis]) continue;
+      for (int a = 0; a < 3; a++) { neighbour[a] = ijk[a]; }
+      neighbour[axis]++;
+      if (this->ownerCpu(neighbour[0], neighbour[1], neighbour[2]) != rankCpu) continue;
+      faceCell.push_back(i); faceAxis.push_back(axis); faceSide.push_back(1);
+      faceNeighbour.push_back(lower_bound(m_globalIndex.begin(), m_globalIndex.end(), m_globalIndex[i] + stride[axis]) - m_globalIndex.begin());
+    }
+  }
+  int numberFacesInternes(faceCell.size());
+  for (int axis = 0; axis < 3; axis++) {
+    if (numberCells[axis] == 1) continue;
+    for (int side = 0; side < 2; side++) {
+      for (int i = 0; i < m_numberCellsCalcul; i++) {
+        this->recupereIJKGlobal(i, ijk[0], ijk[1], ijk[2]);
+        for (int a = 0; a < 3; a++) { neighbour[a] = ijk[a]; }
+        neighbour[axis] += 2 * side - 1;
+        if (neighbour[axis] < 0 || neighbour[axis] == numberCells[axis]) { //Physical boundary
+          faceCell.push_back(i); faceAxis.push_back(axis); faceSide.push_back(side); faceNeighbour.push_back(-1);
+          continue;
+        }
+        int cpu(this->ownerCpu(neighbour[0], neighbour[1], neighbour[2]));
+        if (cpu == rankCpu) continue;
+        int global(m_globalIndex[i] + (2 * side - 1)*stride[axis]);
+        FaceRepartition face = { cpu, min(global, m_globalIndex[i]), max(global, m_globalIndex[i]), static_cast<int>(faceCell.size()) };
+        facesParallel.push_back(face);
+        faceCell.push_back(i); faceAxis.push_back(axis); faceSide.push_back(side); faceNeighbour.push_back(global);
+      }
+    }
+  }
+  m_numberFacesTotal = faceCell.size();
+
+  //Ghost cells numbered in the same order on both CPUs of each boundary
+  sort(facesParallel.begin(), facesParallel.end());
+  m_numberCellsTotal = m_numberCellsCalcul + facesParallel.size();
+  vector<int> faceGhost(m_numberFacesTotal, -1);
+  for (unsigned int f = 0; f < facesParallel.size(); f++) { faceGhost[facesParallel[f].face] = m_numberCellsCalcul + f; }
+
+  //2) Cells
+  //--------
+  m_elements = new ElementCartesian[m_numberCellsTotal];
+  (*cells) = new Cell*[m_numberCellsTotal];
+  for (int i = 0; i < m_numberCellsTotal; i++) {
+    if (ordreCalcul == "FIRSTORDER") { (*cells)[i] = new Cell; }
+    else if (i < m_numberCellsCalcul) { (*cells)[i] = new CellO2; }
+    else { (*cells)[i] = new CellO2Ghost; }
+    (*cells)[i]->setElement(&m_elements[i], i);
+  }
+  for (int i = 0; i < m_numberCellsTotal; i++) {
+    if (i < m_numberCellsCalcul) { this->recupereIJKGlobal(i, ijk[0], ijk[1], ijk[2]); }
+    else {
+      int f(facesParallel[i - m_numberCellsCalcul].face);
+      this->recupereIJKGlobal(faceCell[f], ijk[0], ijk[1], ijk[2]);
+      ijk[faceAxis[f]] += 2 * faceSide[f] - 1;
+    }
+    double lCFL(1.e10);
+    for (int a = 0; a < 3; a++) { if (numberCells[a] != 1) lCFL = min(lCFL, (*sizes[a])[ijk[a]]); }
+    if (m_geometrie > 1) lCFL *= 0.6;
+    (*cells)[i]->getElement()->setVolume(m_dXi[ijk[0]] * m_dYj[ijk[1]] * m_dZk[ijk[2]]);
+    (*cells)[i]->getElement()->setLCFL(lCFL);
+    (*cells)[i]->getElement()->setPos(m_posXi[ijk[0]], m_posYj[ijk[1]], m_posZk[ijk[2]]);
+    (*cells)[i]->getElement()->setSize(m_dXi[ijk[0]], m_dYj[ijk[1]], m_dZk[ijk[2]]);
+  }
+
+  //3) Boundaries
+  //-------------
+  (*bord) = new CellInterface*[m_numberFacesTotal];
+  m_faces = new FaceCartesian[m_numberFacesTotal];
+  int iMailleG, iMailleD;
+  for (int f = 0; f < m_numberFacesTotal; f++) {
+    int axis(faceAxis[f]), side(faceSide[f]);
+    if (f < numberFacesInternes) { iMailleG = faceCell[f]; iMailleD = faceNeighbour[f]; }
+    else if (faceNeighbour[f] < 0) { iMailleG = faceCell[f]; iMailleD = iMailleG; }
+    else if (side == 0) { iMailleG = faceGhost[f]; iMailleD = faceCell[f]; }
+    else { iMailleG = faceCell[f]; iMailleD = faceGhost[f]; }
+    if (iMailleG == iMailleD) {
+      limites[axis][side]->creeLimite(&(*bord)[f]);
+      (*cells)[iMailleG]->addBoundary((*bord)[f]);
+    }
+    else {
+      //Internal and parallel boundaries have their normal along increasing indexes
+      side = 1;
+      if (ordreCalcul == "FIRSTORDER") { (*bord)[f] = new CellInterface; }
+      else { (*bord)[f] = new CellInterfaceO2; }
+      (*cells)[iMailleG]->addBoundary((*bord)[f]);
+      (*cells)[iMailleD]->addBoundary((*bord)[f]);
+    }
+    (*bord)[f]->setFace(&m_faces[f]);
+    (*bord)[f]->initialize((*cells)[iMailleG], (*cells)[iMailleD]);
+    this->recupereIJKGlobal(faceCell[f], ijk[0], ijk[1], ijk[2]);
+    double size[3] = { m_dXi[ijk[0]], m_dYj[ijk[1]], m_dZk[ijk[2]] };
+    double pos[3] = { m_posXi[ijk[0]], m_posYj[ijk[1]], m_posZk[ijk[2]] };
+    pos[axis] += (faceSide[f] - 0.5)*size[axis];
+    size[axis] = 0.;
+    double surface(1.);
+    for (int a = 0; a < 3; a++) { if (a != axis) surface *= size[a]; }
+    m_faces[f].initializeAutres(surface, normals[axis][side], tangents[axis][side], binormals[axis][side]);
+    m_faces[f].setSize(size[0], size[1], size[2]);
+    m_faces[f].setPos(pos[0], pos[1], pos[2]);
+  }
+
+  //4) Elements to exchange with each neighbour CPU, in the order of the ghost cells
+  //-------------------------------------------------------------------------------
+  unsigned int debut(0);
+  while (debut < facesParallel.size()) {
+    int cpu(facesParallel[debut].cpu);
+    vector<int> elementsToSend, elementsToReceive;
+    vector<string> whichCpuAmIForElement;
+    unsigned int f(debut);
+    for (; f < facesParallel.size() && facesParallel[f].cpu == cpu; f++) {
+      int face(facesParallel[f].face);
+      elementsToSend.push_back(faceCell[face]);
+      elementsToReceive.push_back(faceGhost[face]);
+      whichCpuAmIForElement.push_back(whichCpuAmIForNeighbour[faceAxis[face]][faceSide[face]]);
+    }
+    parallel.setNeighbour(cpu, whichCpuAmIForElement[0]);
+    parallel.setElementsToSend(cpu, &elementsToSend[0], elementsToSend.size(), whichCpuAmIForElement);
+    parallel.setElementsToReceive(cpu, &elementsToReceive[0], elementsToReceive.size());
+    debut = f;
+  }
+}
@@ -56,7 +56,7 @@ public:
   virtual std::string whoAmI() const;
 
   //Printing / Reading
-  virtual void ecritHeaderPiece(std::ofstream &fileStream, std::vector<Cell *> *cellsLvl, int lvl = 0) const;
+  virtual void ecritHeaderPiece(std::ostream &fileStream, std::vector<Cell *> *cellsLvl, int lvl = 0) const;
   virtual void recupereNoeuds(std::vector<double> &jeuDonnees, int lvl = 0) const;
   virtual void recupereConnectivite(std::vector<double> &jeuDonnees, int lvl = 0) const;
   virtual void recupereOffsets(std::vector<double> &jeuDonnees, int lvl = 0) const;
@@ -67,6 +67,10 @@ public:
 
   //Accesseurs
   virtual int getLvlMax() const { return m_lvlMax; };
+  virtual int getNumberCellsGhost() const;
+  virtual void setRefinementAllowed(const bool &allowed) { m_refinementAllowed = allowed; };
+  //! \brief     Location of the local level-0 cell containing a point, also after a repartition of the cells along the space-filling curve
+  virtual bool locateCell(const Coord &point, int &index) const;
 
 	//Pour parallele
 	virtual void initializePersistentCommunications(const int numberPhases, const int numberTransports, Cell **cells, std::string ordreCalcul);
@@ -76,14 +80,44 @@ public:
 	virtual void communicationsAddPhys(const std::vector<AddPhys*> &addPhys, Cell **cells, const int &lvl);
   virtual void communicationsTransports(Cell **cells, const int &lvl);
 	virtual void finalizeParallele(const int &lvlMax);
+  //! \brief     Printing of the load balance between CPUs
+  //! \details   Each level-0 cell is weighted by the cost of its AMR subtree (2^lvl per cell for time sub-cycling).
+  //!            The current imbalance (max/avg) is compared to the one of a repartition of the level-0 cells along a Morton space-filling curve.
+  //! \param     numTest          number of the test case, for the printing prefix
+  virtual void printLoadBalance(const int &numTest) const;
+  //! \brief     Repartition of the level-0 cells between CPUs along the Morton space-filling curve
+  //! \details   Done only if the imbalance exceeds the threshold and the repartition lowers the load of the heaviest CPU.
+  //!            Trees are sent to their new CPU (split flags, xi and primitive variables of each cell), geometry and ghost cells
+  //!            are built again for the new partition and trees are refined again level by level, as in procedureRaffinement.
+  virtual bool repartitionCells(Cell ***cells, CellInterface ***bord, std::vector<Cell *> **cellsLvl, std::vector<CellInterface *> **boundariesLvl,
+    const std::vector<AddPhys*> &addPhys, Model *model, Eos **eos, int &nbCellsTotalAMR, const double &threshold, std::string ordreCalcul,
+    const int &numTest);
 
 private:
+  //! \brief     Global indexes of a local level-0 cell
+  void recupereIJKGlobal(const int &index, int &i, int &j, int &k) const;
+  //! \brief     CPU owning a level-0 cell after a repartition along the space-filling curve
+  int ownerCpu(const int &i, const int &j, const int &k) const;
+  //! \brief     Loads of the current partition and of the repartition along the space-filling curve (to be called by all CPUs)
+  //! \param     splitKeys        first Morton key of the cells of each CPU from CPU 1, empty if a CPU would receive no cell
+  //! \param     averageWeight    average load of the CPUs
+  //! \param     maxWeight        load of the heaviest CPU
+  //! \param     heaviestCpu      heaviest CPU
+  //! \param     maxWeightCurve   load of the heaviest CPU after repartition
+  void computeRepartition(std::vector<unsigned long long> &splitKeys, double &averageWeight, double &maxWeight, int &heaviestCpu, double &maxWeightCurve) const;
+  //! \brief     Geometry of the level-0 cells given by m_globalIndex, with one ghost cell per boundary shared with another CPU
+  void initializeGeometrieRepartition(Cell ***cells, CellInterface ***bord, std::string ordreCalcul);
+
   int m_lvlMax;                              //!<Niveau maximal sur l arbre AMR (si m_lvlMax = 0, pas d AMR)
 	double m_criteriaVar;                      //!<Valeur du criteria a depasser sur la variation d'une variable pour le (de)raffinement (met xi=1.)
 	bool m_varRho, m_varP, m_varU, m_varAlpha; //!<Choix sur quelle variation on (de)raffine
 	double m_xiSplit, m_xiJoin;                //!<Valeur de xi pour split ou join les mailles
   std::vector<Cell *> **m_cellsLvl;          //!<Pointer vers le tableau de vecteurs contenant les cells de compute, un vecteur par niveau.
 	std::vector<Cell *> *m_cellsLvlGhost;      //!<Tableau de vecteurs contenant les cells fantomes, un vecteur par niveau.
+  bool m_refinementAllowed;                  //!<False when the memory soft limit is reached
+  int m_numberPrimitiveVariables;            //!<Number of primitive variables of a cell (phases + mixture + transports)
+  std::vector<int> m_globalIndex;            //!<Global index of each local level-0 cell (parallel only)
+  std::vector<unsigned long long> m_splitKeys; //!<First Morton key of the level-0 cells of each CPU from CPU 1 (empty until a repartition)
 
 };
 
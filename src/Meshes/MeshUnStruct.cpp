@@ -36,18 +36,27 @@
 #include <sstream>
 #include <cmath>
 #include <algorithm>
+#include <cstring>
 #include "MeshUnStruct.h"
+#include "MeshUnStruct/GraphPartitioner.h"
 #include "../Errors.h"
 
 using namespace std;
 using namespace tinyxml2;
 
+//Identification of the geometry cache files
+static const char identifiantCache[16] = "ECOGEN geometry";
+static const int versionCache = 1;
+static const int testEndianCache = 1;
+
 //***********************************************************************
 
-MeshUnStruct::MeshUnStruct(const string &fichierMesh) :
+MeshUnStruct::MeshUnStruct(const string &fichierMesh, const bool &cacheGeometrie) :
   Mesh(),
   m_fichierMesh(fichierMesh),
   m_nameMesh(fichierMesh),
+  m_cacheGeometrie(cacheGeometrie),
+  m_empreinteMesh(0),
   m_numberNoeuds(0),
   m_numberNoeudsInternes(0),
   m_numberElementsInternes(0),
@@ -71,6 +80,7 @@ MeshUnStruct::MeshUnStruct(const string &fichierMesh) :
 {
   m_nameMesh = m_fichierMesh;
   m_nameMesh.resize(m_nameMesh.size() - 4); //On enleve l extension
+  m_nameMeshCPU = m_nameMesh;
   m_type = UNS;
 }
 
@@ -115,14 +125,7 @@ int MeshUnStruct::initializeGeometrie(Cell ***cells, CellInterface ***bord, bool
 {
   try {
     if (Ncpu == 1) { this->initializeGeometrieMonoCPU(cells, bord, ordreCalcul); }
-    else {
-      //Pretraitement du file de mesh par le CPU 0
-      if (pretraitementParallele) {
-        if (rankCpu == 0) { this->pretraitementFichierMeshGmsh(); }
-        MPI_Barrier(MPI_COMM_WORLD);
-      }
-      this->initializeGeometrieParallele(cells, bord, ordreCalcul);
-    }
+    else { this->initializeGeometrieParallele(cells, bord, ordreCalcul, pretraitementParallele); }
     return m_geometrie;
   }
   catch (ErrorECOGEN &) { throw; }
@@ -133,10 +136,17 @@ int MeshUnStruct::initializeGeometrie(Cell ***cells, CellInterface ***bord, bool
 void MeshUnStruct::initializeGeometrieMonoCPU(Cell ***cells, CellInterface ***bord, string ordreCalcul)
 {
   try {
-    //1) Lecture noeuds et elements
+    //1) Lecture noeuds et elements (et faces si le cache de geometrie est a jour)
     //-----------------------------
-    vector<ElementNS*>* voisinsNoeuds; //Dimensions : nb_noeuds
-    this->lectureGeometrieGmsh(&voisinsNoeuds);  //Remplissage m_noeuds et m_elements
+    vector<ElementNS*>* voisinsNoeuds(0); //Dimensions : nb_noeuds
+    ifstream fichierCache;
+    bool geometrieEnCache(false);
+    if (m_cacheGeometrie) {
+      this->calculeEmpreinteMesh("./libMeshes/" + m_fichierMesh, false);
+      geometrieEnCache = this->ouvreCacheGeometrie(fichierCache);
+    }
+    if (geometrieEnCache) { geometrieEnCache = this->litCacheGeometrie(fichierCache); }
+    if (!geometrieEnCache) { this->lectureGeometrieGmsh(&voisinsNoeuds); }  //Remplissage m_noeuds et m_elements
 
     //CAUTION: Ordering of m_elements is important. Faces first, then cells.
 
@@ -189,37 +199,40 @@ void MeshUnStruct::initializeGeometrieMonoCPU(Cell ***cells, CellInterface ***bo
       m_numberFacesInternes += m_elements[i + m_numberFacesLimites]->getNumberFaces();
     }
 
-    //-----------Ajout construction voisins des mailles pour ordre 2----------
-    vector<ElementNS *>* voisins; //vecteur temporaire des voisins
-    voisins = new vector<ElementNS *>[m_numberCellsCalcul];
-    for (int i = 0; i < m_numberCellsCalcul; i++)
-    {
-      ElementNS *e(m_elements[i + m_numberFacesLimites]); //choix element
-      //cout << "el " << i + m_numberFacesLimites << " : " ;
-      //vector<ElementNS *> voisins; //vecteur temporaire des voisins
-      //1) Construction du vecteur de voisins
-      for (int n = 0; n < e->getNumberNoeuds(); n++) { //boucle noeud de element e
-        int numNoeud = e->getNumNoeud(n);
-        for (unsigned int v = 0; v < voisinsNoeuds[numNoeud].size(); v++) { //boucle voisin du noeud n
-          bool ajoute(true);
-          if (voisinsNoeuds[numNoeud][v]->getIndex() == e->getIndex()) ajoute = false;
-          //else if(voisinsNoeuds[numNoeud][v]->getIndex() < m_numberFacesLimites) ajoute = false;
-          else {
-            for (unsigned int vo = 0; vo < voisins[i].size(); vo++) {
-              if (voisinsNoeuds[numNoeud][v]->getIndex() == voisins[i][vo]->getIndex()) {
-                ajoute = false; break;
+    if (!geometrieEnCache) {
+      //-----------Ajout construction voisins des mailles pour ordre 2----------
+      vector<ElementNS *>* voisins; //vecteur temporaire des voisins
+      voisins = new vector<ElementNS *>[m_numberCellsCalcul];
+      for (int i = 0; i < m_numberCellsCalcul; i++)
+      {
+        ElementNS *e(m_elements[i + m_numberFacesLimites]); //choix element
+        //cout << "el " << i + m_numberFacesLimites << " : " ;
+        //vector<ElementNS *> voisins; //vecteur temporaire des voisins
+        //1) Construction du vecteur de voisins
+        for (int n = 0; n < e->getNumberNoeuds(); n++) { //boucle noeud de element e
+          int numNoeud = e->getNumNoeud(n);
+          for (unsigned int v = 0; v < voisinsNoeuds[numNoeud].size(); v++) { //boucle voisin du noeud n
+            bool ajoute(true);
+            if (voisinsNoeuds[numNoeud][v]->getIndex() == e->getIndex()) ajoute = false;
+            //else if(voisinsNoeuds[numNoeud][v]->getIndex() < m_numberFacesLimites) ajoute = false;
+            else {
+              for (unsigned int vo = 0; vo < voisins[i].size(); vo++) {
+                if (voisinsNoeuds[numNoeud][v]->getIndex() == voisins[i][vo]->getIndex()) {
+                  ajoute = false; break;
+                }
               }
             }
-          }
-          if (ajoute) {
-            voisins[i].push_back(voisinsNoeuds[numNoeud][v]);
-            //cout << voisinsNoeuds[numNoeud][v]->getIndex() << " ";
+            if (ajoute) {
+              voisins[i].push_back(voisinsNoeuds[numNoeud][v]);
+              //cout << voisinsNoeuds[numNoeud][v]->getIndex() << " ";
+            }
           }
         }
+        //cout << endl;
       }
-      //cout << endl;
+      //------------------------------------------------------------------------
+      delete[] voisins;
     }
-    //------------------------------------------------------------------------
 
     m_numberFacesInternes -= m_numberFacesLimites; //On enleve les limites
     m_numberFacesInternes /= 2; //Les faces internes sont toute comptees 2 fois => on retabli la verite !
@@ -236,56 +249,59 @@ void MeshUnStruct::initializeGeometrieMonoCPU(Cell ***cells, CellInterface ***bo
     //-------------------------------------------
     //Dimensionnement du tableau de faces
     (*bord) = new CellInterface*[m_numberFacesTotal];
-    m_faces = new FaceNS*[m_numberFacesTotal];
-    int **facesTemp; int *sommeNoeudsTemp; //On cre un tableau temporaire de faces pour accelerer la recherche d'existance
-    facesTemp = new int*[m_numberFacesTotal + 1];
-    sommeNoeudsTemp = new int[m_numberFacesTotal + 1];
-    //Determination du number de noeuds max pour les faces
-    int tailleFace; //Sera initialize a la taille maximale
-    if (m_numberElements3D != 0)
-    {
-      if (m_numberQuadrangles != 0) { tailleFace = 4; }
-      else if (m_numberTriangles != 0) { tailleFace = 3; }
-      else { Errors::errorMessage("Probleme dans initializeGeometrieMonoCPU pour initialization du tableau facesTemp"); }
-    }
-    else if (m_numberElements2D != 0) { tailleFace = 2; }
-    else { tailleFace = 1; }
-    for (int i = 0; i < m_numberFacesTotal + 1; i++)
-    {
-      facesTemp[i] = new int[tailleFace];
-    }
-
-    //Faces internes
-    int indexMaxFaces(0);
-    clock_t tTemp(clock());
+    clock_t tTemp;
     float t1(0.);
-    cout << "  1/Building faces ..." << endl;
-    int frequenceImpressure(max((m_numberElements - m_numberFacesLimites) / 10, 1));
-    for (int i = m_numberFacesLimites; i < m_numberElements; i++)
-    {
-      if ((i - m_numberFacesLimites) % frequenceImpressure == 0) { cout << "    " << (100 * (i - m_numberFacesLimites) / (m_numberElements - m_numberFacesLimites)) << "% ... " << endl; }
-      m_elements[i]->construitFaces(m_noeuds, m_faces, indexMaxFaces, facesTemp, sommeNoeudsTemp);
-    }
-    for (int i = 0; i < m_numberFacesTotal + 1; i++) { delete facesTemp[i]; }
-    delete[] facesTemp; delete[] sommeNoeudsTemp;
-    tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
-    cout << "    OK in " << t1 << " seconds" << endl;
+    if (!geometrieEnCache) {
+      m_faces = new FaceNS*[m_numberFacesTotal];
+      int **facesTemp; int *sommeNoeudsTemp; //On cre un tableau temporaire de faces pour accelerer la recherche d'existance
+      facesTemp = new int*[m_numberFacesTotal + 1];
+      sommeNoeudsTemp = new int[m_numberFacesTotal + 1];
+      //Determination du number de noeuds max pour les faces
+      int tailleFace; //Sera initialize a la taille maximale
+      if (m_numberElements3D != 0)
+      {
+        if (m_numberQuadrangles != 0) { tailleFace = 4; }
+        else if (m_numberTriangles != 0) { tailleFace = 3; }
+        else { Errors::errorMessage("Probleme dans initializeGeometrieMonoCPU pour initialization du tableau facesTemp"); }
+      }
+      else if (m_numberElements2D != 0) { tailleFace = 2; }
+      else { tailleFace = 1; }
+      for (int i = 0; i < m_numberFacesTotal + 1; i++)
+      {
+        facesTemp[i] = new int[tailleFace];
+      }
 
-    //Limites
-    cout << "  2/Boundary elements attribution to boundary faces ..." << endl;
-    tTemp = clock();
-    frequenceImpressure = max(m_numberFacesLimites / 10, 1);
-    for (int i = 0; i < m_numberFacesLimites; i++)
-    {
-      if (i%frequenceImpressure == 0)
+      //Faces internes
+      int indexMaxFaces(0);
+      tTemp = clock();
+      cout << "  1/Building faces ..." << endl;
+      int frequenceImpressure(max((m_numberElements - m_numberFacesLimites) / 10, 1));
+      for (int i = m_numberFacesLimites; i < m_numberElements; i++)
       {
-        cout << "    " << (100 * i / m_numberFacesLimites) << "% ... " << endl;// << " -> "; 
+        if ((i - m_numberFacesLimites) % frequenceImpressure == 0) { cout << "    " << (100 * (i - m_numberFacesLimites) / (m_numberElements - m_numberFacesLimites)) << "% ... " << endl; }
+        m_elements[i]->construitFaces(m_noeuds, m_faces, indexMaxFaces, facesTemp, sommeNoeudsTemp);
       }
-      //Attribution de la limite
-      m_elements[i]->attributFaceLimite(m_noeuds, m_faces, indexMaxFaces);
+      for (int i = 0; i < m_numberFacesTotal + 1; i++) { delete facesTemp[i]; }
+      delete[] facesTemp; delete[] sommeNoeudsTemp;
+      tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
+      cout << "    OK in " << t1 << " seconds" << endl;
+
+      //Limites
+      cout << "  2/Boundary elements attribution to boundary faces ..." << endl;
+      tTemp = clock();
+      frequenceImpressure = max(m_numberFacesLimites / 10, 1);
+      for (int i = 0; i < m_numberFacesLimites; i++)
+      {
+        if (i%frequenceImpressure == 0)
+        {
+          cout << "    " << (100 * i / m_numberFacesLimites) << "% ... " << endl;// << " -> "; 
+        }
+        //Attribution de la limite
+        m_elements[i]->attributFaceLimite(m_noeuds, m_faces, indexMaxFaces);
+      }
+      tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
+      cout << "    OK in " << t1 << " seconds" << endl;
     }
-    tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
-    cout << "    OK in " << t1 << " seconds" << endl;
 
     //Liaison Geometrie/Bords de compute
     cout << "  3/Linking Geometries -> Physics ..." << endl;
@@ -317,10 +333,10 @@ void MeshUnStruct::initializeGeometrieMonoCPU(Cell ***cells, CellInterface ***bo
     } //Fin face
     tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
     cout << "    OK in " << t1 << " seconds" << endl;
+    if (m_cacheGeometrie && !geometrieEnCache) { this->ecritCacheGeometrie(); }
     cout << "... BUILDING GEOMETRY COMPLETE " << endl;
     cout << "------------------------------------------------------" << endl;
 
-    delete[] voisins;
     delete[] voisinsNoeuds;
   }
   catch (ErrorECOGEN &) { throw; }
@@ -328,15 +344,48 @@ void MeshUnStruct::initializeGeometrieMonoCPU(Cell ***cells, CellInterface ***bo
 
 //***********************************************************************
 
-void MeshUnStruct::initializeGeometrieParallele(Cell ***cells, CellInterface ***bord, string ordreCalcul)
+void MeshUnStruct::initializeGeometrieParallele(Cell ***cells, CellInterface ***bord, string ordreCalcul, bool pretraitementParallele)
 {
 
   clock_t totalTime(clock());
 
-  //1) Lecture noeuds et elements
+  //Les groupes de CPUs executant des test cases en meme temps ecrivent des files distincts
+  if (pretraitementParallele && groupCpu >= 0) {
+    stringstream flux;
+    flux << m_nameMesh << "_G" << groupCpu;
+    m_nameMeshCPU = flux.str();
+  }
+
+  //1) Lecture noeuds et elements (et faces si le cache de geometrie est a jour sur tous les CPUs)
   //-----------------------------
   try {
-    this->lectureGeometrieGmshParallele(); //Remplissage de m_noeuds et m_elements
+    ifstream fichierCache;
+    bool geometrieEnCache(false);
+    if (m_cacheGeometrie) {
+      //Cle du cache : le file de mesh global quand les files des CPUs en sont construits, sinon le file du CPU
+      if (pretraitementParallele) { this->calculeEmpreinteMesh("./libMeshes/" + m_fichierMesh, true); }
+      else {
+        stringstream flux;
+        flux << rankCpu;
+        this->calculeEmpreinteMesh("./libMeshes/" + m_nameMeshCPU + "_CPU" + flux.str() + ".msh", false);
+      }
+      int cacheValide(this->ouvreCacheGeometrie(fichierCache)), cacheValideTous(0);
+      MPI_Allreduce(&cacheValide, &cacheValideTous, 1, MPI_INT, MPI_MIN, commCompute);
+      geometrieEnCache = (cacheValideTous == 1);
+    }
+    if (geometrieEnCache) {
+      //Cache abandoned on all CPUs if it can not be read on one of them
+      int cacheLu(this->litCacheGeometrie(fichierCache)), cacheLuTous(0);
+      MPI_Allreduce(&cacheLu, &cacheLuTous, 1, MPI_INT, MPI_MIN, commCompute);
+      if (cacheLu && !cacheLuTous) { this->libereGeometrieCache(m_numberElements, m_numberFacesTotal); }
+      geometrieEnCache = (cacheLuTous == 1);
+    }
+    //Pretraitement du file de mesh (chaque CPU construit son propre file), inutile si le cache est a jour
+    if (pretraitementParallele && !geometrieEnCache) {
+      this->pretraitementFichierMeshGmsh();
+      MPI_Barrier(commCompute);
+    }
+    if (!geometrieEnCache) { this->lectureGeometrieGmshParallele(); } //Remplissage de m_noeuds et m_elements
     if (rankCpu == 0)
     {
       cout << "------------------------------------------------------" << endl;
@@ -396,99 +445,102 @@ void MeshUnStruct::initializeGeometrieParallele(Cell ***cells, CellInterface ***
     //---------------------------------------------------
     //Dimensionnement des tableaux de faces
     (*bord) = new CellInterface*[m_numberFacesTotal];
-    m_faces = new FaceNS*[m_numberFacesTotal];
-
-    //On cree un tableau temporaire de faces pour accelerer la recherche d'existance
-    int **facesTemp; int *sommeNoeudsTemp;
-    facesTemp = new int*[m_numberFacesTotal + 1];
-    sommeNoeudsTemp = new int[m_numberFacesTotal + 1];
-    //Determination du number de noeuds max pour les faces
-    int tailleFace; //Sera initialize a la taille maximale
-    if (m_numberElements3D != 0)
-    {
-      if (m_numberQuadrangles != 0) { tailleFace = 4; }
-      else if (m_numberTriangles != 0) { tailleFace = 3; }
-      else { Errors::errorMessage("Probleme dans initializeGeometrieMonoCPU pour initialization du tableau facesTemp"); }
-    }
-    else if (m_numberElements2D != 0) { tailleFace = 2; }
-    else { tailleFace = 1; }
-    for (int i = 0; i < m_numberFacesTotal + 1; i++) // Le +1 est utilise pour la recherche existance de face
-    {
-      facesTemp[i] = new int[tailleFace]; // Inconnue sur le number de points d une face (maxi 4 a priori)
-    }
-
-    //Faces internes
-    //--------------
-    int indexMaxFaces(0);
-    MPI_Barrier(MPI_COMM_WORLD);
     int frequenceImpressure;
-    clock_t tTemp(clock());
+    clock_t tTemp;
     float t1(0.);
-    if (rankCpu == 0)
-    {
-      cout << "  1/Building faces ..." << endl;
-      frequenceImpressure = max((m_numberElementsInternes - m_numberFacesLimites) / 10, 1);
-    }
-    for (int i = m_numberFacesLimites; i < m_numberElementsInternes; i++)
-    {
-      if (rankCpu == 0 && (i - m_numberFacesLimites) % frequenceImpressure == 0) { cout << "    " << (100 * (i - m_numberFacesLimites) / (m_numberElementsInternes - m_numberFacesLimites)) << "% ... " << endl; }
-      //Construction
-      m_elements[i]->construitFaces(m_noeuds, m_faces, indexMaxFaces, facesTemp, sommeNoeudsTemp);
-    }
-    for (int i = 0; i < m_numberFacesTotal + 1; i++) { delete facesTemp[i]; }
-    delete[] facesTemp; delete[] sommeNoeudsTemp;
-    MPI_Barrier(MPI_COMM_WORLD);
-    if (rankCpu == 0)
-    {
-      tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
-      cout << "    OK in " << t1 << " seconds" << endl;
-    }
+    if (!geometrieEnCache) {
+      m_faces = new FaceNS*[m_numberFacesTotal];
+
+      //On cree un tableau temporaire de faces pour accelerer la recherche d'existance
+      int **facesTemp; int *sommeNoeudsTemp;
+      facesTemp = new int*[m_numberFacesTotal + 1];
+      sommeNoeudsTemp = new int[m_numberFacesTotal + 1];
+      //Determination du number de noeuds max pour les faces
+      int tailleFace; //Sera initialize a la taille maximale
+      if (m_numberElements3D != 0)
+      {
+        if (m_numberQuadrangles != 0) { tailleFace = 4; }
+        else if (m_numberTriangles != 0) { tailleFace = 3; }
+        else { Errors::errorMessage("Probleme dans initializeGeometrieMonoCPU pour initialization du tableau facesTemp"); }
+      }
+      else if (m_numberElements2D != 0) { tailleFace = 2; }
+      else { tailleFace = 1; }
+      for (int i = 0; i < m_numberFacesTotal + 1; i++) // Le +1 est utilise pour la recherche existance de face
+      {
+        facesTemp[i] = new int[tailleFace]; // Inconnue sur le number de points d une face (maxi 4 a priori)
+      }
 
-    //Limites
-    //-------
-    tTemp = clock();
-    if (rankCpu == 0)
-    {
-      cout << "  2/Boundary elements attribution to boundary faces ..." << endl;
-      frequenceImpressure = max(m_numberFacesLimites / 10, 1);
-    }
-    for (int i = 0; i < m_numberFacesLimites; i++)
-    {
-      if (rankCpu == 0 && i%frequenceImpressure == 0) { cout << "    " << (100 * i / m_numberFacesLimites) << "% ... " << endl; }
-      //Attribution de la limite
-      m_elements[i]->attributFaceLimite(m_noeuds, m_faces, indexMaxFaces);
-    }
-    MPI_Barrier(MPI_COMM_WORLD);
-    if (rankCpu == 0)
-    {
-      tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
-      cout << "    OK in " << t1 << " seconds" << endl;
-    }
+      //Faces internes
+      //--------------
+      int indexMaxFaces(0);
+      MPI_Barrier(commCompute);
+      tTemp = clock();
+      if (rankCpu == 0)
+      {
+        cout << "  1/Building faces ..." << endl;
+        frequenceImpressure = max((m_numberElementsInternes - m_numberFacesLimites) / 10, 1);
+      }
+      for (int i = m_numberFacesLimites; i < m_numberElementsInternes; i++)
+      {
+        if (rankCpu == 0 && (i - m_numberFacesLimites) % frequenceImpressure == 0) { cout << "    " << (100 * (i - m_numberFacesLimites) / (m_numberElementsInternes - m_numberFacesLimites)) << "% ... " << endl; }
+        //Construction
+        m_elements[i]->construitFaces(m_noeuds, m_faces, indexMaxFaces, facesTemp, sommeNoeudsTemp);
+      }
+      for (int i = 0; i < m_numberFacesTotal + 1; i++) { delete facesTemp[i]; }
+      delete[] facesTemp; delete[] sommeNoeudsTemp;
+      MPI_Barrier(commCompute);
+      if (rankCpu == 0)
+      {
+        tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
+        cout << "    OK in " << t1 << " seconds" << endl;
+      }
 
-    //Communications
-    //--------------
-    tTemp = clock();
-    if (rankCpu == 0)
-    {
-      cout << "  3/Ghost cells attribution to communicating faces ..." << endl;
-      frequenceImpressure = max((m_numberElements - m_numberElementsInternes) / 10, 1);
-    }
-    for (int i = m_numberElementsInternes; i < m_numberElements; i++)
-    {
-      if (rankCpu == 0 && (i - m_numberElementsInternes) % frequenceImpressure == 0) { cout << "    " << (100 * (i - m_numberElementsInternes) / (m_numberElements - m_numberElementsInternes)) << "% ... " << endl; }
-      //Attribution de la limite communicante
-      m_elements[i]->attributFaceCommunicante(m_noeuds, m_faces, indexMaxFaces, m_numberNoeudsInternes);
-    }
-    MPI_Barrier(MPI_COMM_WORLD);
-    if (rankCpu == 0)
-    {
-      tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
-      cout << "    OK in " << t1 << " seconds" << endl;
+      //Limites
+      //-------
+      tTemp = clock();
+      if (rankCpu == 0)
+      {
+        cout << "  2/Boundary elements attribution to boundary faces ..." << endl;
+        frequenceImpressure = max(m_numberFacesLimites / 10, 1);
+      }
+      for (int i = 0; i < m_numberFacesLimites; i++)
+      {
+        if (rankCpu == 0 && i%frequenceImpressure == 0) { cout << "    " << (100 * i / m_numberFacesLimites) << "% ... " << endl; }
+        //Attribution de la limite
+        m_elements[i]->attributFaceLimite(m_noeuds, m_faces, indexMaxFaces);
+      }
+      MPI_Barrier(commCompute);
+      if (rankCpu == 0)
+      {
+        tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
+        cout << "    OK in " << t1 << " seconds" << endl;
+      }
+
+      //Communications
+      //--------------
+      tTemp = clock();
+      if (rankCpu == 0)
+      {
+        cout << "  3/Ghost cells attribution to communicating faces ..." << endl;
+        frequenceImpressure = max((m_numberElements - m_numberElementsInternes) / 10, 1);
+      }
+      for (int i = m_numberElementsInternes; i < m_numberElements; i++)
+      {
+        if (rankCpu == 0 && (i - m_numberElementsInternes) % frequenceImpressure == 0) { cout << "    " << (100 * (i - m_numberElementsInternes) / (m_numberElements - m_numberElementsInternes)) << "% ... " << endl; }
+        //Attribution de la limite communicante
+        m_elements[i]->attributFaceCommunicante(m_noeuds, m_faces, indexMaxFaces, m_numberNoeudsInternes);
+      }
+      MPI_Barrier(commCompute);
+      if (rankCpu == 0)
+      {
+        tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
+        cout << "    OK in " << t1 << " seconds" << endl;
+      }
     }
 
     //Liaison Geometrie/Bords de compute
     //---------------------------------
-    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Barrier(commCompute);
     tTemp = clock();
     if (rankCpu == 0)
     {
@@ -536,7 +588,7 @@ void MeshUnStruct::initializeGeometrieParallele(Cell ***cells, CellInterface ***
       (*cells)[iMailleG]->addBoundary((*bord)[i]);
       (*cells)[iMailleD]->addBoundary((*bord)[i]);
     }
-    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Barrier(commCompute);
     if (rankCpu == 0)
     {
       tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
@@ -545,7 +597,7 @@ void MeshUnStruct::initializeGeometrieParallele(Cell ***cells, CellInterface ***
 
     //4) Construction de la table de connectivite parallele CPUs
     //----------------------------------------------------------
-    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Barrier(commCompute);
     tTemp = clock();
     if (rankCpu == 0)
     {
@@ -596,13 +648,15 @@ void MeshUnStruct::initializeGeometrieParallele(Cell ***cells, CellInterface ***
       parallel.setElementsToReceive(v, buffer, numberElementsARecevoir[v]);
       delete[] buffer;
     }
-    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Barrier(commCompute);
     if (rankCpu == 0)
     {
       tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
       cout << "    OK in " << t1 << " seconds" << endl;
     }
 
+    if (m_cacheGeometrie && !geometrieEnCache) { this->ecritCacheGeometrie(); }
+
     if (rankCpu == 0)
     {
       cout << "... BUILDING GEOMETRY COMPLETE ";
@@ -616,315 +670,516 @@ void MeshUnStruct::initializeGeometrieParallele(Cell ***cells, CellInterface ***
 
 //***********************************************************************
 
+//Dimension of an element from its Gmsh type
+static int dimensionElementGmsh(const int &typeGmsh)
+{
+  if (typeGmsh == 15) return 0;
+  if (typeGmsh == 1) return 1;
+  if (typeGmsh <= 3) return 2;
+  return 3;
+}
+
+//***********************************************************************
+
+//Exchange between all CPUs: envois[p] is sent to CPU p (envois is emptied), the data received are concatenated in the order of the sending CPUs
+template<typename T> static void echangeDonnees(vector< vector<T> > &envois, vector<T> &recus, vector<int> &numberRecus, MPI_Datatype type)
+{
+  vector<int> numberEnvois(Ncpu), deplacementsEnvois(Ncpu), deplacementsRecus(Ncpu);
+  vector<T> tampon;
+  for (int p = 0; p < Ncpu; p++) {
+    numberEnvois[p] = envois[p].size();
+    deplacementsEnvois[p] = tampon.size();
+    tampon.insert(tampon.end(), envois[p].begin(), envois[p].end());
+    vector<T>().swap(envois[p]);
+  }
+  numberRecus.assign(Ncpu, 0);
+  MPI_Alltoall(&numberEnvois[0], 1, MPI_INT, &numberRecus[0], 1, MPI_INT, commCompute);
+  int numberTotal(0);
+  for (int p = 0; p < Ncpu; p++) { deplacementsRecus[p] = numberTotal; numberTotal += numberRecus[p]; }
+  tampon.resize(max(tampon.size(), size_t(1)));
+  recus.assign(max(numberTotal, 1), T());
+  MPI_Alltoallv(&tampon[0], &numberEnvois[0], &deplacementsEnvois[0], type, &recus[0], &numberRecus[0], &deplacementsRecus[0], type, commCompute);
+  recus.resize(numberTotal);
+}
+
+//***********************************************************************
+
+//Error of a CPU shared with the other CPUs: the message of the first CPU in error is thrown on all CPUs so that they stop together
+static void partageErreur(const string &erreur)
+{
+  int cpuErreur(erreur.empty() ? Ncpu : rankCpu), premierCpuErreur(Ncpu);
+  MPI_Allreduce(&cpuErreur, &premierCpuErreur, 1, MPI_INT, MPI_MIN, commCompute);
+  if (premierCpuErreur == Ncpu) return;
+  int taille(erreur.size());
+  MPI_Bcast(&taille, 1, MPI_INT, premierCpuErreur, commCompute);
+  vector<char> message(erreur.begin(), erreur.end());
+  message.resize(taille + 1);
+  MPI_Bcast(&message[0], taille + 1, MPI_CHAR, premierCpuErreur, commCompute);
+  throw ErrorECOGEN(string(&message[0], taille), __FILE__, __LINE__);
+}
+
+//***********************************************************************
+
 void MeshUnStruct::pretraitementFichierMeshGmsh()
 {
-  ElementNS **elementsGlobal;
-  Coord *noeudsGlobal;
-  int frequenceImpressure(0);
-  int numberNoeudsGlobal(0), numberElementsGlobal(0);
-  int numberElements0D(0), numberElements1D(0), numberElements2D(0), numberElements3D(0);
+  int numberNoeudsGlobal(0), numberElementsGlobal(0), numberElementsPart(0), premierElement(0);
+  vector<int> indexesNoeuds;
+  vector<Coord> noeudsPart;
+  vector<int> typeElement, physiqueElement, geometriqueElement, cpuFichierElement, debutNoeudsElement(1, 0), noeudsElement;
 
   try {
-    //Ouverture du file de mesh
-    //-------------------------------------
-    cout << "------------------------------------------------------" << endl;
-    cout << " 0) MESH FILE PRETRAITEMENT " + m_fichierMesh + " IN PROGRESS..." << endl;
+    //Ouverture du file de mesh (chaque CPU en lit une partie)
+    //--------------------------------------------------------
+    if (rankCpu == 0) {
+      cout << "------------------------------------------------------" << endl;
+      cout << " 0) MESH FILE PRETRAITEMENT " + m_fichierMesh + " IN PROGRESS..." << endl;
+    }
     clock_t totalTime(clock());
     m_fichierMesh = "./libMeshes/" + m_fichierMesh;
-    ifstream fichierMesh(m_fichierMesh.c_str(), ios::in);
-    if (!fichierMesh) { throw ErrorECOGEN("file mesh absent :" + m_fichierMesh, __FILE__, __LINE__); }
-    string ligneCourante;
-    getline(fichierMesh, ligneCourante);
-    getline(fichierMesh, ligneCourante);
-    getline(fichierMesh, ligneCourante);
-    getline(fichierMesh, ligneCourante);
-
-    //1) Stockage de la grille de vertex dans tableau temporaire de Noeuds
-    //-------------------------------------------------------
-    cout << "  1/Mesh nodes reading ...";
-    fichierMesh >> numberNoeudsGlobal;
-    fichierMesh.ignore(1, '\n');
-    noeudsGlobal = new Coord[numberNoeudsGlobal];
-    int inutile(0); double x, y, z;
-    for (int i = 0; i < numberNoeudsGlobal; i++)
-    {
-      fichierMesh >> inutile >> x >> y >> z;
-      noeudsGlobal[i].setXYZ(x, y, z);
-    }
-    fichierMesh.ignore(1, '\n');
-    getline(fichierMesh, ligneCourante);
-    getline(fichierMesh, ligneCourante);
-    cout << "OK" << endl;
-
-    //2) Recuperation des elements 1D/2D/3D dans le tableau temporaire d'elements et comptage
-    //----------------------------------------------------------------------------
-    cout << "  2/1D/2D/3D elements reading ...";
-    fichierMesh >> numberElementsGlobal;
-    fichierMesh.ignore(1, '\n');
-    //Allocation tableau d elements
-    elementsGlobal = new ElementNS*[numberElementsGlobal];
-    //Lecture des elements et attributions proprietes geometriques
-    int posDebutElement = static_cast<int>(fichierMesh.tellg()); //reperage debut des elements pour retour rapide
-    for (int i = 0; i < numberElementsGlobal; i++)
-    {
-      this->lectureElementGmshV2(noeudsGlobal, fichierMesh, &elementsGlobal[i]);
-      //Comptage des elements
-      if (elementsGlobal[i]->getTypeGmsh() == 15) { numberElements0D++; }
-      else if (elementsGlobal[i]->getTypeGmsh() == 1) { numberElements1D++; }
-      else if (elementsGlobal[i]->getTypeGmsh() <= 3) { numberElements2D++; }
-      else if (elementsGlobal[i]->getTypeGmsh() <= 7) { numberElements3D++; }
-      else { Errors::errorMessage("Type element du .msh non gere dans ECOGEN"); }
-    }
-    fichierMesh.close();
-
-    //Comptage mailles et limites
-    int numberElementsFrontiere;
-    //Comptage mailles et limites
-    if (numberElements3D == 0 && numberElements2D == 0) //Cas 1D
-    {
-      numberElementsFrontiere = numberElements0D;
-    }
-    else if (numberElements3D == 0) //Cas 2D
-    {
-      numberElementsFrontiere = numberElements1D;
+    string erreur;
+    try {
+      GmshReader lecteur(m_fichierMesh);
+
+      //1) Lecture de la partie des noeuds du CPU
+      //-----------------------------------------
+      if (rankCpu == 0) cout << "  1/Mesh nodes reading ...";
+      numberNoeudsGlobal = lecteur.readNodesPart(rankCpu, Ncpu, indexesNoeuds, noeudsPart);
+      if (rankCpu == 0) cout << "OK" << endl;
+
+      //2) Lecture de la partie des elements 1D/2D/3D du CPU
+      //----------------------------------------------------
+      if (rankCpu == 0) cout << "  2/1D/2D/3D elements reading ...";
+      numberElementsPart = lecteur.startElementsPart(rankCpu, Ncpu, premierElement);
+      GmshReader::ElementGmsh elementGmsh;
+      for (int i = 0; i < numberElementsPart; i++)
+      {
+        lecteur.nextElement(elementGmsh);
+        if (elementGmsh.type == 7) throw ErrorECOGEN("Type d element du file .msh inconnu de ECOGEN", __FILE__, __LINE__);
+        typeElement.push_back(elementGmsh.type);
+        physiqueElement.push_back(elementGmsh.physicalEntity);
+        geometriqueElement.push_back(elementGmsh.geometricalEntity);
+        cpuFichierElement.push_back(elementGmsh.partitions.empty() ? 0 : elementGmsh.partitions[0] - 1);
+        noeudsElement.insert(noeudsElement.end(), elementGmsh.nodes.begin(), elementGmsh.nodes.end());
+        debutNoeudsElement.push_back(noeudsElement.size());
+      }
     }
-    else //Cas 3D
-    {
-      numberElementsFrontiere = numberElements2D;
+    catch (ErrorECOGEN &e) { erreur = e.infosAdditionelles(); }
+    partageErreur(erreur);
+    MPI_Allreduce(&numberElementsPart, &numberElementsGlobal, 1, MPI_INT, MPI_SUM, commCompute);
+
+    //Noeuds envoyes aux CPUs qui les gardent (index du noeud modulo number de CPUs), tries par index
+    vector< vector<int> > indexesEnvoi(Ncpu);
+    vector< vector<double> > coordonneesEnvoi(Ncpu);
+    for (unsigned int n = 0; n < indexesNoeuds.size(); n++) {
+      int p(indexesNoeuds[n] % Ncpu);
+      indexesEnvoi[p].push_back(indexesNoeuds[n]);
+      coordonneesEnvoi[p].push_back(noeudsPart[n].getX());
+      coordonneesEnvoi[p].push_back(noeudsPart[n].getY());
+      coordonneesEnvoi[p].push_back(noeudsPart[n].getZ());
+    }
+    vector<int>().swap(indexesNoeuds);
+    vector<Coord>().swap(noeudsPart);
+    vector<int> indexesRecus, numberRecus;
+    vector<double> coordonneesRecues;
+    echangeDonnees(indexesEnvoi, indexesRecus, numberRecus, MPI_INT);
+    echangeDonnees(coordonneesEnvoi, coordonneesRecues, numberRecus, MPI_DOUBLE);
+    vector< pair<int, int> > ordreNoeuds(indexesRecus.size());
+    for (unsigned int n = 0; n < indexesRecus.size(); n++) { ordreNoeuds[n] = make_pair(indexesRecus[n], n); }
+    sort(ordreNoeuds.begin(), ordreNoeuds.end());
+    vector<int> noeudsGardes(ordreNoeuds.size());
+    vector<double> coordonneesGardees(3 * ordreNoeuds.size());
+    for (unsigned int n = 0; n < ordreNoeuds.size(); n++) {
+      noeudsGardes[n] = ordreNoeuds[n].first;
+      for (int k = 0; k < 3; k++) { coordonneesGardees[3 * n + k] = coordonneesRecues[3 * ordreNoeuds[n].second + k]; }
+    }
+    vector<int>().swap(indexesRecus);
+    vector<double>().swap(coordonneesRecues);
+
+    //Dimension des cells et numerotation des cells dans l ordre du file
+    int dimensionPart(0), dimension(0);
+    for (int i = 0; i < numberElementsPart; i++) { dimensionPart = max(dimensionPart, dimensionElementGmsh(typeElement[i])); }
+    MPI_Allreduce(&dimensionPart, &dimension, 1, MPI_INT, MPI_MAX, commCompute);
+    dimension = max(dimension, 1);
+    vector<int> numeroCell(numberElementsPart, -1);
+    int numberCellsPart(0);
+    for (int i = 0; i < numberElementsPart; i++) {
+      if (dimensionElementGmsh(typeElement[i]) == dimension) numeroCell[i] = numberCellsPart++;
+    }
+    vector<int> premierCellCPU(Ncpu + 1, 0);
+    MPI_Allgather(&numberCellsPart, 1, MPI_INT, &premierCellCPU[1], 1, MPI_INT, commCompute);
+    for (int p = 0; p < Ncpu; p++) { premierCellCPU[p + 1] += premierCellCPU[p]; }
+    for (int i = 0; i < numberElementsPart; i++) {
+      if (numeroCell[i] >= 0) numeroCell[i] += premierCellCPU[rankCpu];
+    }
+    int numberCells(premierCellCPU[Ncpu]);
+
+    if (rankCpu == 0) {
+      cout << "OK" << endl;
+      cout << "  -----------------------------------" << endl;
+      cout << "    MESH GENERAL INFORMATIONS :" << endl;
+      cout << "  -----------------------------------" << endl;
+      cout << "    mesh nodes number : " << numberNoeudsGlobal << endl;
+      cout << "    elements number : " << numberElementsGlobal << endl;
     }
 
-    cout << "OK" << endl;
-    cout << "  -----------------------------------" << endl;
-    cout << "    MESH GENERAL INFORMATIONS :" << endl;
-    cout << "  -----------------------------------" << endl;
-    cout << "    mesh nodes number : " << numberNoeudsGlobal << endl;
-    cout << "    elements number : " << numberElementsGlobal << endl;
-
-    //3)Reperage et attribution par CPU
-    //---------------------------------
-    cout << "  3/Attributing nodes to CPUs ..." << endl;
+    //3) Graphe dual des cells (cells voisines par une face)
+    //------------------------------------------------------
+    if (rankCpu == 0) cout << "  3/Building cells graph ...";
     clock_t tTemp(clock()); float t1(0);
-    frequenceImpressure = max(numberElementsGlobal / 10, 1);
-    vector< vector<int> > noeudsCPU(Ncpu);
-    vector< vector<int> > elementsCPU(Ncpu);
-    int numCPU; int noeudCourant; bool noeudExiste;
-    int numCPUMax(0); //pour verification mesh adapte ou non
-    //Recherche des noeuds formant le mesh interne (hors fantomes) pour chaque CPU
-    for (int i = 0; i < numberElementsGlobal; i++)
-    {
-      if (i%frequenceImpressure == 0) { cout << "    " << 100 * i / numberElementsGlobal << "% ... " << endl; }
-      numCPU = elementsGlobal[i]->getCPU();
-      if (numCPU > numCPUMax) numCPUMax = numCPU;
-      elementsCPU[numCPU].push_back(i); //Remplissage number des elements propres au CPU
-      for (int n = 0; n < elementsGlobal[i]->getNumberNoeuds(); n++)
-      {
-        noeudCourant = elementsGlobal[i]->getNumNoeud(n);
-        noeudExiste = false;
-        for (unsigned int j = 0; j < noeudsCPU[numCPU].size(); j++)
-        {
-          if (noeudsCPU[numCPU][j] == noeudCourant) { noeudExiste = true; break; }
-        }
-        if (!noeudExiste) { noeudsCPU[numCPU].push_back(noeudCourant); }
+    vector<int> xadj, adjncy, cellParent;
+    this->construitGrapheDual(dimension, debutNoeudsElement, noeudsElement, numeroCell, xadj, adjncy, cellParent);
+    if (numberCells < Ncpu) throw ErrorECOGEN("Not enough cells in mesh file for the number of CPU", __FILE__, __LINE__);
+    tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
+    if (rankCpu == 0) cout << "OK in " << t1 << " seconds" << endl;
+
+    //4) Attribution des elements aux CPUs (partitionnement par ECOGEN si le file n est pas partitionne pour le number de CPUs)
+    //-----------------------------------------------------------------------------------------------------------------------
+    int numCPUMaxPart(0), numCPUMaxFichier(0);
+    for (int i = 0; i < numberElementsPart; i++) { numCPUMaxPart = max(numCPUMaxPart, cpuFichierElement[i]); }
+    MPI_Allreduce(&numCPUMaxPart, &numCPUMaxFichier, 1, MPI_INT, MPI_MAX, commCompute);
+    bool partitionne(numCPUMaxFichier != Ncpu - 1);
+    vector<int> cpuCell(numberCellsPart);
+    if (partitionne) { this->partitionneMeshGmsh(xadj, adjncy, premierCellCPU, cpuCell); }
+    else {
+      for (int i = 0; i < numberElementsPart; i++) {
+        if (numeroCell[i] >= 0) cpuCell[numeroCell[i] - premierCellCPU[rankCpu]] = cpuFichierElement[i];
       }
     }
-    int *numberNoeudsInterne = new int[Ncpu];
-    for (int p = 0; p < Ncpu; p++)
-    {
-      numberNoeudsInterne[p] = noeudsCPU[p].size();
+    //CPUs des cells voisines des cells de la partie (et des cells contenant les elements limites), demandes aux CPUs qui les ont lues
+    vector<int> cellsDemandees(adjncy);
+    if (partitionne) {
+      for (int i = 0; i < numberElementsPart; i++) {
+        if (cellParent[i] >= 0) cellsDemandees.push_back(cellParent[i]);
+      }
     }
-    tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
-    cout << "    OK in " << t1 << " seconds" << endl;
-
+    sort(cellsDemandees.begin(), cellsDemandees.end());
+    cellsDemandees.erase(unique(cellsDemandees.begin(), cellsDemandees.end()), cellsDemandees.end());
+    vector< vector<int> > demandes(Ncpu);
+    for (unsigned int c = 0; c < cellsDemandees.size(); c++) {
+      int p(upper_bound(premierCellCPU.begin(), premierCellCPU.end(), cellsDemandees[c]) - premierCellCPU.begin() - 1);
+      demandes[p].push_back(cellsDemandees[c]);
+    }
+    vector<int> demandesRecues, numberDemandesRecues;
+    echangeDonnees(demandes, demandesRecues, numberDemandesRecues, MPI_INT);
+    vector< vector<int> > reponses(Ncpu);
+    for (int p = 0, d = 0; p < Ncpu; p++) {
+      for (int k = 0; k < numberDemandesRecues[p]; k++, d++) { reponses[p].push_back(cpuCell[demandesRecues[d] - premierCellCPU[rankCpu]]); }
+    }
+    vector<int> cpuCellsDemandees, numberReponses;
+    echangeDonnees(reponses, cpuCellsDemandees, numberReponses, MPI_INT); //Dans l ordre de cellsDemandees (parties des CPUs croissantes)
+    vector<int> cpuElement(numberElementsPart);
+    erreur.clear();
+    for (int i = 0; i < numberElementsPart; i++) {
+      if (numeroCell[i] >= 0) { cpuElement[i] = cpuCell[numeroCell[i] - premierCellCPU[rankCpu]]; }
+      else if (!partitionne) { cpuElement[i] = cpuFichierElement[i]; }
+      else if (cellParent[i] >= 0) { cpuElement[i] = cpuCellsDemandees[lower_bound(cellsDemandees.begin(), cellsDemandees.end(), cellParent[i]) - cellsDemandees.begin()]; }
+      else if (erreur.empty()) { erreur = "Boundary element without cell in mesh file"; }
+    }
+    partageErreur(erreur);
     //Verification adaptation au mesh
-    if (numCPUMax != Ncpu - 1) throw ErrorECOGEN("file mesh .msh non adapte au number de CPU - Generer le mesh et relancer le test", __FILE__, __LINE__);
+    vector<int> numberCellsCPUPart(Ncpu + 1, 0), numberCellsCPU(Ncpu + 1, 0);
+    for (int i = 0; i < numberElementsPart; i++) {
+      if (cpuElement[i] < 0 || cpuElement[i] >= Ncpu) numberCellsCPUPart[Ncpu]++;
+      else if (numeroCell[i] >= 0) numberCellsCPUPart[cpuElement[i]]++;
+    }
+    MPI_Allreduce(&numberCellsCPUPart[0], &numberCellsCPU[0], Ncpu + 1, MPI_INT, MPI_SUM, commCompute);
+    if (numberCellsCPU[Ncpu] != 0) throw ErrorECOGEN("file mesh .msh non adapte au number de CPU - Generer le mesh et relancer le test", __FILE__, __LINE__);
+    for (int p = 0; p < Ncpu; p++) {
+      if (numberCellsCPU[p] == 0) throw ErrorECOGEN("file mesh .msh non adapte au number de CPU - Generer le mesh et relancer le test", __FILE__, __LINE__);
+    }
 
-    //4) Creation Tableau de faces
-    //-----------------------------
-    //Test estimation number de faces (approximative)
-    cout << "  4/Creating faces array ..." << endl;
+    //5) Elements et noeuds du CPU : elements propres puis fantomes communicants par une face
+    //---------------------------------------------------------------------------------------
+    if (rankCpu == 0) cout << "  4/Attributing elements and nodes to CPUs ...";
     tTemp = clock();
-    frequenceImpressure = max((numberElementsGlobal - numberElementsFrontiere) / 10, 1);
-    int *numberFacesTemp = new int[Ncpu];
-    int *iMaxFaces = new int[Ncpu];
-    for (int p = 0; p < Ncpu; p++)
-    {
-      iMaxFaces[p] = 0;
-      numberFacesTemp[p] = 0;
-      for (unsigned int i = 0; i < elementsCPU[numCPU].size(); i++)
-      {
-        numberFacesTemp[p] += elementsGlobal[elementsCPU[numCPU][i]]->getNumberFaces();
+    //Elements envoyes a leur CPU et, pour les cells, aux CPUs de leurs voisines sur lesquels elles sont des fantomes communicants
+    //Enregistrement : numero, type, physique, geometrique, CPU, faces communicantes, number d autres CPUs, autres CPUs, noeuds
+    vector< vector<int> > envoisElements(Ncpu);
+    vector< pair<int, int> > autresCPU; //CPU et number de faces communicantes avec ce CPU
+    for (int i = 0; i < numberElementsPart; i++) {
+      autresCPU.clear();
+      if (numeroCell[i] >= 0) {
+        int c(numeroCell[i] - premierCellCPU[rankCpu]);
+        for (int v = xadj[c]; v < xadj[c + 1]; v++) {
+          int autreCPU(cpuCellsDemandees[lower_bound(cellsDemandees.begin(), cellsDemandees.end(), adjncy[v]) - cellsDemandees.begin()]);
+          if (autreCPU == cpuElement[i]) continue;
+          unsigned int a(0);
+          while (a < autresCPU.size() && autresCPU[a].first != autreCPU) a++;
+          if (a == autresCPU.size()) autresCPU.push_back(make_pair(autreCPU, 0));
+          autresCPU[a].second++;
+        }
+        sort(autresCPU.begin(), autresCPU.end());
+      }
+      for (int a = -1; a < static_cast<int>(autresCPU.size()); a++) {
+        vector<int> &envoi(envoisElements[a < 0 ? cpuElement[i] : autresCPU[a].first]);
+        envoi.push_back(premierElement + i);
+        envoi.push_back(typeElement[i]);
+        envoi.push_back(physiqueElement[i]);
+        envoi.push_back(geometriqueElement[i]);
+        envoi.push_back(cpuElement[i]);
+        envoi.push_back(a < 0 ? 0 : autresCPU[a].second);
+        envoi.push_back(autresCPU.size());
+        for (unsigned int b = 0; b < autresCPU.size(); b++) { envoi.push_back(autresCPU[b].first); }
+        envoi.insert(envoi.end(), noeudsElement.begin() + debutNoeudsElement[i], noeudsElement.begin() + debutNoeudsElement[i + 1]);
       }
     }
-    int ***facesTemp2 = new int**[Ncpu];
-    int **sommeNoeudsTemp2 = new int*[Ncpu];
-    for (int p = 0; p < Ncpu; p++)
-    {
-      sommeNoeudsTemp2[p] = new int[numberFacesTemp[p]];
-      facesTemp2[p] = new int*[numberFacesTemp[p]];
-      for (int i = 0; i < numberFacesTemp[p]; i++)
-      {
-        facesTemp2[p][i] = new int[4];
+    vector<int> elementsRecus, numberElementsRecus;
+    echangeDonnees(envoisElements, elementsRecus, numberElementsRecus, MPI_INT);
+    //Elements propres puis fantomes, chacun dans l ordre du file
+    vector< pair<int, int> > elementsPropres, elementsFantomes; //Numero dans le file et position de l enregistrement
+    int numberFacesCommunicantes(0);
+    for (unsigned int d = 0; d < elementsRecus.size(); d += 7 + elementsRecus[d + 6] + GmshReader::numberNodesType(elementsRecus[d + 1])) {
+      if (elementsRecus[d + 4] == rankCpu) { elementsPropres.push_back(make_pair(elementsRecus[d], d)); }
+      else {
+        elementsFantomes.push_back(make_pair(elementsRecus[d], d));
+        numberFacesCommunicantes += elementsRecus[d + 5];
       }
     }
-    for (int i = numberElementsFrontiere; i < numberElementsGlobal; i++)
-    {
-      if ((i - numberElementsFrontiere) % frequenceImpressure == 0) { cout << "    " << (100 * (i - numberElementsFrontiere) / (numberElementsGlobal - numberElementsFrontiere)) << "% ... " << endl; }
-      int numCPU(elementsGlobal[i]->getCPU());
-      elementsGlobal[i]->construitFacesSimplifie(iMaxFaces[numCPU], facesTemp2[numCPU], sommeNoeudsTemp2[numCPU]);
+    sort(elementsPropres.begin(), elementsPropres.end());
+    sort(elementsFantomes.begin(), elementsFantomes.end());
+    vector<int> elementsCPU;
+    for (unsigned int e = 0; e < elementsPropres.size(); e++) { elementsCPU.push_back(elementsPropres[e].second); }
+    for (unsigned int e = 0; e < elementsFantomes.size(); e++) { elementsCPU.push_back(elementsFantomes[e].second); }
+    //Numerotation locale des noeuds dans l ordre de premiere apparition
+    vector<int> noeudsTries;
+    for (unsigned int e = 0; e < elementsCPU.size(); e++) {
+      int d(elementsCPU[e]);
+      int debut(d + 7 + elementsRecus[d + 6]);
+      noeudsTries.insert(noeudsTries.end(), elementsRecus.begin() + debut, elementsRecus.begin() + debut + GmshReader::numberNodesType(elementsRecus[d + 1]));
+    }
+    sort(noeudsTries.begin(), noeudsTries.end());
+    noeudsTries.erase(unique(noeudsTries.begin(), noeudsTries.end()), noeudsTries.end());
+    vector<int> numeroLocalNoeud(noeudsTries.size(), -1);
+    int numberNoeudsCPU(0), numberNoeudsInterne(0);
+    for (unsigned int e = 0; e < elementsCPU.size(); e++) {
+      if (e == elementsPropres.size()) numberNoeudsInterne = numberNoeudsCPU;
+      int d(elementsCPU[e]);
+      int debut(d + 7 + elementsRecus[d + 6]);
+      for (int n = debut; n < debut + GmshReader::numberNodesType(elementsRecus[d + 1]); n++) {
+        int &numero(numeroLocalNoeud[lower_bound(noeudsTries.begin(), noeudsTries.end(), elementsRecus[n]) - noeudsTries.begin()]);
+        if (numero < 0) numero = numberNoeudsCPU++;
+        elementsRecus[n] = numero;
+      }
     }
-    tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
-    cout << "    OK in " << t1 << " seconds" << endl;
-
-    //5)Recherche des elements fantomes qui ont une face commune avec un element interne (communicants)
-    //-------------------------------------------------------------------------------------------------
-    cout << "  5/Looking for ghosts elements ..." << endl;
-    tTemp = clock();
-    frequenceImpressure = max(numberElementsGlobal / 10, 1);
-    int *numberFacesCommunicantesCPU = new int[Ncpu];
-    for (int i = 0; i < Ncpu; i++) { numberFacesCommunicantesCPU[i] = 0; }
-    for (int i = 0; i < numberElementsGlobal; i++)
-    {
-      if (i%frequenceImpressure == 0) { cout << "    " << (100 * i / numberElementsGlobal) << "% ... " << endl; }
-      if (elementsGlobal[i]->getNumberAutresCPU() != 0)
-      {
-        vector<int> CPUAEnlever;
-        for (int p = 0; p < elementsGlobal[i]->getNumberAutresCPU(); p++)
-        {
-          int numCPU(elementsGlobal[i]->getAutreCPU(p));
-          //verification si l element est communicant via une face
-          //******************************************************
-          int numberNoeuds(elementsGlobal[i]->getNumberNoeuds());
-          bool *isNoeudInterne = new bool[numberNoeuds];
-          for (int n = 0; n < numberNoeuds; n++)
-          {
-            isNoeudInterne[n] = false;
-            noeudCourant = elementsGlobal[i]->getNumNoeud(n);
-            for (int j = 0; j < numberNoeudsInterne[numCPU]; j++)
-            {
-              if (noeudsCPU[numCPU][j] == noeudCourant)
-              {
-                isNoeudInterne[n] = true;
-                break;
-              }
-            }
-          }
-          //Determination du number de faces communicantes
-          //**********************************************
-          //int numberFacesCommunicantes(elementsGlobal[i]->compteFaceCommunicante(facesTemp[numCPU],sommeNoeudsTemp[numCPU]));
-          int numberFacesCommunicantes(elementsGlobal[i]->compteFaceCommunicante(iMaxFaces[numCPU], facesTemp2[numCPU], sommeNoeudsTemp2[numCPU]));
-          if (numberFacesCommunicantes > 0)
-          {
-            //L'element est communicant, on l'ajoute ainsi que ces noeuds
-            elementsCPU[numCPU].push_back(i);
-            for (int n = 0; n < numberNoeuds; n++)
-            {
-              if (!isNoeudInterne[n]) { noeudsCPU[numCPU].push_back(elementsGlobal[i]->getNumNoeud(n)); }
-            }
-            numberFacesCommunicantesCPU[numCPU] += numberFacesCommunicantes;
-          }
-          else
-          {
-            CPUAEnlever.push_back(p);
-          }
-          delete[] isNoeudInterne;
-
-        } //Fin CPU
-        elementsGlobal[i]->enleveCPUAutres(CPUAEnlever);
+    if (elementsFantomes.empty()) numberNoeudsInterne = numberNoeudsCPU;
+    //Coordonnees des noeuds demandees aux CPUs qui les gardent
+    for (unsigned int n = 0; n < noeudsTries.size(); n++) { demandes[noeudsTries[n] % Ncpu].push_back(noeudsTries[n]); }
+    echangeDonnees(demandes, demandesRecues, numberDemandesRecues, MPI_INT);
+    vector< vector<double> > coordonneesReponses(Ncpu);
+    erreur.clear();
+    for (int p = 0, d = 0; p < Ncpu; p++) {
+      for (int k = 0; k < numberDemandesRecues[p]; k++, d++) {
+        int n(lower_bound(noeudsGardes.begin(), noeudsGardes.end(), demandesRecues[d]) - noeudsGardes.begin());
+        if (n == static_cast<int>(noeudsGardes.size()) || noeudsGardes[n] != demandesRecues[d]) {
+          if (erreur.empty()) { erreur = "Unknown node in an element of mesh file"; }
+          coordonneesReponses[p].insert(coordonneesReponses[p].end(), 3, 0.);
+        }
+        else { coordonneesReponses[p].insert(coordonneesReponses[p].end(), coordonneesGardees.begin() + 3 * n, coordonneesGardees.begin() + 3 * n + 3); }
       }
     }
-    tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
-    cout << "    OK in " << t1 << " seconds" << endl;
-
-    for (int p = 0; p < Ncpu; p++)
-    {
-      for (int i = 0; i < numberFacesTemp[p]; i++) { delete facesTemp2[p][i]; }
-      delete sommeNoeudsTemp2[p]; delete facesTemp2[p];
+    vector<double> coordonneesRecuesNoeuds;
+    echangeDonnees(coordonneesReponses, coordonneesRecuesNoeuds, numberReponses, MPI_DOUBLE);
+    partageErreur(erreur);
+    vector<Coord> noeudsCPU(numberNoeudsCPU);
+    vector<int> positionReponses(Ncpu, 0);
+    for (int p = 1; p < Ncpu; p++) { positionReponses[p] = positionReponses[p - 1] + numberReponses[p - 1]; }
+    for (unsigned int n = 0; n < noeudsTries.size(); n++) {
+      int &position(positionReponses[noeudsTries[n] % Ncpu]);
+      noeudsCPU[numeroLocalNoeud[n]].setXYZ(coordonneesRecuesNoeuds[position], coordonneesRecuesNoeuds[position + 1], coordonneesRecuesNoeuds[position + 2]);
+      position += 3;
     }
-    delete[]facesTemp2; delete[]sommeNoeudsTemp2;
-    delete[]numberFacesTemp; delete[]iMaxFaces;
+    tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
+    if (rankCpu == 0) cout << "OK in " << t1 << " seconds" << endl;
 
-    //6) Ecriture des fichiers de mesh pour chaque CPU
-    cout << "  6/Printing mesh files for each of " << Ncpu << " CPU ..." << endl;
+    //6) Ecriture du file de mesh du CPU
+    //----------------------------------
+    if (rankCpu == 0) cout << "  5/Printing mesh files for each of " << Ncpu << " CPU ...";
     tTemp = clock();
-    for (int p = 0; p < Ncpu; p++)
-    {
-      stringstream flux;
-      flux << p;
-      string fichierMeshCPU("./libMeshes/" + m_nameMesh + "_CPU" + flux.str() + ".msh");
-      cout << "    print '" << fichierMeshCPU.c_str() << "' in progress ...' " << endl;
-      ofstream fileStream;
-      fileStream.open(fichierMeshCPU.c_str());
-
-      fileStream << "$MeshFormat" << endl;
-      fileStream << "2.2 0 8" << endl;
-      fileStream << "$EndMeshFormat" << endl;
-      fileStream << "$Nodes" << endl;
-      //Reordonne les noeuds
-      //sort(noeudsCPU[p].begin(), noeudsCPU[p].end());
-      fileStream << noeudsCPU[p].size() << endl;
-      for (unsigned int i = 0; i < noeudsCPU[p].size(); i++)
+    stringstream flux;
+    flux << rankCpu;
+    string fichierMeshCPU("./libMeshes/" + m_nameMeshCPU + "_CPU" + flux.str() + ".msh");
+    ofstream fileStream;
+    fileStream.open(fichierMeshCPU.c_str());
+
+    fileStream << "$MeshFormat" << endl;
+    fileStream << "2.2 0 8" << endl;
+    fileStream << "$EndMeshFormat" << endl;
+    fileStream << "$Nodes" << endl;
+    fileStream << noeudsCPU.size() << endl;
+    for (unsigned int i = 0; i < noeudsCPU.size(); i++)
+    {
+      fileStream << i + 1 << " " << noeudsCPU[i].getX() << " " << noeudsCPU[i].getY() << " " << noeudsCPU[i].getZ() << endl;
+    }
+    fileStream << "$EndNodes" << endl;
+    fileStream << "$Elements" << endl;
+    fileStream << elementsCPU.size() << endl;
+    for (unsigned int i = 0; i < elementsCPU.size(); i++)
+    {
+      const int *element(&elementsRecus[elementsCPU[i]]);
+      int numberAutresCPU(element[6]);
+      fileStream << i + 1 << " " << element[1];
+      fileStream << " " << 2 + 1 + 1 + numberAutresCPU;
+      fileStream << " " << element[2];
+      fileStream << " " << element[3];
+      fileStream << " " << numberAutresCPU + 1;
+      fileStream << " " << element[4] + 1;
+      for (int cpuAutre = 0; cpuAutre < numberAutresCPU; cpuAutre++)
       {
-        fileStream << i + 1 << " " << noeudsGlobal[noeudsCPU[p][i]].getX() << " " << noeudsGlobal[noeudsCPU[p][i]].getY() << " " << noeudsGlobal[noeudsCPU[p][i]].getZ() << endl;
+        fileStream << " " << -(element[7 + cpuAutre] + 1);
       }
-      fileStream << "$EndNodes" << endl;
-      fileStream << "$Elements" << endl;
-      fileStream << elementsCPU[p].size() << endl;
-      for (unsigned int i = 0; i < elementsCPU[p].size(); i++)
+      for (int n = 0; n < GmshReader::numberNodesType(element[1]); n++)
       {
-        int e(elementsCPU[p][i]);
-        fileStream << i + 1 << " " << elementsGlobal[e]->getTypeGmsh();
-        fileStream << " " << 2 + 1 + 1 + elementsGlobal[e]->getNumberAutresCPU();
-        fileStream << " " << elementsGlobal[e]->getAppartenancePhysique();
-        fileStream << " " << elementsGlobal[e]->getAppartenanceGeometrique();
-        fileStream << " " << elementsGlobal[e]->getNumberAutresCPU() + 1;
-        fileStream << " " << elementsGlobal[e]->getCPU() + 1;
-        for (int cpuAutre = 0; cpuAutre < elementsGlobal[e]->getNumberAutresCPU(); cpuAutre++)
-        {
-          fileStream << " " << -(elementsGlobal[e]->getAutreCPU(cpuAutre) + 1);
-        }
-        for (int n = 0; n < elementsGlobal[e]->getNumberNoeuds(); n++)
-        {
-          //Renumbering locale
-          noeudCourant = elementsGlobal[e]->getNumNoeud(n);
-          for (int j = 0; j < static_cast<int>(noeudsCPU[p].size()); j++)
-          {
-            if (noeudsCPU[p][j] == noeudCourant)
-            {
-              fileStream << " " << j + 1; break;
-            }
-          }
-        }
-        fileStream << endl;
+        fileStream << " " << element[7 + numberAutresCPU + n] + 1;
       }
-      fileStream << "$EndElements" << endl;
-      //Informations additionelles utiles !!
-      fileStream << "Info non lue par Gmsh : number de faces communicante" << endl;
-      fileStream << numberFacesCommunicantesCPU[p] << endl;
-      fileStream << "Info non lue par Gmsh : number de noeuds internes (hors fantomes)" << endl;
-      fileStream << numberNoeudsInterne[p] << endl;
-      fileStream.close();
-    }
+      fileStream << endl;
+    }
+    fileStream << "$EndElements" << endl;
+    //Informations additionelles utiles !!
+    fileStream << "Info non lue par Gmsh : number de faces communicante" << endl;
+    fileStream << numberFacesCommunicantes << endl;
+    fileStream << "Info non lue par Gmsh : number de noeuds internes (hors fantomes)" << endl;
+    fileStream << numberNoeudsInterne << endl;
+    fileStream.close();
     tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
-    cout << "    OK in " << t1 << " seconds" << endl;
+    if (rankCpu == 0) cout << "OK in " << t1 << " seconds" << endl;
+
+    if (rankCpu == 0) {
+      cout << "... MESH FILE PRETRAITEMENT COMPLETE ";
+      totalTime = clock() - totalTime; t1 = static_cast<float>(totalTime) / CLOCKS_PER_SEC;
+      cout << " Total time of pretraitement : " << t1 << " seconds" << endl;
+      cout << "------------------------------------------------------" << endl;
+    }
+  }
+  catch (ErrorECOGEN &) { throw; }
+}
 
-    cout << "... MESH FILE PRETRAITEMENT COMPLETE ";
-    totalTime = clock() - totalTime; t1 = static_cast<float>(totalTime) / CLOCKS_PER_SEC;
-    cout << " Total time of pretraitement : " << t1 << " seconds" << endl;
+//***********************************************************************
 
-    cout << "------------------------------------------------------" << endl;
+void MeshUnStruct::construitGrapheDual(const int &dimension, const vector<int> &debutNoeudsElement, const vector<int> &noeudsElement, const vector<int> &numeroCell,
+  vector<int> &xadj, vector<int> &adjncy, vector<int> &cellParent) const
+{
+  int numberElementsPart(numeroCell.size());
 
-    //Desallocations
-    for (int i = 0; i < numberElementsGlobal; i++)
-    {
-      delete elementsGlobal[i];
+  //1) Cells around each node, gathered by the CPU keeping the node (sorted by node then by cell)
+  vector< vector<int> > envois(Ncpu);
+  for (int i = 0; i < numberElementsPart; i++) {
+    if (numeroCell[i] < 0) continue;
+    for (int n = debutNoeudsElement[i]; n < debutNoeudsElement[i + 1]; n++) {
+      envois[noeudsElement[n] % Ncpu].push_back(noeudsElement[n]);
+      envois[noeudsElement[n] % Ncpu].push_back(numeroCell[i]);
+    }
+  }
+  vector<int> recus, numberRecus;
+  echangeDonnees(envois, recus, numberRecus, MPI_INT);
+  vector< pair<int, int> > noeudCell(recus.size() / 2);
+  for (unsigned int k = 0; k < noeudCell.size(); k++) { noeudCell[k] = make_pair(recus[2 * k], recus[2 * k + 1]); }
+  vector<int>().swap(recus);
+  sort(noeudCell.begin(), noeudCell.end());
+
+  //2) Cells around the nodes of the elements of the part, sent back by the CPUs keeping the nodes: number of cells then cells for each node
+  vector<int> noeudsPart(noeudsElement);
+  sort(noeudsPart.begin(), noeudsPart.end());
+  noeudsPart.erase(unique(noeudsPart.begin(), noeudsPart.end()), noeudsPart.end());
+  for (unsigned int n = 0; n < noeudsPart.size(); n++) { envois[noeudsPart[n] % Ncpu].push_back(noeudsPart[n]); }
+  echangeDonnees(envois, recus, numberRecus, MPI_INT);
+  for (int p = 0, d = 0; p < Ncpu; p++) {
+    for (int k = 0; k < numberRecus[p]; k++, d++) {
+      vector< pair<int, int> >::iterator debut(lower_bound(noeudCell.begin(), noeudCell.end(), make_pair(recus[d], -1)));
+      vector< pair<int, int> >::iterator fin(debut);
+      while (fin != noeudCell.end() && fin->first == recus[d]) fin++;
+      envois[p].push_back(fin - debut);
+      for (; debut != fin; debut++) { envois[p].push_back(debut->second); }
+    }
+  }
+  vector< pair<int, int> >().swap(noeudCell);
+  vector<int> cellsNoeuds, numberCellsNoeuds;
+  echangeDonnees(envois, cellsNoeuds, numberCellsNoeuds, MPI_INT);
+  //Position of the cells around each node of the part in cellsNoeuds
+  vector<int> positionCPU(Ncpu, 0), debutCellsNoeud(noeudsPart.size());
+  for (int p = 1; p < Ncpu; p++) { positionCPU[p] = positionCPU[p - 1] + numberCellsNoeuds[p - 1]; }
+  for (unsigned int n = 0; n < noeudsPart.size(); n++) {
+    int &position(positionCPU[noeudsPart[n] % Ncpu]);
+    debutCellsNoeud[n] = position;
+    position += 1 + cellsNoeuds[position];
+  }
+  //Compact numbering of the cells around the nodes of the part
+  vector<int> cellsVues;
+  for (unsigned int n = 0; n < noeudsPart.size(); n++) {
+    cellsVues.insert(cellsVues.end(), cellsNoeuds.begin() + debutCellsNoeud[n] + 1, cellsNoeuds.begin() + debutCellsNoeud[n] + 1 + cellsNoeuds[debutCellsNoeud[n]]);
+  }
+  sort(cellsVues.begin(), cellsVues.end());
+  cellsVues.erase(unique(cellsVues.begin(), cellsVues.end()), cellsVues.end());
+  for (unsigned int n = 0; n < noeudsPart.size(); n++) {
+    for (int v = debutCellsNoeud[n] + 1; v <= debutCellsNoeud[n] + cellsNoeuds[debutCellsNoeud[n]]; v++) {
+      cellsNoeuds[v] = lower_bound(cellsVues.begin(), cellsVues.end(), cellsNoeuds[v]) - cellsVues.begin();
+    }
+  }
+
+  //3) Dual graph: two cells are neighbours if they share a face (at least as many nodes as the dimension)
+  //   Other elements: lowest cell containing all their nodes
+  xadj.assign(1, 0); adjncy.clear();
+  cellParent.assign(numberElementsPart, -1);
+  vector<int> noeudsCommuns(cellsVues.size(), 0);
+  vector<int> touches;
+  for (int i = 0; i < numberElementsPart; i++) {
+    for (int n = debutNoeudsElement[i]; n < debutNoeudsElement[i + 1]; n++) {
+      int noeud(lower_bound(noeudsPart.begin(), noeudsPart.end(), noeudsElement[n]) - noeudsPart.begin());
+      for (int v = debutCellsNoeud[noeud] + 1; v <= debutCellsNoeud[noeud] + cellsNoeuds[debutCellsNoeud[noeud]]; v++) {
+        int voisin(cellsNoeuds[v]);
+        if (cellsVues[voisin] == numeroCell[i]) continue;
+        if (noeudsCommuns[voisin] == 0) touches.push_back(voisin);
+        noeudsCommuns[voisin]++;
+      }
     }
-    delete[] elementsGlobal;
-    delete[] noeudsGlobal;
-    delete[] numberNoeudsInterne;
-    delete[] numberFacesCommunicantesCPU;
+    for (unsigned int t = 0; t < touches.size(); t++) {
+      if (numeroCell[i] >= 0) {
+        if (noeudsCommuns[touches[t]] >= dimension) adjncy.push_back(cellsVues[touches[t]]);
+      }
+      else if (noeudsCommuns[touches[t]] == debutNoeudsElement[i + 1] - debutNoeudsElement[i]) {
+        if (cellParent[i] < 0 || cellsVues[touches[t]] < cellParent[i]) cellParent[i] = cellsVues[touches[t]];
+      }
+      noeudsCommuns[touches[t]] = 0;
+    }
+    touches.clear();
+    if (numeroCell[i] >= 0) xadj.push_back(adjncy.size());
+  }
+}
+
+//***********************************************************************
 
+void MeshUnStruct::partitionneMeshGmsh(const vector<int> &xadj, const vector<int> &adjncy, const vector<int> &premierCellCPU, vector<int> &cpuCell) const
+{
+  int numberCellsPart(xadj.size() - 1), numberAdjncyPart(adjncy.size());
+  int numberCells(premierCellCPU[Ncpu]);
+
+  //1) Dual graph gathered on CPU 0 (degrees of the cells then neighbours, in the order of the cells)
+  vector<int> numberCellsCPU(Ncpu), numberAdjncyCPU(Ncpu), deplacementsAdjncy(Ncpu, 0);
+  for (int p = 0; p < Ncpu; p++) { numberCellsCPU[p] = premierCellCPU[p + 1] - premierCellCPU[p]; }
+  MPI_Gather(&numberAdjncyPart, 1, MPI_INT, &numberAdjncyCPU[0], 1, MPI_INT, 0, commCompute);
+  for (int p = 1; p < Ncpu; p++) { deplacementsAdjncy[p] = deplacementsAdjncy[p - 1] + numberAdjncyCPU[p - 1]; }
+  vector<int> degres(max(numberCellsPart, 1)), degresGlobal(rankCpu == 0 ? numberCells : 1);
+  for (int c = 0; c < numberCellsPart; c++) { degres[c] = xadj[c + 1] - xadj[c]; }
+  MPI_Gatherv(&degres[0], numberCellsPart, MPI_INT, &degresGlobal[0], &numberCellsCPU[0], &premierCellCPU[0], MPI_INT, 0, commCompute);
+  vector<int> adjncyPart(adjncy), xadjGlobal(1, 0), adjncyGlobal(rankCpu == 0 ? max(deplacementsAdjncy[Ncpu - 1] + numberAdjncyCPU[Ncpu - 1], 1) : 1);
+  adjncyPart.resize(max(numberAdjncyPart, 1));
+  MPI_Gatherv(&adjncyPart[0], numberAdjncyPart, MPI_INT, &adjncyGlobal[0], &numberAdjncyCPU[0], &deplacementsAdjncy[0], MPI_INT, 0, commCompute);
+
+  //2) Partitioning of the dual graph by CPU 0, then CPU of the cells of the part sent to each CPU
+  vector<int> part(rankCpu == 0 ? numberCells : 1);
+  if (rankCpu == 0) {
+    cout << "  Mesh file not partitioned for " << Ncpu << " CPU: partitioning ...";
+    clock_t tTemp(clock()); float t1(0);
+    for (int c = 0; c < numberCells; c++) { xadjGlobal.push_back(xadjGlobal[c] + degresGlobal[c]); }
+    adjncyGlobal.resize(xadjGlobal[numberCells]);
+    GraphPartitioner partitioner(xadjGlobal, adjncyGlobal);
+    partitioner.partition(Ncpu, part);
+    tTemp = clock() - tTemp; t1 = static_cast<float>(tTemp) / CLOCKS_PER_SEC;
+    cout << "OK in " << t1 << " seconds" << endl;
+    cout << "    edge cut : " << partitioner.computeEdgeCut(part) << " faces / imbalance (max/avg) : " << partitioner.computeImbalance(part, Ncpu) << endl;
   }
-  catch (ErrorECOGEN &) { throw; }
+  cpuCell.resize(max(numberCellsPart, 1));
+  MPI_Scatterv(&part[0], &numberCellsCPU[0], &premierCellCPU[0], MPI_INT, &cpuCell[0], numberCellsPart, MPI_INT, 0, commCompute);
+  cpuCell.resize(numberCellsPart);
 }
 
 //***********************************************************************
@@ -937,29 +1192,44 @@ void MeshUnStruct::lectureGeometrieGmsh(vector<ElementNS*>** voisinsNoeuds)
     cout << "------------------------------------------------------" << endl;
     cout << " A) READING MESH FILE " + m_fichierMesh + " IN PROGRESS..." << endl;
     m_fichierMesh = "./libMeshes/" + m_fichierMesh;
-    ifstream fichierMesh(m_fichierMesh.c_str(), ios::in);
-    if (!fichierMesh){ throw ErrorECOGEN("file mesh absent :" + m_fichierMesh, __FILE__, __LINE__); }
-    string currentLine;
-    getline(fichierMesh, currentLine);
-
-    //Looking for version
-    //-------------------
-    stringstream lineToTreat;
-    double fileVersion;
-    getline(fichierMesh, currentLine);
-    lineToTreat << currentLine;
-    lineToTreat >> fileVersion;
-
-    cout << "  MeshFile format " << fileVersion << endl;
-    if (fileVersion < 4.) { this->readGmshV2(voisinsNoeuds, fichierMesh); }
-    else { 
-      throw ErrorECOGEN("MeshFile version 4 not yet implemented for Gmsh. Please try with v2", __FILE__, __LINE__);
-      this->readGmshV4(voisinsNoeuds, fichierMesh);
-    }
-
-    //Closing file and information printing
-    //-------------------------------------
-    fichierMesh.close();
+    GmshReader lecteur(m_fichierMesh);
+    cout << "  MeshFile format " << lecteur.getVersion() << (lecteur.isBinary() ? " binary" : "") << endl;
+
+    //1) Filling m_noeuds array
+    //-------------------------
+    cout << "  1/Mesh nodes reading ...";
+    lecteur.readNodes(m_numberNoeuds, m_noeuds);
+    *voisinsNoeuds = new vector<ElementNS*>[m_numberNoeuds];
+    cout << "OK" << endl;
+
+    //2) 1D/2D/3D elements are stored in m_elements array / counting
+    //--------------------------------------------------------------
+    cout << "  2/0D/1D/2D/3D elements reading ...";
+    m_numberElements = lecteur.startElements();
+    //Allocation tableau d elements
+    m_elements = new ElementNS*[m_numberElements];
+    //Lecture des elements et attributions proprietes geometriques
+    m_numberElements1D = 0, m_numberElements2D = 0, m_numberElements3D = 0;
+    GmshReader::ElementGmsh elementGmsh;
+    int noeudG;
+    for (int i = 0; i < m_numberElements; i++) {
+      lecteur.nextElement(elementGmsh);
+      this->construitElementGmsh(m_noeuds, elementGmsh, &m_elements[i]);
+      if (m_elements[i]->getTypeGmsh() == 15) { m_numberElements0D++; }
+      else if (m_elements[i]->getTypeGmsh() == 1) { m_numberElements1D++; }
+      else if (m_elements[i]->getTypeGmsh() <= 3) { m_numberElements2D++; m_totalSurface += m_elements[i]->getVolume(); }
+      else if (m_elements[i]->getTypeGmsh() <= 7) { m_numberElements3D++; m_totalVolume += m_elements[i]->getVolume(); }
+      else { throw ErrorECOGEN("Type element du .msh non gere dans ECOGEN", __FILE__, __LINE__); }
+      //Attribution element i voisin pour les noeuds concernes (Ordre 2 muiltislopes)
+      for (int n = 0; n < m_elements[i]->getNumberNoeuds(); n++) {
+        noeudG = m_elements[i]->getNumNoeud(n);
+        (*voisinsNoeuds)[noeudG].push_back(m_elements[i]);
+      }
+    }
+    m_numberElementsInternes = m_numberElements;
+
+    //Information printing
+    //--------------------
     cout << "OK" << endl;
     cout << endl << "  --------------------------" << endl;
     cout << "    MESH INFORMATIONS :" << endl;
@@ -1003,159 +1273,6 @@ void MeshUnStruct::lectureGeometrieGmsh(vector<ElementNS*>** voisinsNoeuds)
 
 //***********************************************************************
 
-void MeshUnStruct::readGmshV2(vector<ElementNS*>** voisinsNoeuds, ifstream &meshFile)
-{
-  try {
-    string currentLine;
-    getline(meshFile, currentLine);
-    getline(meshFile, currentLine);
-
-    //1) Filling m_noeuds array
-    //-------------------------
-    cout << "  1/Mesh nodes reading ...";
-    meshFile >> m_numberNoeuds;
-    meshFile.ignore(1, '\n');
-    m_noeuds = new Coord[m_numberNoeuds];
-    *voisinsNoeuds = new vector<ElementNS*>[m_numberNoeuds];
-    int inutile(0); double x, y, z;
-    for (int i = 0; i < m_numberNoeuds; i++)
-    {
-      meshFile >> inutile >> x >> y >> z;
-      m_noeuds[i].setXYZ(x, y, z);
-    }
-    meshFile.ignore(1, '\n');
-    getline(meshFile, currentLine);
-    getline(meshFile, currentLine);
-    cout << "OK" << endl;
-
-    //2) 1D/2D/3D elements are stored in m_elements array / counting
-    //--------------------------------------------------------------
-    cout << "  2/0D/1D/2D/3D elements reading ...";
-    meshFile >> m_numberElements;
-    meshFile.ignore(1, '\n');
-    //Allocation tableau d elements
-    m_elements = new ElementNS*[m_numberElements];
-    //Lecture des elements et attributions proprietes geometriques
-    m_numberElements1D = 0, m_numberElements2D = 0, m_numberElements3D = 0;
-    int posDebutElement = static_cast<int>(meshFile.tellg()); //reperage debut des elements pour retour rapide
-    int noeudG;
-    for (int i = 0; i < m_numberElements; i++) {
-      this->lectureElementGmshV2(m_noeuds, meshFile, &m_elements[i]);
-      if (m_elements[i]->getTypeGmsh() == 15) { m_numberElements0D++; }
-      else if (m_elements[i]->getTypeGmsh() == 1) { m_numberElements1D++; }
-      else if (m_elements[i]->getTypeGmsh() <= 3) { m_numberElements2D++; m_totalSurface += m_elements[i]->getVolume(); }
-      else if (m_elements[i]->getTypeGmsh() <= 7) { m_numberElements3D++; m_totalVolume += m_elements[i]->getVolume(); }
-      else { throw ErrorECOGEN("Type element du .msh non gere dans ECOGEN", __FILE__, __LINE__); }
-      //Attribution element i voisin pour les noeuds concernes (Ordre 2 muiltislopes)
-      for (int n = 0; n < m_elements[i]->getNumberNoeuds(); n++) {
-        noeudG = m_elements[i]->getNumNoeud(n);
-        (*voisinsNoeuds)[noeudG].push_back(m_elements[i]);
-      }
-    }
-    m_numberElementsInternes = m_numberElements;
-
-    //for (int n = 0; n < m_numberNoeuds; n++) {
-    //  for (int e = 0; e < (*voisinsNoeuds)[n].size(); e++) {
-    //    cout << (*voisinsNoeuds)[n][e]->getIndex() << " ";
-    //  }
-    //  cout << endl;
-    //}
-  }
-  catch (ErrorECOGEN &) { throw; }
-}
-
-//***********************************************************************
-
-void MeshUnStruct::readGmshV4(vector<ElementNS*>** voisinsNoeuds, ifstream &meshFile)
-{
-  try {
-    string currentLine;
-
-    //1) Filling m_noeuds array
-    //-------------------------
-    { 
-      cout << "  1/Mesh nodes reading ...";
-      while (currentLine != "$Nodes") {
-        getline(meshFile, currentLine);
-        if (meshFile.eof()) { throw ErrorECOGEN("Nodes block not found in mesh file", __FILE__, __LINE__); }
-      }
-      int numEntityBlocks;
-      { stringstream lineTotreat;
-      getline(meshFile, currentLine); lineTotreat << currentLine;
-      lineTotreat >> numEntityBlocks >> m_numberNoeuds; }
-      m_noeuds = new Coord[m_numberNoeuds];
-      //Allocate node array
-      *voisinsNoeuds = new vector<ElementNS*>[m_numberNoeuds];
-      //Reading nodes
-      int tagEntity, dimEntity, parametric, numNodesEntity, tag; double x, y, z;
-      for (int e = 0; e < numEntityBlocks; e++) { //Reading entity
-        {stringstream lineTotreat;
-        getline(meshFile, currentLine); lineTotreat << currentLine;
-        lineTotreat >> tagEntity >> dimEntity >> parametric >> numNodesEntity; }
-        for (int i = 0; i < numNodesEntity; i++) {
-          stringstream lineTotreat;
-          getline(meshFile, currentLine); lineTotreat << currentLine;
-          lineTotreat >> tag >> x >> y >> z;
-          m_noeuds[i].setXYZ(x, y, z);
-        }
-      }
-      getline(meshFile, currentLine);
-      if (currentLine != "$EndNodes") { throw ErrorECOGEN("Nodes block not completely read in mesh file", __FILE__, __LINE__); }
-      cout << "OK" << endl;
-    }
-
-    //2) 1D/2D/3D elements are stored in m_elements array / counting
-    //--------------------------------------------------------------
-    {
-      cout << "  2/0D/1D/2D/3D elements reading ...";
-      while (currentLine != "$Elements") {
-        getline(meshFile, currentLine);
-        if (meshFile.eof()) { throw ErrorECOGEN("Elements block not found in mesh file", __FILE__, __LINE__); }
-      }
-      int numEntityBlocks;
-      { stringstream lineTotreat;
-      getline(meshFile, currentLine); lineTotreat << currentLine;
-      lineTotreat >> numEntityBlocks >> m_numberElements; }
-      //Allocate elements array
-      m_elements = new ElementNS*[m_numberElements];
-      //Readin elements and geometrical properties attributions
-      m_numberElements1D = 0, m_numberElements2D = 0, m_numberElements3D = 0;
-      int posDebutElement = static_cast<int>(meshFile.tellg()); //reperage debut des elements pour retour rapide
-      int noeudG;
-      int tagEntity, dimEntity, typeEle, numElementsEntity;
-      int numElement(0);
-      for (int e = 0; e < numEntityBlocks; e++) { //Reading entity
-        {stringstream lineTotreat;
-        getline(meshFile, currentLine); lineTotreat << currentLine;
-        lineTotreat >> tagEntity >> dimEntity >> typeEle >> numElementsEntity; }
-        for (int i = 0; i < numElementsEntity; i++) {
-          this->lectureElementGmshV4(m_noeuds, meshFile, &m_elements[numElement], typeEle,numElement,tagEntity);
-          //Les tags entity ne sont pas bon ni l'ordonancement des faces et cellules => a revoir
-          if (m_elements[numElement]->getTypeGmsh() == 15) { m_numberElements0D++; }
-          else if (m_elements[numElement]->getTypeGmsh() == 1) { m_numberElements1D++; }
-          else if (m_elements[numElement]->getTypeGmsh() <= 3) { m_numberElements2D++; m_totalSurface += m_elements[i]->getVolume(); }
-          else if (m_elements[numElement]->getTypeGmsh() <= 7) { m_numberElements3D++; m_totalVolume += m_elements[i]->getVolume(); }
-          else { throw ErrorECOGEN("Type element du .msh non gere dans ECOGEN", __FILE__, __LINE__); }
-          //Attribution element i voisin pour les noeuds concernes (Ordre 2 muiltislopes)
-          for (int n = 0; n < m_elements[numElement]->getNumberNoeuds(); n++) {
-            noeudG = m_elements[numElement]->getNumNoeud(n);
-            (*voisinsNoeuds)[noeudG].push_back(m_elements[numElement]);
-          }
-          numElement++;
-        }
-      }
-      m_numberElementsInternes = m_numberElements;
-      getline(meshFile, currentLine);
-      if (currentLine != "$EndElements") { throw ErrorECOGEN("Elements block not completely read in mesh file", __FILE__, __LINE__); }
-      cout << "OK" << endl;
-    }
-
-  }
-  catch (ErrorECOGEN &) { throw; }
-}
-
-//***********************************************************************
-
 void MeshUnStruct::lectureGeometrieGmshParallele()
 {
   int numberNoeudsTotal(0), numberElementsTotal(0);
@@ -1167,51 +1284,34 @@ void MeshUnStruct::lectureGeometrieGmshParallele()
     if (rankCpu == 0)
     {
       cout << "------------------------------------------------------" << endl;
-      cout << " A) READING MESH FILE " + m_nameMesh + "_CPUX.msh" + " IN PROGRESS ..." << endl;
+      cout << " A) READING MESH FILE " + m_nameMeshCPU + "_CPUX.msh" + " IN PROGRESS ..." << endl;
     }
     stringstream flux;
     flux << rankCpu;
-    m_fichierMesh = "./libMeshes/" + m_nameMesh + "_CPU" + flux.str() + ".msh";
-    ifstream fichierMesh(m_fichierMesh.c_str(), ios::in);
-    if (!fichierMesh) { throw ErrorECOGEN("file mesh absent :" + m_fichierMesh, __FILE__, __LINE__); }
-    string ligneCourante;
-    getline(fichierMesh, ligneCourante);
-    getline(fichierMesh, ligneCourante);
-    getline(fichierMesh, ligneCourante);
-    getline(fichierMesh, ligneCourante);
+    m_fichierMesh = "./libMeshes/" + m_nameMeshCPU + "_CPU" + flux.str() + ".msh";
+    GmshReader lecteur(m_fichierMesh);
 
     //2) Stockage de la grille de vertex dans tableau m_noeuds
     //-------------------------------------------------------
-    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Barrier(commCompute);
     if (rankCpu == 0) { cout << "  1/Reading mesh nodes ..."; }
-    fichierMesh >> m_numberNoeuds;
-    fichierMesh.ignore(1, '\n');
-    m_noeuds = new Coord[m_numberNoeuds];
-    int inutile(0); double x, y, z;
-    for (int i = 0; i < m_numberNoeuds; i++)
-    {
-      fichierMesh >> inutile >> x >> y >> z;
-      m_noeuds[i].setXYZ(x, y, z);
-    }
-    fichierMesh.ignore(1, '\n');
-    getline(fichierMesh, ligneCourante);
-    getline(fichierMesh, ligneCourante);
+    lecteur.readNodes(m_numberNoeuds, m_noeuds);
     if (rankCpu == 0) { cout << "OK" << endl; }
 
     //3) Recuperation des elements 1D/2D/3D dans le tableau m_elements et comptage
     //----------------------------------------------------------------------------
-    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Barrier(commCompute);
     if (rankCpu == 0) { cout << "  2/Reading internal 1D/2D/3D elements ..."; }
-    fichierMesh >> m_numberElements;
-    fichierMesh.ignore(1, '\n');
+    m_numberElements = lecteur.startElements();
     //Allocation tableau d elements
     m_elements = new ElementNS*[m_numberElements];
     //Lecture des elements et attributions proprietes geometriques
     m_numberElements1D = 0, m_numberElements2D = 0, m_numberElements3D = 0;
-    int posDebutElement = static_cast<int>(fichierMesh.tellg()); //reperage debut des elements pour retour rapide
+    GmshReader::ElementGmsh elementGmsh;
     for (int i = 0; i < m_numberElements; i++)
     {
-      this->lectureElementGmshV2(m_noeuds, fichierMesh, &m_elements[i]);
+      lecteur.nextElement(elementGmsh);
+      this->construitElementGmsh(m_noeuds, elementGmsh, &m_elements[i]);
       if (m_elements[i]->getCPU() == rankCpu)
       {
         if (m_elements[i]->getTypeGmsh() == 1) { m_numberElements1D++; }
@@ -1221,15 +1321,13 @@ void MeshUnStruct::lectureGeometrieGmshParallele()
       }
       else { m_numberElementsFantomes++; }
     }
-    fichierMesh.ignore(1, '\n');
-    getline(fichierMesh, ligneCourante);
     //Lecture informations hors Gmsh
-    getline(fichierMesh, ligneCourante);
-    fichierMesh >> m_numberFacesParallele;
-    fichierMesh.ignore(1, '\n');
-    getline(fichierMesh, ligneCourante);
-    fichierMesh >> m_numberNoeudsInternes;
-    fichierMesh.close();
+    lecteur.endElements();
+    lecteur.skipLine();
+    m_numberFacesParallele = lecteur.readInteger();
+    lecteur.skipLine();
+    lecteur.skipLine();
+    m_numberNoeudsInternes = lecteur.readInteger();
     //Calcul du number d'elements propres au CPU
     m_numberElementsInternes = m_numberElements - m_numberElementsFantomes;
     if (rankCpu == 0) { cout << "OK" << endl; }
@@ -1239,34 +1337,26 @@ void MeshUnStruct::lectureGeometrieGmshParallele()
 
 //***********************************************************************
 
-void MeshUnStruct::lectureElementGmshV2(const Coord *TableauNoeuds, ifstream &fichierMesh, ElementNS **element)
+void MeshUnStruct::construitElementGmsh(const Coord *TableauNoeuds, const GmshReader::ElementGmsh &elementGmsh, ElementNS **element)
 {
-  int numberElement,numberTags,typeElement,numberEntitePhysique,numberEntiteGeometrique;
-  bool creeElement(true);
-  fichierMesh >> numberElement >> typeElement;
-  //Lecture des tags
-  fichierMesh >> numberTags;
-  fichierMesh >> numberEntitePhysique;    //Appartenance physique
-  fichierMesh >> numberEntiteGeometrique; //Appartenance geometrique
-
   //1)Affectation du number de vertex selon element
   //----------------------------------------------
-  switch (typeElement)
+  switch (elementGmsh.type)
   {
     case 1: //segment (deux points)
-      *element = new ElementSegment;// cout << "segment trouve" << endl;
+      *element = new ElementSegment;
       m_numberSegments++;
       break;
     case 2: //triangle (trois points)
-      *element = new ElementTriangle;// cout << "triangle trouve" << endl;
+      *element = new ElementTriangle;
       m_numberTriangles++;
       break;
     case 3: //Quadrangle (quatre points)
-      *element = new ElementQuadrangle;// cout << "quadrangle trouve" << endl;
+      *element = new ElementQuadrangle;
       m_numberQuadrangles++;
       break;
     case 4: //Tetrahedron (quatre points)
-      *element = new ElementTetrahedron;// cout << "tetraedre trouve" << endl;
+      *element = new ElementTetrahedron;
       m_numberTetrahedrons++;
       break;
     //case 7: //Pyramid quadrangulaire (cinq points) // Ce type d'element semble ne pas fonctionner avec GMSH, les volumes des elements du mesh semblent poser probleme...
@@ -1274,128 +1364,268 @@ void MeshUnStruct::lectureElementGmshV2(const Coord *TableauNoeuds, ifstream &fi
     //  m_numberPyramids++;
     //  break;
     case 15: //Point (un vertex)
-      *element = new ElementPoint; // cout << "vertex trouve" << endl;
+      *element = new ElementPoint;
       m_numberPoints++;
       break;
     case 5: //Hexahedron (huit points)
-      *element = new ElementHexahedron; // cout << "Hexahedron trouve" << endl;
+      *element = new ElementHexahedron;
       m_numberHexahedrons++;
       break;
     case 6: //Prism (six points)
-      *element = new ElementPrism; // cout << "Hexahedron trouve" << endl;
+      *element = new ElementPrism;
       m_numberHexahedrons++;
       break;
     default:
-      Errors::errorMessage("Type d element du file .msh inconnu de ECOGEN");
+      throw ErrorECOGEN("Type d element du file .msh inconnu de ECOGEN", __FILE__, __LINE__);
       break;
   } //Fin switch typeElement
- 
+
   //2) Specificite meshs paralleles
   //-----------------------------------
-  int numberCPU(0);
-  if (numberTags > 2)
+  if (!elementGmsh.partitions.empty())
   {
-    fichierMesh >> numberCPU; //number de partition de mesh auquel appartient l element
-    int *numCPU = new int[numberCPU];
-    for (int tag = 0; tag < numberCPU; tag++){ fichierMesh >> numCPU[tag]; }
-    (*element)->setAppartenanceCPU(numCPU, numberCPU);
-    delete[] numCPU;
+    (*element)->setAppartenanceCPU(elementGmsh.partitions.data(), static_cast<int>(elementGmsh.partitions.size()));
   }
 
   //3) Construction de l'element et de ses proprietes
   //-------------------------------------------------
-  int noeudCourant;
-  int *numNoeud = new int[(*element)->getNumberNoeuds()];
-  Coord *noeud = new Coord[(*element)->getNumberNoeuds()];
-  for (int i = 0; i < (*element)->getNumberNoeuds(); i++)
-  {
-    fichierMesh >> noeudCourant;
-    numNoeud[i] = noeudCourant-1;         //decalage car tableau commencant a zero
-    noeud[i] = TableauNoeuds[noeudCourant - 1];
-  }
-  int indexElement(numberElement - 1);
-  (*element)->construitElement(numNoeud, noeud, numberEntitePhysique, numberEntiteGeometrique, indexElement);
-
+  int numberNoeuds((*element)->getNumberNoeuds());
+  Coord *noeud = new Coord[numberNoeuds];
+  for (int i = 0; i < numberNoeuds; i++) { noeud[i] = TableauNoeuds[elementGmsh.nodes[i]]; }
+  int indexElement(elementGmsh.number - 1);
+  (*element)->construitElement(elementGmsh.nodes.data(), noeud, elementGmsh.physicalEntity, elementGmsh.geometricalEntity, indexElement);
   delete[] noeud;
-  delete[] numNoeud;
-  
 }
 
 //***********************************************************************
 
-void MeshUnStruct::lectureElementGmshV4(const Coord *TableauNoeuds, ifstream &fichierMesh, ElementNS **element, const int &typeElement, int &indiceElement, const int & physicalEntity)
+string MeshUnStruct::nameFichierCache() const
+{
+  stringstream flux;
+  flux << "./libMeshes/" << m_nameMesh;
+  if (groupCpu >= 0) flux << "_G" << groupCpu;
+  flux << "_geometryCache_" << Ncpu << "CPU_" << rankCpu << ".bin";
+  return flux.str();
+}
+
+//***********************************************************************
+
+void MeshUnStruct::calculeEmpreinteMesh(const string &fichierMesh, const bool &partage)
+{
+  if (!partage) {
+    GmshReader lecteur(fichierMesh);
+    m_empreinteMesh = lecteur.computeHash();
+    return;
+  }
+  //File global : lu par le CPU 0 seulement
+  string erreur;
+  unsigned long long empreinte(0);
+  if (rankCpu == 0) {
+    try {
+      GmshReader lecteur(fichierMesh);
+      empreinte = lecteur.computeHash();
+    }
+    catch (ErrorECOGEN &e) { erreur = e.infosAdditionelles(); }
+  }
+  partageErreur(erreur);
+  MPI_Bcast(&empreinte, 1, MPI_UNSIGNED_LONG_LONG, 0, commCompute);
+  m_empreinteMesh = empreinte;
+}
+
+//***********************************************************************
+
+bool MeshUnStruct::ouvreCacheGeometrie(ifstream &fileStream)
 {
   try {
-    //1)Number of vertex affectation
-    //------------------------------
-    switch (typeElement)
-    {
-    case 1: //segment (deux points)
-      *element = new ElementSegment;
-      m_numberSegments++;
-      break;
-    case 2: //triangle (trois points)
-      *element = new ElementTriangle;
-      m_numberTriangles++;
-      break;
-    case 3: //Quadrangle (quatre points)
-      *element = new ElementQuadrangle;
-      m_numberQuadrangles++;
-      break;
-    case 4: //Tetrahedron (quatre points)
-      *element = new ElementTetrahedron;
-      m_numberTetrahedrons++;
-      break;
-    case 7: //Pyramid quadrangulaire (cinq points)
-      *element = new ElementPyramid;
-      m_numberPyramids++;
-      break;
-    case 15: //Point (un vertex)
-      *element = new ElementPoint;
-      m_numberPoints++;
-      break;
-    case 5: //Hexahedron (huit points)
-      *element = new ElementHexahedron;
-      m_numberHexahedrons++;
-      break;
-    case 6: //Prism (six points)
-      *element = new ElementPrism;
-      m_numberHexahedrons++;
-      break;
-    default:
-      throw ErrorECOGEN("Element type unknown in mesh file", __FILE__, __LINE__);
-      break;
-    } //Fin switch typeElement
-
-    //2) Element building / properties filling
-    //----------------------------------------
-    int noeudCourant, tag;
-    int *numNoeud = new int[(*element)->getNumberNoeuds()];
-    Coord *noeud = new Coord[(*element)->getNumberNoeuds()];
-    string currentLine;
-    stringstream lineTotreat;
-    getline(fichierMesh, currentLine); lineTotreat << currentLine;
-    lineTotreat >> tag;
-    for (int i = 0; i < (*element)->getNumberNoeuds(); i++)
-    {
-      lineTotreat >> noeudCourant;
-      numNoeud[i] = noeudCourant - 1;         //decalage car tableau commencant a zero
-      noeud[i] = TableauNoeuds[noeudCourant - 1];
+    //Cle du cache : empreinte du file de mesh et number de CPUs (le groupe de CPUs est dans le name du file)
+    string file(nameFichierCache());
+    fileStream.open(file.c_str(), ios::in | ios::binary);
+    if (!fileStream) { return false; }
+    char identifiant[sizeof(identifiantCache)];
+    int entiers[6];
+    uint64_t empreinte(0);
+    fileStream.read(identifiant, sizeof(identifiant));
+    fileStream.read(reinterpret_cast<char*>(entiers), sizeof(entiers));
+    fileStream.read(reinterpret_cast<char*>(&empreinte), sizeof(empreinte));
+    if (!fileStream || memcmp(identifiant, identifiantCache, sizeof(identifiantCache)) != 0 || entiers[0] != versionCache || entiers[1] != testEndianCache
+      || entiers[2] != Ncpu || entiers[3] != rankCpu || entiers[4] != sizeof(int) || entiers[5] != sizeof(double) || empreinte != m_empreinteMesh) {
+      fileStream.close();
+      if (rankCpu == 0) cout << "  Geometry cache " << file << " obsolete, the geometry is built again" << endl;
+      return false;
     }
-    (*element)->construitElement(numNoeud, noeud, physicalEntity, 0, indiceElement);
-
-    delete[] noeud;
-    delete[] numNoeud;
+    return true;
   }
   catch (ErrorECOGEN &) { throw; }
+}
+
+//***********************************************************************
+
+bool MeshUnStruct::litCacheGeometrie(ifstream &fileStream)
+{
+  if (rankCpu == 0) {
+    cout << "------------------------------------------------------" << endl;
+    cout << " A) READING GEOMETRY CACHE " + nameFichierCache() + " IN PROGRESS..." << endl;
+  }
+  clock_t tTemp(clock());
+
+  //1) Compteurs (le reste du file doit pouvoir contenir au moins les noeuds et l'entier de tete de chaque element et de chaque face)
+  //------------
+  int compteurs[18];
+  double totaux[2];
+  fileStream.read(reinterpret_cast<char*>(compteurs), sizeof(compteurs));
+  fileStream.read(reinterpret_cast<char*>(totaux), sizeof(totaux));
+  if (!fileStream) { return this->abandonneCacheGeometrie(fileStream, 0, 0); }
+  streampos position(fileStream.tellg());
+  fileStream.seekg(0, ios::end);
+  long long tailleRestante(static_cast<long long>(fileStream.tellg() - position));
+  fileStream.seekg(position);
+  for (int i = 0; i < 18; i++) { if (compteurs[i] < 0) return this->abandonneCacheGeometrie(fileStream, 0, 0); }
+  if (3 * static_cast<long long>(compteurs[0])*static_cast<long long>(sizeof(double)) + (static_cast<long long>(compteurs[2]) + compteurs[17])*static_cast<long long>(sizeof(int)) > tailleRestante) {
+    return this->abandonneCacheGeometrie(fileStream, 0, 0);
+  }
+  m_numberNoeuds = compteurs[0]; m_numberNoeudsInternes = compteurs[1];
+  m_numberElements = compteurs[2]; m_numberElementsInternes = compteurs[3]; m_numberElementsFantomes = compteurs[4];
+  m_numberElements0D = compteurs[5]; m_numberElements1D = compteurs[6]; m_numberElements2D = compteurs[7]; m_numberElements3D = compteurs[8];
+  m_numberSegments = compteurs[9]; m_numberTriangles = compteurs[10]; m_numberQuadrangles = compteurs[11]; m_numberTetrahedrons = compteurs[12];
+  m_numberPyramids = compteurs[13]; m_numberPoints = compteurs[14]; m_numberHexahedrons = compteurs[15];
+  m_numberFacesParallele = compteurs[16]; m_numberFacesTotal = compteurs[17];
+  m_totalSurface = totaux[0]; m_totalVolume = totaux[1];
+
+  //2) Noeuds
+  //---------
+  vector<double> coordonnees(3 * static_cast<size_t>(m_numberNoeuds));
+  fileStream.read(reinterpret_cast<char*>(coordonnees.data()), coordonnees.size()*sizeof(double));
+  if (!fileStream) { return this->abandonneCacheGeometrie(fileStream, 0, 0); }
+  m_noeuds = new Coord[m_numberNoeuds];
+  for (int n = 0; n < m_numberNoeuds; n++) { m_noeuds[n].setXYZ(coordonnees[3 * n], coordonnees[3 * n + 1], coordonnees[3 * n + 2]); }
+
+  //3) Elements (le type est lu pour creer l'element)
+  //-------------------------------------------------
+  m_elements = new ElementNS*[m_numberElements];
+  int type;
+  for (int e = 0; e < m_numberElements; e++) {
+    fileStream.read(reinterpret_cast<char*>(&type), sizeof(int));
+    if (!fileStream) { return this->abandonneCacheGeometrie(fileStream, e, 0); }
+    switch (type) {
+      case 1: m_elements[e] = new ElementSegment; break;
+      case 2: m_elements[e] = new ElementTriangle; break;
+      case 3: m_elements[e] = new ElementQuadrangle; break;
+      case 4: m_elements[e] = new ElementTetrahedron; break;
+      case 5: m_elements[e] = new ElementHexahedron; break;
+      case 6: m_elements[e] = new ElementPrism; break;
+      case 7: m_elements[e] = new ElementPyramid; break;
+      case 15: m_elements[e] = new ElementPoint; break;
+      default: return this->abandonneCacheGeometrie(fileStream, e, 0);
+    }
+    if (!m_elements[e]->litCache(fileStream, m_numberNoeuds, Ncpu)) { return this->abandonneCacheGeometrie(fileStream, e + 1, 0); }
+  }
+
+  //4) Faces (le number de noeuds est lu pour creer la face)
+  //--------------------------------------------------------
+  m_faces = new FaceNS*[m_numberFacesTotal];
+  int numberNoeuds;
+  for (int f = 0; f < m_numberFacesTotal; f++) {
+    fileStream.read(reinterpret_cast<char*>(&numberNoeuds), sizeof(int));
+    if (!fileStream) { return this->abandonneCacheGeometrie(fileStream, m_numberElements, f); }
+    switch (numberNoeuds) {
+      case 1: m_faces[f] = new FacePoint(0); break;
+      case 2: m_faces[f] = new FaceSegment(0, 0, 0); break;
+      case 3: m_faces[f] = new FaceTriangle(0, 0, 0, 0); break;
+      case 4: m_faces[f] = new FaceQuadrangle(0, 0, 0, 0, 0); break;
+      default: return this->abandonneCacheGeometrie(fileStream, m_numberElements, f);
+    }
+    if (!m_faces[f]->litCache(fileStream, m_elements, m_numberElements, m_numberNoeuds)) { return this->abandonneCacheGeometrie(fileStream, m_numberElements, f + 1); }
+  }
+  //Le file doit etre entierement lu
+  if (fileStream.peek() != char_traits<char>::eof()) { return this->abandonneCacheGeometrie(fileStream, m_numberElements, m_numberFacesTotal); }
+  fileStream.close();
+
+  if (rankCpu == 0) {
+    float t1(static_cast<float>(clock() - tTemp) / CLOCKS_PER_SEC);
+    cout << "    mesh nodes number : " << m_numberNoeuds << ", elements number : " << m_numberElements << ", faces number : " << m_numberFacesTotal << endl;
+    cout << "... READING GEOMETRY CACHE COMPLETE in " << t1 << " seconds" << endl;
+  }
+  return true;
+}
+
+//***********************************************************************
+
+bool MeshUnStruct::abandonneCacheGeometrie(ifstream &fileStream, const int &numberElementsLus, const int &numberFacesLues)
+{
+  if (fileStream.is_open()) fileStream.close();
+  cout << "  Geometry cache " << nameFichierCache() << " truncated or corrupted, the geometry is built again" << endl;
+  this->libereGeometrieCache(numberElementsLus, numberFacesLues);
+  return false;
+}
 
+//***********************************************************************
+
+void MeshUnStruct::libereGeometrieCache(const int &numberElementsLus, const int &numberFacesLues)
+{
+  for (int f = 0; f < numberFacesLues; f++) { delete m_faces[f]; }
+  delete[] m_faces; m_faces = 0;
+  for (int e = 0; e < numberElementsLus; e++) { delete m_elements[e]; }
+  delete[] m_elements; m_elements = 0;
+  delete[] m_noeuds; m_noeuds = 0;
+  //Les compteurs sont cumules par la lecture du file de mesh qui prend le relais
+  m_numberNoeuds = 0; m_numberNoeudsInternes = 0;
+  m_numberElements = 0; m_numberElementsInternes = 0; m_numberElementsFantomes = 0;
+  m_numberElements0D = 0; m_numberElements1D = 0; m_numberElements2D = 0; m_numberElements3D = 0;
+  m_numberSegments = 0; m_numberTriangles = 0; m_numberQuadrangles = 0; m_numberTetrahedrons = 0;
+  m_numberPyramids = 0; m_numberPoints = 0; m_numberHexahedrons = 0;
+  m_numberFacesParallele = 0; m_numberFacesTotal = 0;
+  m_totalSurface = 0.; m_totalVolume = 0.;
+}
+
+//***********************************************************************
+
+void MeshUnStruct::ecritCacheGeometrie() const
+{
+  //Les faces referencent leurs elements par leur index : il doit correspondre a leur position dans m_elements
+  for (int e = 0; e < m_numberElements; e++) {
+    if (m_elements[e]->getIndex() != e) {
+      if (rankCpu == 0) cout << "  Warning: mesh elements not numbered consecutively, geometry cache not printed" << endl;
+      return;
+    }
+  }
+  string file(nameFichierCache());
+  ofstream fileStream(file.c_str(), ios::out | ios::binary | ios::trunc);
+  if (!fileStream) {
+    if (rankCpu == 0) cout << "  Warning: geometry cache file can not be opened : " << file << endl;
+    return;
+  }
+
+  //1) Entete et compteurs
+  //----------------------
+  int entiers[6] = { versionCache, testEndianCache, Ncpu, rankCpu, static_cast<int>(sizeof(int)), static_cast<int>(sizeof(double)) };
+  int compteurs[18] = { m_numberNoeuds, m_numberNoeudsInternes, m_numberElements, m_numberElementsInternes, m_numberElementsFantomes,
+    m_numberElements0D, m_numberElements1D, m_numberElements2D, m_numberElements3D,
+    m_numberSegments, m_numberTriangles, m_numberQuadrangles, m_numberTetrahedrons, m_numberPyramids, m_numberPoints, m_numberHexahedrons,
+    m_numberFacesParallele, m_numberFacesTotal };
+  double totaux[2] = { m_totalSurface, m_totalVolume };
+  fileStream.write(identifiantCache, sizeof(identifiantCache));
+  fileStream.write(reinterpret_cast<const char*>(entiers), sizeof(entiers));
+  fileStream.write(reinterpret_cast<const char*>(&m_empreinteMesh), sizeof(m_empreinteMesh));
+  fileStream.write(reinterpret_cast<const char*>(compteurs), sizeof(compteurs));
+  fileStream.write(reinterpret_cast<const char*>(totaux), sizeof(totaux));
+
+  //2) Noeuds, elements et faces
+  //----------------------------
+  vector<double> coordonnees(3 * static_cast<size_t>(m_numberNoeuds));
+  for (int n = 0; n < m_numberNoeuds; n++) {
+    coordonnees[3 * n] = m_noeuds[n].getX(); coordonnees[3 * n + 1] = m_noeuds[n].getY(); coordonnees[3 * n + 2] = m_noeuds[n].getZ();
+  }
+  fileStream.write(reinterpret_cast<const char*>(coordonnees.data()), coordonnees.size()*sizeof(double));
+  for (int e = 0; e < m_numberElements; e++) { m_elements[e]->ecritCache(fileStream); }
+  for (int f = 0; f < m_numberFacesTotal; f++) { m_faces[f]->ecritCache(fileStream); }
+  if (!fileStream && rankCpu == 0) { cout << "  Warning: geometry cache file printing failed : " << file << endl; }
 }
 
 //**************************************************************************
 //******************************** ECRITURE ********************************
 //**************************************************************************
 
-void MeshUnStruct::ecritHeaderPiece(std::ofstream &fileStream, std::vector<Cell *> *cellsLvl, int lvl) const
+void MeshUnStruct::ecritHeaderPiece(std::ostream &fileStream, std::vector<Cell *> *cellsLvl, int lvl) const
 {
   fileStream << "    <Piece NumberOfPoints=\"" << m_numberNoeuds << "\" NumberOfCells=\"" << m_numberCellsCalcul - m_numberCellsFantomes << "\">" << endl;
 }
@@ -41,12 +41,15 @@
 
 #include "Mesh.h"
 #include "MeshUnStruct/HeaderElements.h"
+#include "MeshUnStruct/GmshReader.h"
 #include "../InputOutput/IO.h"
 
 class MeshUnStruct : public Mesh
 {
 public:
-  MeshUnStruct(const std::string &fichierMesh);
+  //! \param     fichierMesh      mesh file at Gmsh format, in the folder libMeshes
+  //! \param     cacheGeometrie   if true, the built geometry (nodes, elements, faces) is stored in a binary cache file per CPU and reused by the next runs on the same mesh
+  MeshUnStruct(const std::string &fichierMesh, const bool &cacheGeometrie = false);
   ~MeshUnStruct();
 
   virtual void attributLimites(std::vector<BoundCond*> &boundCond);
@@ -55,7 +58,7 @@ public:
   virtual std::string whoAmI() const { return 0; };
 
   //Printing / Reading
-  virtual void ecritHeaderPiece(std::ofstream &fileStream, std::vector<Cell *> *cellsLvl, int lvl = 0) const;
+  virtual void ecritHeaderPiece(std::ostream &fileStream, std::vector<Cell *> *cellsLvl, int lvl = 0) const;
   virtual void recupereNoeuds(std::vector<double> &jeuDonnees, int lvl = 0) const;
   virtual void recupereConnectivite(std::vector<double> &jeuDonnees, int lvl = 0) const;
   virtual void recupereOffsets(std::vector<double> &jeuDonnees, int lvl = 0) const;
@@ -66,17 +69,54 @@ public:
 
 private:
   virtual void initializeGeometrieMonoCPU(Cell ***cells, CellInterface ***bord, std::string ordreCalcul);
-  virtual void initializeGeometrieParallele(Cell ***cells, CellInterface ***bord, std::string ordreCalcul);
+  //! \brief     Geometry of the CPU, the pretraitement of the global mesh file is skipped when the geometry cache is valid on all CPUs
+  virtual void initializeGeometrieParallele(Cell ***cells, CellInterface ***bord, std::string ordreCalcul, bool pretraitementParallele);
+  //! \brief     Pretraitement of the global mesh file: each CPU writes its own mesh file (internal elements + communicating ghosts)
+  //! \details   The reading is shared: each CPU reads a part of the nodes and of the elements. A node is kept by the CPU of index
+  //!            (node index modulo number of CPUs), which answers the requests about it (cells around the node, coordinates).
   void pretraitementFichierMeshGmsh();
+  //! \brief     Dual graph of the cells (neighbours by a face) of the part of the elements read by the CPU
+  //! \details   The cells around the nodes are gathered by the CPUs keeping the nodes and sent back to the CPUs reading elements with these nodes
+  //! \param     dimension        dimension of the cells
+  //! \param     debutNoeudsElement, noeudsElement   nodes of the elements of the part (compressed storage)
+  //! \param     numeroCell       number of each element of the part among the cells of the mesh (-1 if not a cell)
+  //! \param     xadj, adjncy     neighbour cells of the cells of the part (compressed storage)
+  //! \param     cellParent       for the other elements, lowest number of the cells containing all their nodes (-1 if none)
+  void construitGrapheDual(const int &dimension, const std::vector<int> &debutNoeudsElement, const std::vector<int> &noeudsElement, const std::vector<int> &numeroCell,
+    std::vector<int> &xadj, std::vector<int> &adjncy, std::vector<int> &cellParent) const;
+  //! \brief     Partitioning of a mesh not partitioned for the number of CPUs (multilevel bisection of the dual graph of the cells)
+  //! \details   The dual graph is gathered and partitioned by CPU 0, each CPU then receives the CPU of the cells of its part
+  //! \param     premierCellCPU   number of the first cell of the part of each CPU (size Ncpu + 1)
+  //! \param     cpuCell          CPU of each cell of the part
+  void partitionneMeshGmsh(const std::vector<int> &xadj, const std::vector<int> &adjncy, const std::vector<int> &premierCellCPU, std::vector<int> &cpuCell) const;
   void lectureGeometrieGmsh(std::vector<ElementNS*>** voisinsNoeuds);
-  void readGmshV2(std::vector<ElementNS*>** voisinsNoeuds, std::ifstream &meshFile);
-  void readGmshV4(std::vector<ElementNS*>** voisinsNoeuds, std::ifstream &meshFile);
   void lectureGeometrieGmshParallele();
-  void lectureElementGmshV2(const Coord *TableauNoeuds, std::ifstream &fichierMesh, ElementNS **element);
-  void lectureElementGmshV4(const Coord *TableauNoeuds, std::ifstream &fichierMesh, ElementNS **element, const int &typeElement, int &indiceElement, const int & physicalEntity);
+  //! \brief     Name of the geometry cache file of the CPU (depends on the number of CPUs, and on the group of CPUs if test cases are run concurrently)
+  std::string nameFichierCache() const;
+  //! \brief     Fingerprint of the mesh file, key of the geometry cache (m_empreinteMesh)
+  //! \param     partage          if true, the file (global mesh file) is read by CPU 0 only and its fingerprint sent to all CPUs
+  void calculeEmpreinteMesh(const std::string &fichierMesh, const bool &partage);
+  //! \brief     Opening of the geometry cache and verification of its key (fingerprint m_empreinteMesh, number of CPUs, cache version)
+  //! \return    true if the cache can be used, false if it is absent or obsolete
+  bool ouvreCacheGeometrie(std::ifstream &fileStream);
+  //! \brief     Reading of nodes, elements and faces from the geometry cache (replaces the mesh file reading and the faces building)
+  //! \return    false if the cache is truncated or corrupted, nothing is then kept from the reading and the geometry has to be built
+  bool litCacheGeometrie(std::ifstream &fileStream);
+  //! \brief     Abandon of a truncated or corrupted geometry cache during its reading
+  //! \param     numberElementsLus, numberFacesLues   numbers of elements and faces already created
+  bool abandonneCacheGeometrie(std::ifstream &fileStream, const int &numberElementsLus, const int &numberFacesLues);
+  //! \brief     Release of the nodes, elements and faces read in the geometry cache
+  void libereGeometrieCache(const int &numberElementsLus, const int &numberFacesLues);
+  //! \brief     Printing of nodes, elements and faces in the geometry cache
+  void ecritCacheGeometrie() const;
+  //! \brief     Creation of an element read in a Gmsh file and computation of its geometrical properties
+  void construitElementGmsh(const Coord *TableauNoeuds, const GmshReader::ElementGmsh &elementGmsh, ElementNS **element);
 
   std::string m_fichierMesh;  /*name du file de mesh lu*/
   std::string m_nameMesh;
+  std::string m_nameMeshCPU;  /*name des files de mesh des CPUs (suffixe par le groupe de CPUs s ils sont ecrits pendant une execution concurrente des test cases)*/
+  bool m_cacheGeometrie;      /*utilisation du cache de geometrie*/
+  uint64_t m_empreinteMesh;   /*empreinte du file de mesh, cle du cache de geometrie*/
 
   int m_numberNoeuds;               /*number de noeuds definissant le domain geometrique*/
   int m_numberNoeudsInternes;       /*number de noeuds interne (hors fantomes)*/
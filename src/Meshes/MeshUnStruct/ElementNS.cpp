@@ -48,7 +48,10 @@ m_numberNoeuds(numberNoeuds),
 m_numberFaces(numberFaces),
 m_typeVTK(typeVTK),
 m_isFantome(false),
-m_isCommunicant(false)
+m_isCommunicant(false),
+m_CPU(0),
+m_numberautresCPU(0),
+m_autresCPU(0)
 {
   m_numNoeuds = new int[numberNoeuds];
 }
@@ -149,6 +152,7 @@ void ElementNS::setAppartenanceCPU(const int *numCPU, const int &numberCPU)
 {
   m_CPU = numCPU[0] - 1;
   m_numberautresCPU = numberCPU - 1;
+  delete[] m_autresCPU;
   m_autresCPU = new int[m_numberautresCPU];
   for (int i = 1; i < numberCPU; i++)
   {
@@ -305,4 +309,46 @@ void ElementNS::printInfo() const
   //  cout << " autre CPU : " << m_autresCPU[i] << endl;
 }
 
-//***********************************************************************
\ No newline at end of file
+//***********************************************************************
+
+void ElementNS::ecritCache(std::ostream &fileStream) const
+{
+  int entiers[9] = { m_typeGmsh, m_index, m_appartenancePhysique, m_appartenanceGeometrique, m_isFantome, m_isCommunicant, m_CPU, m_numCellAssociee, m_numberautresCPU };
+  double reels[5] = { m_position.getX(), m_position.getY(), m_position.getZ(), m_volume, m_lCFL };
+  fileStream.write(reinterpret_cast<const char*>(entiers), sizeof(entiers));
+  fileStream.write(reinterpret_cast<const char*>(m_autresCPU), m_numberautresCPU*sizeof(int));
+  fileStream.write(reinterpret_cast<const char*>(m_numNoeuds), m_numberNoeuds*sizeof(int));
+  fileStream.write(reinterpret_cast<const char*>(reels), sizeof(reels));
+}
+
+//***********************************************************************
+
+bool ElementNS::litCache(std::istream &fileStream, const int &numberNoeuds, const int &numberCpu)
+{
+  int entiers[8];
+  double reels[5];
+  fileStream.read(reinterpret_cast<char*>(entiers), sizeof(entiers));
+  if (!fileStream || entiers[7] < 0 || entiers[7] > numberCpu) return false;
+  m_index = entiers[0];
+  m_appartenancePhysique = entiers[1];
+  m_appartenanceGeometrique = entiers[2];
+  m_isFantome = (entiers[3] != 0);
+  m_isCommunicant = (entiers[4] != 0);
+  m_CPU = entiers[5];
+  m_numCellAssociee = entiers[6];
+  m_numberautresCPU = entiers[7];
+  delete[] m_autresCPU;
+  m_autresCPU = new int[m_numberautresCPU];
+  fileStream.read(reinterpret_cast<char*>(m_autresCPU), m_numberautresCPU*sizeof(int));
+  fileStream.read(reinterpret_cast<char*>(m_numNoeuds), m_numberNoeuds*sizeof(int));
+  fileStream.read(reinterpret_cast<char*>(reels), sizeof(reels));
+  if (!fileStream) return false;
+  for (int i = 0; i < m_numberNoeuds; i++) { if (m_numNoeuds[i] < 0 || m_numNoeuds[i] >= numberNoeuds) return false; }
+  for (int i = 0; i < m_numberautresCPU; i++) { if (m_autresCPU[i] < 0 || m_autresCPU[i] >= numberCpu) return false; }
+  m_position.setXYZ(reels[0], reels[1], reels[2]);
+  m_volume = reels[3];
+  m_lCFL = reels[4];
+  return true;
+}
+
+//***********************************************************************
@@ -79,6 +79,11 @@ public:
   int getNumberAutresCPU() const;
   int getAutreCPU(const int &autreCPU) const;
   void printInfo() const;
+  //! \brief     Binary printing of the element in the geometry cache (type first, then connectivity, CPUs and geometrical properties)
+  void ecritCache(std::ostream &fileStream) const;
+  //! \brief     Reading of the element from the geometry cache, the type being read beforehand to create the element
+  //! \return    false if the stream fails or if a node or CPU number is out of range (corrupted cache)
+  bool litCache(std::istream &fileStream, const int &numberNoeuds, const int &numberCpu);
 
   bool isFantome() const;
   bool isCommunicant() const;
@@ -238,6 +238,47 @@ void FaceNS::printInfo() const
 
 //***********************************************************************
 
+void FaceNS::ecritCache(std::ostream &fileStream) const
+{
+  int entiers[5] = { m_numberNoeuds, m_limite, m_comm, -1, -1 };
+  if (m_elementGauche != 0) { entiers[3] = m_elementGauche->getIndex(); }
+  if (m_elementDroite != 0) { entiers[4] = m_elementDroite->getIndex(); }
+  double reels[13] = { m_position.getX(), m_position.getY(), m_position.getZ(), m_surface,
+    m_normal.getX(), m_normal.getY(), m_normal.getZ(), m_tangent.getX(), m_tangent.getY(), m_tangent.getZ(),
+    m_binormal.getX(), m_binormal.getY(), m_binormal.getZ() };
+  fileStream.write(reinterpret_cast<const char*>(entiers), sizeof(entiers));
+  fileStream.write(reinterpret_cast<const char*>(m_numNoeuds), m_numberNoeuds*sizeof(int));
+  fileStream.write(reinterpret_cast<const char*>(reels), sizeof(reels));
+}
+
+//***********************************************************************
+
+bool FaceNS::litCache(std::istream &fileStream, ElementNS **elements, const int &numberElements, const int &numberNoeuds)
+{
+  int entiers[4];
+  double reels[13];
+  fileStream.read(reinterpret_cast<char*>(entiers), sizeof(entiers));
+  fileStream.read(reinterpret_cast<char*>(m_numNoeuds), m_numberNoeuds*sizeof(int));
+  fileStream.read(reinterpret_cast<char*>(reels), sizeof(reels));
+  if (!fileStream) return false;
+  if (entiers[2] < -1 || entiers[2] >= numberElements || entiers[3] < -1 || entiers[3] >= numberElements) return false;
+  for (int i = 0; i < m_numberNoeuds; i++) { if (m_numNoeuds[i] < 0 || m_numNoeuds[i] >= numberNoeuds) return false; }
+  m_limite = (entiers[0] != 0);
+  m_comm = (entiers[1] != 0);
+  m_elementGauche = (entiers[2] >= 0) ? elements[entiers[2]] : 0;
+  m_elementDroite = (entiers[3] >= 0) ? elements[entiers[3]] : 0;
+  m_sommeNumNoeuds = 0;
+  for (int i = 0; i < m_numberNoeuds; i++) { m_sommeNumNoeuds += m_numNoeuds[i]; }
+  m_position.setXYZ(reels[0], reels[1], reels[2]);
+  m_surface = reels[3];
+  m_normal.setXYZ(reels[4], reels[5], reels[6]);
+  m_tangent.setXYZ(reels[7], reels[8], reels[9]);
+  m_binormal.setXYZ(reels[10], reels[11], reels[12]);
+  return true;
+}
+
+//***********************************************************************
+
 void FaceNS::afficheNoeuds() const
 {
   cout << "Face" << " Noeuds : ";
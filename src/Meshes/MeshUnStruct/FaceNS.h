@@ -66,6 +66,11 @@ public:
   bool getEstLimite() const;
   void afficheNoeuds() const;
   virtual void printInfo() const;
+  //! \brief     Binary printing of the face in the geometry cache (number of nodes first, then nodes, neighbour elements and geometrical properties)
+  void ecritCache(std::ostream &fileStream) const;
+  //! \brief     Reading of the face from the geometry cache, the number of nodes being read beforehand to create the face
+  //! \return    false if the stream fails or if a node or element index is out of range (corrupted cache)
+  bool litCache(std::istream &fileStream, ElementNS **elements, const int &numberElements, const int &numberNoeuds);
   static int rechercheFace(int *face, int &sommeNoeuds, int **tableauFaces, int *tableauSommeNoeuds, int numberNoeuds, int &indexMaxFaces); // Recherche si face appartient au tableau tableauFaces : renvoi le number ou -1 si absence
   static int rechercheFace(int *face, int &sommeNoeuds, std::vector<int*> tableauFaces, std::vector<int> tableauSommeNoeuds, int numberNoeuds, int &indexMaxFaces); // Recherche si face appartient au tableau tableauFaces : renvoi le number ou -1 si absence. Utilise seulement sur ancienne version
 
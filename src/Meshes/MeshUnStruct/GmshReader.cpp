@@ -0,0 +1,566 @@
+//  
+//       ,---.     ,--,    .---.     ,--,    ,---.    .-. .-. 
+//       | .-'   .' .')   / .-. )  .' .'     | .-'    |  \| | 
+//       | `-.   |  |(_)  | | |(_) |  |  __  | `-.    |   | | 
+//       | .-'   \  \     | | | |  \  \ ( _) | .-'    | |\  | 
+//       |  `--.  \  `-.  \ `-' /   \  `-) ) |  `--.  | | |)| 
+//       /( __.'   \____\  )---'    )\____/  /( __.'  /(  (_) 
+//      (__)              (_)      (__)     (__)     (__)     
+//
+//  This file is part of ECOGEN.
+//
+//  ECOGEN is the legal property of its developers, whose names 
+//  are listed in the copyright file included with this source 
+//  distribution.
+//
+//  ECOGEN is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, 
+//  or (at your option) any later version.
+//  
+//  ECOGEN is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with ECOGEN (file LICENSE).  
+//  If not, see <http://www.gnu.org/licenses/>.
+
+//! \file      GmshReader.cpp
+//! \version   1.0
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "GmshReader.h"
+#include "../../Errors.h"
+
+using namespace std;
+
+//***********************************************************************
+
+GmshReader::GmshReader(const string &fileName) :
+  m_fileName(fileName), m_begin(0), m_end(0), m_position(0), m_mappingSize(0),
+  m_version(0.), m_binary(false), m_numberNodes(0), m_tagsAsIndexes(false), m_numberElements(0), m_elementsRead(0),
+  m_blockRemaining(0), m_blockType(0), m_blockTags(0), m_blockEntity(0), m_blockPhysical(0), m_blocksRemaining(0)
+{
+  //1) File content: memory mapping (copy in memory if not available)
+  //------------------------------------------------------------------
+#ifndef WIN32
+  int descriptor = open(m_fileName.c_str(), O_RDONLY);
+  if (descriptor < 0) { throw ErrorECOGEN("file mesh absent :" + m_fileName, __FILE__, __LINE__); }
+  struct stat properties;
+  if (fstat(descriptor, &properties) == 0 && properties.st_size > 0) {
+    void *mapping = mmap(0, properties.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (mapping != MAP_FAILED) {
+      m_mappingSize = properties.st_size;
+      m_begin = static_cast<const char*>(mapping);
+      madvise(mapping, m_mappingSize, MADV_SEQUENTIAL);
+    }
+  }
+  close(descriptor);
+#endif
+  if (m_mappingSize == 0) {
+    ifstream file(m_fileName.c_str(), ios::in | ios::binary);
+    if (!file) { throw ErrorECOGEN("file mesh absent :" + m_fileName, __FILE__, __LINE__); }
+    m_buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    m_begin = m_buffer.data();
+  }
+  m_end = m_begin + (m_mappingSize > 0 ? m_mappingSize : m_buffer.size());
+  m_position = m_begin;
+
+  //2) Format of the file
+  //---------------------
+  if (!findSection("$MeshFormat")) { throw ErrorECOGEN("$MeshFormat section not found in mesh file " + m_fileName, __FILE__, __LINE__); }
+  m_version = parseReal();
+  m_binary = (parseInteger() == 1);
+  int dataSize(static_cast<int>(parseInteger()));
+  stringstream version; version << m_version;
+  if (m_version < 2. || m_version >= 5. || (m_version >= 3. && m_version < 4.1)) {
+    throw ErrorECOGEN("Gmsh mesh format " + version.str() + " not handled by ECOGEN (formats 2.2 and 4.1 only)", __FILE__, __LINE__);
+  }
+  if (m_binary) {
+    if (dataSize != sizeof(double) || (m_version >= 4. && sizeof(size_t) != 8)) { throw ErrorECOGEN("Binary mesh file with unexpected data size: " + m_fileName, __FILE__, __LINE__); }
+    skipLine();
+    if (readBinary<int>() != 1) { throw ErrorECOGEN("Binary mesh file written with a different endianness: " + m_fileName, __FILE__, __LINE__); }
+  }
+  if (!findSection("$EndMeshFormat")) { errorEndOfFile(); }
+
+  //3) Physical tags of the entities (format 4.1)
+  //---------------------------------------------
+  if (m_version >= 4.) {
+    const char *afterFormat(m_position);
+    if (findSection("$Entities")) { this->readEntities(); }
+    else { m_position = afterFormat; }
+  }
+}
+
+//***********************************************************************
+
+GmshReader::~GmshReader()
+{
+#ifndef WIN32
+  if (m_mappingSize > 0) { munmap(const_cast<char*>(m_begin), m_mappingSize); }
+#endif
+}
+
+//***********************************************************************
+
+void GmshReader::readNodes(int &numberNodes, Coord *&nodes)
+{
+  if (!findSection("$Nodes")) { throw ErrorECOGEN("$Nodes section not found in mesh file " + m_fileName, __FILE__, __LINE__); }
+  long long numberBlocks(1);
+  if (m_version >= 4.) {
+    numberBlocks = readSizeField();
+    m_numberNodes = static_cast<int>(readSizeField());
+    readSizeField(); readSizeField(); //min and max node tags
+  }
+  else {
+    m_numberNodes = static_cast<int>(parseInteger());
+    if (m_binary) { skipLine(); }
+  }
+  numberNodes = m_numberNodes;
+  nodes = new Coord[m_numberNodes];
+  m_tagsAsIndexes = false;
+
+  //Nodes are stored in the file order, tags are kept only if they differ from this order
+  vector<int> tags;
+  vector<long long> blockTags;
+  int node(0);
+  double x, y, z;
+  for (long long b = 0; b < numberBlocks; b++) {
+    long long numberNodesBlock(m_numberNodes);
+    int parametric(0), entityDim(0);
+    if (m_version >= 4.) {
+      entityDim = readIntField();
+      readIntField(); //entity tag
+      parametric = readIntField();
+      numberNodesBlock = readSizeField();
+      blockTags.resize(numberNodesBlock);
+      for (long long i = 0; i < numberNodesBlock; i++) { blockTags[i] = readSizeField(); }
+    }
+    if (node + numberNodesBlock > m_numberNodes) { throw ErrorECOGEN("Too many nodes in mesh file " + m_fileName, __FILE__, __LINE__); }
+    for (long long i = 0; i < numberNodesBlock; i++) {
+      long long tag;
+      if (m_version >= 4.) { tag = blockTags[i]; }
+      else { tag = readIntField(); }
+      x = readRealField(); y = readRealField(); z = readRealField();
+      for (int p = 0; p < parametric * entityDim; p++) { readRealField(); }
+      nodes[node].setXYZ(x, y, z);
+      if (tag != node + 1 && tags.empty()) {
+        tags.resize(node);
+        for (int n = 0; n < node; n++) { tags[n] = n + 1; }
+      }
+      if (!tags.empty() || tag != node + 1) { tags.push_back(static_cast<int>(tag)); }
+      node++;
+    }
+  }
+  if (node != m_numberNodes) { throw ErrorECOGEN("Missing nodes in mesh file " + m_fileName, __FILE__, __LINE__); }
+
+  //Index of the node tags when they are not numbered 1..numberNodes
+  m_nodeIndexes.clear();
+  if (!tags.empty()) {
+    int maxTag(*max_element(tags.begin(), tags.end()));
+    m_nodeIndexes.assign(maxTag + 1, -1);
+    for (int n = 0; n < m_numberNodes; n++) {
+      if (tags[n] < 0) { throw ErrorECOGEN("Negative node tag in mesh file " + m_fileName, __FILE__, __LINE__); }
+      m_nodeIndexes[tags[n]] = n;
+    }
+  }
+  if (!findSection("$EndNodes")) { errorEndOfFile(); }
+}
+
+//***********************************************************************
+
+int GmshReader::startElements()
+{
+  if (!findSection("$Elements")) { throw ErrorECOGEN("$Elements section not found in mesh file " + m_fileName, __FILE__, __LINE__); }
+  if (m_version >= 4.) {
+    m_blocksRemaining = readSizeField();
+    m_numberElements = static_cast<int>(readSizeField());
+    readSizeField(); readSizeField(); //min and max element tags
+  }
+  else {
+    m_numberElements = static_cast<int>(parseInteger());
+    if (m_binary) { skipLine(); }
+  }
+  m_elementsRead = 0;
+  m_blockRemaining = 0;
+  return m_numberElements;
+}
+
+//***********************************************************************
+
+void GmshReader::nextElement(ElementGmsh &element)
+{
+  if (m_elementsRead >= m_numberElements) { throw ErrorECOGEN("Too many elements read in mesh file " + m_fileName, __FILE__, __LINE__); }
+
+  //1) Header of a new block of elements (format 2.2 binary and 4.1)
+  //----------------------------------------------------------------
+  if (m_blockRemaining == 0 && (m_binary || m_version >= 4.)) {
+    this->readElementBlock();
+    if (m_blockRemaining <= 0) { return this->nextElement(element); }
+  }
+
+  //2) Element number, type and tags
+  //--------------------------------
+  element.partitions.clear();
+  if (m_version >= 4.) {
+    readSizeField(); //element tag, the element is numbered in the file order
+    element.number = m_elementsRead + 1;
+    element.type = m_blockType;
+    element.physicalEntity = m_blockPhysical;
+    element.geometricalEntity = m_blockEntity;
+  }
+  else {
+    int numberTags;
+    element.number = readIntField();
+    if (m_binary) { element.type = m_blockType; numberTags = m_blockTags; }
+    else { element.type = readIntField(); numberTags = readIntField(); }
+    element.physicalEntity = 0; element.geometricalEntity = 0;
+    for (int t = 0; t < numberTags; t++) {
+      int tag = readIntField();
+      if (t == 0) { element.physicalEntity = tag; }
+      else if (t == 1) { element.geometricalEntity = tag; }
+      else if (t > 2 && static_cast<int>(element.partitions.size()) < numberTags - 3) { element.partitions.push_back(tag); } //t == 2: number of partitions
+    }
+  }
+  if (m_blockRemaining > 0) { m_blockRemaining--; }
+
+  //3) Nodes of the element
+  //-----------------------
+  int numberNodes(numberNodesType(element.type));
+  if (numberNodes == 0) {
+    stringstream type; type << element.type;
+    throw ErrorECOGEN("Element type " + type.str() + " of mesh file not handled by ECOGEN", __FILE__, __LINE__);
+  }
+  element.nodes.resize(numberNodes);
+  for (int n = 0; n < numberNodes; n++) {
+    long long tag = (m_version >= 4.) ? readSizeField() : readIntField();
+    element.nodes[n] = nodeIndex(tag);
+  }
+  m_elementsRead++;
+}
+
+//***********************************************************************
+
+int GmshReader::readNodesPart(const int &part, const int &numberParts, vector<int> &indexes, vector<Coord> &nodes)
+{
+  if (!findSection("$Nodes")) { throw ErrorECOGEN("$Nodes section not found in mesh file " + m_fileName, __FILE__, __LINE__); }
+  long long numberBlocks(1);
+  if (m_version >= 4.) {
+    numberBlocks = readSizeField();
+    m_numberNodes = static_cast<int>(readSizeField());
+    readSizeField(); readSizeField(); //min and max node tags
+  }
+  else {
+    m_numberNodes = static_cast<int>(parseInteger());
+    if (m_binary) { skipLine(); }
+  }
+  m_nodeIndexes.clear();
+  m_tagsAsIndexes = true;
+
+  //Nodes of the part: from first to last - 1 in the file order
+  long long first(static_cast<long long>(m_numberNodes)*part / numberParts), last(static_cast<long long>(m_numberNodes)*(part + 1) / numberParts);
+  indexes.clear(); nodes.clear();
+  indexes.reserve(last - first); nodes.reserve(last - first);
+  long long node(0);
+  double x, y, z;
+  for (long long b = 0; b < numberBlocks; b++) {
+    long long numberNodesBlock(m_numberNodes);
+    int parametric(0), entityDim(0);
+    if (m_version >= 4.) {
+      entityDim = readIntField();
+      readIntField(); //entity tag
+      parametric = readIntField();
+      numberNodesBlock = readSizeField();
+    }
+    if (node + numberNodesBlock > m_numberNodes) { throw ErrorECOGEN("Too many nodes in mesh file " + m_fileName, __FILE__, __LINE__); }
+    //Nodes of the block belonging to the part: from debut to fin - 1
+    long long debut(min(max(first - node, 0LL), numberNodesBlock)), fin(max(min(last - node, numberNodesBlock), debut));
+    size_t sizeCoordinates((3 + parametric * entityDim) * sizeof(double));
+    if (m_version >= 4.) {
+      //Tags of the block, then coordinates
+      skipRecords(debut, sizeof(size_t));
+      for (long long i = debut; i < fin; i++) { indexes.push_back(static_cast<int>(readSizeField() - 1)); }
+      skipRecords(numberNodesBlock - fin, sizeof(size_t));
+      skipRecords(debut, sizeCoordinates);
+    }
+    else { skipRecords(debut, sizeof(int) + sizeCoordinates); }
+    for (long long i = debut; i < fin; i++) {
+      if (m_version < 4.) { indexes.push_back(readIntField() - 1); }
+      x = readRealField(); y = readRealField(); z = readRealField();
+      for (int p = 0; p < parametric * entityDim; p++) { readRealField(); }
+      nodes.push_back(Coord(x, y, z));
+    }
+    skipRecords(numberNodesBlock - fin, (m_version >= 4.) ? sizeCoordinates : sizeof(int) + sizeCoordinates);
+    node += numberNodesBlock;
+  }
+  if (node != m_numberNodes) { throw ErrorECOGEN("Missing nodes in mesh file " + m_fileName, __FILE__, __LINE__); }
+  if (!findSection("$EndNodes")) { errorEndOfFile(); }
+  return m_numberNodes;
+}
+
+//***********************************************************************
+
+int GmshReader::startElementsPart(const int &part, const int &numberParts, int &firstElement)
+{
+  int numberElements(this->startElements());
+  firstElement = static_cast<int>(static_cast<long long>(numberElements)*part / numberParts);
+  int last(static_cast<int>(static_cast<long long>(numberElements)*(part + 1) / numberParts));
+
+  //Elements before the part are skipped, block by block for the formats 2.2 binary and 4.1
+  if (m_binary || m_version >= 4.) {
+    int toSkip(firstElement);
+    while (toSkip > 0) {
+      if (m_blockRemaining == 0) { this->readElementBlock(); continue; }
+      int numberNodes(numberNodesType(m_blockType));
+      if (numberNodes == 0) {
+        stringstream type; type << m_blockType;
+        throw ErrorECOGEN("Element type " + type.str() + " of mesh file not handled by ECOGEN", __FILE__, __LINE__);
+      }
+      int skipped(min(toSkip, m_blockRemaining));
+      if (m_version >= 4.) { skipRecords(skipped, (1 + numberNodes) * sizeof(size_t)); }
+      else { skipRecords(skipped, (1 + m_blockTags + numberNodes) * sizeof(int)); }
+      m_blockRemaining -= skipped;
+      toSkip -= skipped;
+    }
+  }
+  else { skipRecords(firstElement, 0); }
+  m_elementsRead = firstElement;
+  m_numberElements = last;
+  return last - firstElement;
+}
+
+//***********************************************************************
+
+void GmshReader::endElements()
+{
+  if (!findSection("$EndElements")) { errorEndOfFile(); }
+}
+
+//***********************************************************************
+
+int GmshReader::readInteger()
+{
+  return static_cast<int>(parseInteger());
+}
+
+//***********************************************************************
+
+void GmshReader::skipLine()
+{
+  const char *lineEnd = static_cast<const char*>(memchr(m_position, '\n', m_end - m_position));
+  m_position = (lineEnd == 0) ? m_end : lineEnd + 1;
+}
+
+//***********************************************************************
+
+uint64_t GmshReader::computeHash() const
+{
+  const uint64_t prime(1099511628211ULL);
+  uint64_t hash(14695981039346656037ULL);
+  uint64_t size(m_end - m_begin), word;
+  hash = (hash ^ size) * prime;
+  //Words of 8 bytes, then remaining bytes
+  const char *position(m_begin);
+  for (; position + sizeof(word) <= m_end; position += sizeof(word)) {
+    memcpy(&word, position, sizeof(word));
+    hash = (hash ^ word) * prime;
+  }
+  for (; position < m_end; position++) { hash = (hash ^ static_cast<unsigned char>(*position)) * prime; }
+  return hash;
+}
+
+//***********************************************************************
+
+int GmshReader::numberNodesType(const int &type)
+{
+  switch (type) {
+    case 1: return 2;  //segment
+    case 2: return 3;  //triangle
+    case 3: return 4;  //quadrangle
+    case 4: return 4;  //tetrahedron
+    case 5: return 8;  //hexahedron
+    case 6: return 6;  //prism
+    case 7: return 5;  //pyramid
+    case 15: return 1; //point
+    default: return 0;
+  }
+}
+
+//***********************************************************************
+
+bool GmshReader::findSection(const char *name)
+{
+  size_t nameSize(strlen(name));
+  const char *line(m_position);
+  while (line < m_end) {
+    const char *lineEnd = static_cast<const char*>(memchr(line, '\n', m_end - line));
+    if (lineEnd == 0) { lineEnd = m_end; }
+    const char *end(lineEnd);
+    while (end > line && (end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t')) { end--; }
+    if (static_cast<size_t>(end - line) == nameSize && memcmp(line, name, nameSize) == 0) {
+      m_position = (lineEnd < m_end) ? lineEnd + 1 : m_end;
+      return true;
+    }
+    line = lineEnd + 1;
+  }
+  return false;
+}
+
+//***********************************************************************
+
+void GmshReader::readElementBlock()
+{
+  if (m_version >= 4.) {
+    if (m_blocksRemaining == 0) { throw ErrorECOGEN("Missing element blocks in mesh file " + m_fileName, __FILE__, __LINE__); }
+    int entityDim = readIntField();
+    m_blockEntity = readIntField();
+    m_blockType = readIntField();
+    m_blockRemaining = static_cast<int>(readSizeField());
+    map<pair<int, int>, int>::const_iterator physical = m_physicalTags.find(make_pair(entityDim, m_blockEntity));
+    m_blockPhysical = (physical == m_physicalTags.end()) ? 0 : physical->second;
+    m_blocksRemaining--;
+  }
+  else {
+    m_blockType = readBinary<int>();
+    m_blockRemaining = readBinary<int>();
+    m_blockTags = readBinary<int>();
+  }
+}
+
+//***********************************************************************
+
+void GmshReader::skipRecords(const long long &number, const size_t &recordSize)
+{
+  if (number <= 0) { return; }
+  if (m_binary) {
+    if (static_cast<unsigned long long>(m_end - m_position) < number * recordSize) { errorEndOfFile(); }
+    m_position += number * recordSize;
+  }
+  else {
+    for (long long r = 0; r < number; r++) { skipLine(); }
+    const char *lineEnd = static_cast<const char*>(memchr(m_position, '\n', m_end - m_position));
+    m_position = (lineEnd == 0) ? m_end : lineEnd;
+  }
+}
+
+//***********************************************************************
+
+void GmshReader::readEntities()
+{
+  long long numberEntities[4];
+  for (int dim = 0; dim < 4; dim++) { numberEntities[dim] = readSizeField(); }
+  for (int dim = 0; dim < 4; dim++) {
+    for (long long e = 0; e < numberEntities[dim]; e++) {
+      int tag = readIntField();
+      for (int c = 0; c < (dim == 0 ? 3 : 6); c++) { readRealField(); } //bounding box
+      long long numberPhysicalTags = readSizeField();
+      for (long long p = 0; p < numberPhysicalTags; p++) {
+        int physicalTag = readIntField();
+        if (p == 0) { m_physicalTags[make_pair(dim, tag)] = physicalTag; }
+      }
+      if (dim > 0) {
+        long long numberBoundingEntities = readSizeField();
+        for (long long b = 0; b < numberBoundingEntities; b++) { readIntField(); }
+      }
+    }
+  }
+  if (!findSection("$EndEntities")) { errorEndOfFile(); }
+}
+
+//***********************************************************************
+
+void GmshReader::skipBlanks()
+{
+  while (m_position < m_end && (*m_position == ' ' || *m_position == '\n' || *m_position == '\r' || *m_position == '\t')) { m_position++; }
+}
+
+//***********************************************************************
+
+long long GmshReader::parseInteger()
+{
+  skipBlanks();
+  long long value(0);
+  from_chars_result result = from_chars(m_position, m_end, value);
+  if (result.ec != errc()) {
+    if (m_position >= m_end) { errorEndOfFile(); }
+    throw ErrorECOGEN("Integer expected in mesh file " + m_fileName + " : " + string(m_position, min<ptrdiff_t>(m_end - m_position, 20)), __FILE__, __LINE__);
+  }
+  m_position = result.ptr;
+  return value;
+}
+
+//***********************************************************************
+
+double GmshReader::parseReal()
+{
+  skipBlanks();
+  if (m_position < m_end && *m_position == '+') { m_position++; }
+  double value(0.);
+  from_chars_result result = from_chars(m_position, m_end, value);
+  if (result.ec != errc()) {
+    if (m_position >= m_end) { errorEndOfFile(); }
+    throw ErrorECOGEN("Real expected in mesh file " + m_fileName + " : " + string(m_position, min<ptrdiff_t>(m_end - m_position, 20)), __FILE__, __LINE__);
+  }
+  m_position = result.ptr;
+  return value;
+}
+
+//***********************************************************************
+
+int GmshReader::readIntField()
+{
+  if (m_binary) { return readBinary<int>(); }
+  return static_cast<int>(parseInteger());
+}
+
+//***********************************************************************
+
+long long GmshReader::readSizeField()
+{
+  if (!m_binary) { return parseInteger(); }
+  if (m_version >= 4.) { return static_cast<long long>(readBinary<size_t>()); }
+  return readBinary<int>();
+}
+
+//***********************************************************************
+
+double GmshReader::readRealField()
+{
+  if (m_binary) { return readBinary<double>(); }
+  return parseReal();
+}
+
+//***********************************************************************
+
+int GmshReader::nodeIndex(const long long &tag) const
+{
+  int index(-1);
+  if (m_tagsAsIndexes) { if (tag >= 1) { index = static_cast<int>(tag - 1); } }
+  else if (m_nodeIndexes.empty()) { if (tag >= 1 && tag <= m_numberNodes) { index = static_cast<int>(tag - 1); } }
+  else if (tag >= 0 && tag < static_cast<long long>(m_nodeIndexes.size())) { index = m_nodeIndexes[tag]; }
+  if (index < 0) {
+    stringstream node; node << tag;
+    throw ErrorECOGEN("Unknown node " + node.str() + " in an element of mesh file " + m_fileName, __FILE__, __LINE__);
+  }
+  return index;
+}
+
+//***********************************************************************
+
+void GmshReader::errorEndOfFile() const
+{
+  throw ErrorECOGEN("Unexpected end of mesh file " + m_fileName, __FILE__, __LINE__);
+}
+
+//***********************************************************************
@@ -0,0 +1,148 @@
+//  
+//       ,---.     ,--,    .---.     ,--,    ,---.    .-. .-. 
+//       | .-'   .' .')   / .-. )  .' .'     | .-'    |  \| | 
+//       | `-.   |  |(_)  | | |(_) |  |  __  | `-.    |   | | 
+//       | .-'   \  \     | | | |  \  \ ( _) | .-'    | |\  | 
+//       |  `--.  \  `-.  \ `-' /   \  `-) ) |  `--.  | | |)| 
+//       /( __.'   \____\  )---'    )\____/  /( __.'  /(  (_) 
+//      (__)              (_)      (__)     (__)     (__)     
+//
+//  This file is part of ECOGEN.
+//
+//  ECOGEN is the legal property of its developers, whose names 
+//  are listed in the copyright file included with this source 
+//  distribution.
+//
+//  ECOGEN is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, 
+//  or (at your option) any later version.
+//  
+//  ECOGEN is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with ECOGEN (file LICENSE).  
+//  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GMSHREADER_H
+#define GMSHREADER_H
+
+//! \file      GmshReader.h
+//! \version   1.0
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstring>
+#include <stdint.h>
+#include "../../Maths/Coord.h"
+
+//! \class     GmshReader
+//! \brief     Reader of Gmsh mesh files (formats 2.2 and 4.1, ASCII or binary)
+//! \details   The file is memory-mapped and numbers are parsed in place with std::from_chars, without stream extraction.
+//!            Nodes and elements are given in the Gmsh order; node tags are converted into indexes starting at zero.
+class GmshReader
+{
+public:
+  //! \brief     Element as read in the mesh file
+  struct ElementGmsh {
+    int number;                 //!< element number (starting at 1, index in the file for format 4.1)
+    int type;                   //!< Gmsh element type
+    int physicalEntity;         //!< physical tag (0 if none)
+    int geometricalEntity;      //!< elementary entity tag
+    std::vector<int> partitions;//!< mesh partitions of the element (format 2.2 only: owner first, then negative ghost partitions)
+    std::vector<int> nodes;     //!< node indexes (starting at 0)
+  };
+
+  //! \param     fileName         mesh file name (an ErrorECOGEN is thrown if absent or in an unsupported format)
+  GmshReader(const std::string &fileName);
+  virtual ~GmshReader();
+
+  //! \brief     Reading of the $Nodes section
+  //! \param     numberNodes      number of nodes read
+  //! \param     nodes            nodes coordinates, allocated with new[]
+  void readNodes(int &numberNodes, Coord *&nodes);
+  //! \brief     Positioning at the beginning of the $Elements section (after readNodes)
+  //! \return    number of elements of the section
+  int startElements();
+  //! \brief     Reading of a part of the $Nodes section, for a reading shared between CPUs
+  //! \details   Part p of n holds the nodes p*N/n to (p+1)*N/n - 1 of the file order. The other nodes are skipped without parsing.
+  //!            Node tags are not converted: node indexes are tags minus one, also in the elements read afterwards.
+  //! \param     part             number of the part
+  //! \param     numberParts      number of parts
+  //! \param     indexes          node indexes of the part (tag - 1)
+  //! \param     nodes            nodes coordinates of the part
+  //! \return    number of nodes of the section
+  int readNodesPart(const int &part, const int &numberParts, std::vector<int> &indexes, std::vector<Coord> &nodes);
+  //! \brief     Positioning at the first element of a part of the $Elements section (after readNodesPart)
+  //! \details   Part p of n holds the elements p*N/n to (p+1)*N/n - 1 of the file order, read with nextElement.
+  //! \param     firstElement     index of the first element of the part in the file order
+  //! \return    number of elements of the part
+  int startElementsPart(const int &part, const int &numberParts, int &firstElement);
+  //! \brief     Reading of the next element of the $Elements section
+  void nextElement(ElementGmsh &element);
+  //! \brief     Positioning after the $EndElements line
+  void endElements();
+  //! \brief     Reading of an integer in ASCII data (leading blanks and line ends are skipped)
+  int readInteger();
+  //! \brief     Positioning at the beginning of the next line
+  void skipLine();
+
+  //! \brief     Fingerprint of the file content (64 bits FNV-1a hash of the file size and of its words of 8 bytes)
+  uint64_t computeHash() const;
+
+  double getVersion() const { return m_version; };
+  bool isBinary() const { return m_binary; };
+  //! \brief     Number of nodes of a Gmsh element type (0 if not handled by ECOGEN)
+  static int numberNodesType(const int &type);
+
+private:
+  //! \brief     Positioning after the line "name", searched from the current position (false if absent)
+  bool findSection(const char *name);
+  void readEntities();
+  //! \brief     Reading of the header of the next block of elements (format 2.2 binary and 4.1)
+  void readElementBlock();
+  //! \brief     Skipping of records: jump over binary records, one record per line in ASCII (the position is then at the end of the last skipped line)
+  void skipRecords(const long long &number, const size_t &recordSize);
+  //ASCII parsing
+  void skipBlanks();
+  long long parseInteger();
+  double parseReal();
+  //Fields of the file: ASCII, or binary with the sizes of the format (int, size_t for counts and tags of format 4.1, double)
+  int readIntField();
+  long long readSizeField();
+  double readRealField();
+  template<typename T> T readBinary()
+  {
+    if (m_position + sizeof(T) > m_end) { errorEndOfFile(); }
+    T value;
+    std::memcpy(&value, m_position, sizeof(T));
+    m_position += sizeof(T);
+    return value;
+  }
+  int nodeIndex(const long long &tag) const;
+  void errorEndOfFile() const;
+
+  std::string m_fileName;
+  const char *m_begin;          //!< beginning of the file content
+  const char *m_end;            //!< end of the file content
+  const char *m_position;       //!< current reading position
+  size_t m_mappingSize;         //!< size of the memory mapping (0 if the file is copied in m_buffer)
+  std::vector<char> m_buffer;   //!< file content when memory mapping is not available
+
+  double m_version;
+  bool m_binary;
+  std::map<std::pair<int, int>, int> m_physicalTags;  //!< physical tag of each (dimension, entity tag) (format 4.1)
+  int m_numberNodes;
+  std::vector<int> m_nodeIndexes;  //!< index of each node tag, filled only if tags are not 1..numberNodes
+  bool m_tagsAsIndexes;            //!< node indexes are tags minus one (reading by parts)
+  int m_numberElements, m_elementsRead;
+  //Current element block (format 2.2 binary and 4.1)
+  int m_blockRemaining, m_blockType, m_blockTags, m_blockEntity, m_blockPhysical;
+  size_t m_blocksRemaining;
+};
+
+#endif // GMSHREADER_H
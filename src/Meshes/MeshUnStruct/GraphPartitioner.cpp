@@ -0,0 +1,375 @@
+//  
+//       ,---.     ,--,    .---.     ,--,    ,---.    .-. .-. 
+//       | .-'   .' .')   / .-. )  .' .'     | .-'    |  \| | 
+//       | `-.   |  |(_)  | | |(_) |  |  __  | `-.    |   | | 
+//       | .-'   \  \     | | | |  \  \ ( _) | .-'    | |\  | 
+//       |  `--.  \  `-.  \ `-' /   \  `-) ) |  `--.  | | |)| 
+//       /( __.'   \____\  )---'    )\____/  /( __.'  /(  (_) 
+//      (__)              (_)      (__)     (__)     (__)     
+//
+//  This file is part of ECOGEN.
+//
+//  ECOGEN is the legal property of its developers, whose names 
+//  are listed in the copyright file included with this source 
+//  distribution.
+//
+//  ECOGEN is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, 
+//  or (at your option) any later version.
+//  
+//  ECOGEN is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with ECOGEN (file LICENSE).  
+//  If not, see <http://www.gnu.org/licenses/>.
+
+//! \file      GraphPartitioner.cpp
+//! \version   1.0
+
+#include <algorithm>
+#include "GraphPartitioner.h"
+
+using namespace std;
+
+//***********************************************************************
+
+GraphPartitioner::GraphPartitioner(const vector<int> &xadj, const vector<int> &adjncy)
+{
+  m_graph.xadj = xadj;
+  m_graph.adjncy = adjncy;
+  m_graph.vwgt.assign(m_graph.numberVertices(), 1);
+  m_graph.adjwgt.assign(adjncy.size(), 1);
+}
+
+//***********************************************************************
+
+GraphPartitioner::~GraphPartitioner(){}
+
+//***********************************************************************
+
+int GraphPartitioner::Graph::totalWeight() const
+{
+  int total(0);
+  for (unsigned int v = 0; v < vwgt.size(); v++) { total += vwgt[v]; }
+  return total;
+}
+
+//***********************************************************************
+
+void GraphPartitioner::partition(const int &numberParts, vector<int> &part) const
+{
+  part.assign(m_graph.numberVertices(), 0);
+  if (numberParts <= 1) return;
+  vector<int> vertices(m_graph.numberVertices());
+  for (int v = 0; v < m_graph.numberVertices(); v++) { vertices[v] = v; }
+  this->recursiveBisection(m_graph, vertices, numberParts, 0, part);
+}
+
+//***********************************************************************
+
+int GraphPartitioner::computeEdgeCut(const vector<int> &part) const
+{
+  int edgeCut(0);
+  for (int v = 0; v < m_graph.numberVertices(); v++) {
+    for (int e = m_graph.xadj[v]; e < m_graph.xadj[v + 1]; e++) {
+      if (part[v] != part[m_graph.adjncy[e]]) edgeCut++;
+    }
+  }
+  return edgeCut / 2;
+}
+
+//***********************************************************************
+
+double GraphPartitioner::computeImbalance(const vector<int> &part, const int &numberParts) const
+{
+  if (m_graph.numberVertices() == 0) return 1.;
+  vector<int> weightParts(numberParts, 0);
+  for (int v = 0; v < m_graph.numberVertices(); v++) { weightParts[part[v]] += m_graph.vwgt[v]; }
+  int maxWeight(*max_element(weightParts.begin(), weightParts.end()));
+  return static_cast<double>(maxWeight) * numberParts / m_graph.totalWeight();
+}
+
+//***********************************************************************
+
+void GraphPartitioner::recursiveBisection(const Graph &graph, const vector<int> &vertices, const int &numberParts, const int &firstPart, vector<int> &part) const
+{
+  if (numberParts == 1 || graph.numberVertices() == 0) {
+    for (unsigned int v = 0; v < vertices.size(); v++) { part[vertices[v]] = firstPart; }
+    return;
+  }
+
+  //Bisection with weights proportional to the number of parts on each side
+  int numberParts0(numberParts / 2);
+  vector<int> side;
+  this->bisection(graph, static_cast<double>(numberParts0) / numberParts, side);
+
+  //Recursion on each side
+  for (int s = 0; s < 2; s++) {
+    Graph subgraph;
+    vector<int> localToParent;
+    this->extractSubgraph(graph, side, s, subgraph, localToParent);
+    vector<int> subVertices(localToParent.size());
+    for (unsigned int v = 0; v < localToParent.size(); v++) { subVertices[v] = vertices[localToParent[v]]; }
+    if (s == 0) { this->recursiveBisection(subgraph, subVertices, numberParts0, firstPart, part); }
+    else { this->recursiveBisection(subgraph, subVertices, numberParts - numberParts0, firstPart + numberParts0, part); }
+  }
+}
+
+//***********************************************************************
+
+void GraphPartitioner::bisection(const Graph &graph, const double &fraction, vector<int> &side) const
+{
+  //1) Coarsening until the graph is small or does not shrink anymore
+  vector<Graph> levels(1, graph);
+  vector< vector<int> > maps;
+  while (levels.back().numberVertices() > 100) {
+    Graph coarse;
+    vector<int> map;
+    this->coarsen(levels.back(), coarse, map);
+    if (coarse.numberVertices() > 0.9 * levels.back().numberVertices()) break;
+    levels.push_back(coarse);
+    maps.push_back(map);
+  }
+
+  //2) Bisection of the coarsest graph
+  this->initialBisection(levels.back(), fraction, side);
+
+  //3) Projection on finer graphs and refinement
+  for (int l = static_cast<int>(maps.size()) - 1; l >= 0; l--) {
+    vector<int> sideFine(levels[l].numberVertices());
+    for (int v = 0; v < levels[l].numberVertices(); v++) { sideFine[v] = side[maps[l][v]]; }
+    side.swap(sideFine);
+    this->refine(levels[l], fraction, side);
+  }
+}
+
+//***********************************************************************
+
+void GraphPartitioner::coarsen(const Graph &graph, Graph &coarse, vector<int> &map) const
+{
+  int n(graph.numberVertices());
+
+  //Heavy edge matching, visiting low degree vertices first
+  vector<int> order(n);
+  for (int v = 0; v < n; v++) { order[v] = v; }
+  stable_sort(order.begin(), order.end(), [&graph](int a, int b) { return graph.xadj[a + 1] - graph.xadj[a] < graph.xadj[b + 1] - graph.xadj[b]; });
+  vector<int> match(n, -1);
+  for (int i = 0; i < n; i++) {
+    int u(order[i]);
+    if (match[u] >= 0) continue;
+    int best(u), bestWeight(-1);
+    for (int e = graph.xadj[u]; e < graph.xadj[u + 1]; e++) {
+      int v(graph.adjncy[e]);
+      if (match[v] < 0 && v != u && graph.adjwgt[e] > bestWeight) { best = v; bestWeight = graph.adjwgt[e]; }
+    }
+    match[u] = best;
+    match[best] = u;
+  }
+
+  //Numbering of coarse vertices
+  map.assign(n, -1);
+  vector<int> members; //Fine vertices of each coarse vertex, two by two
+  int numberCoarse(0);
+  for (int u = 0; u < n; u++) {
+    if (map[u] >= 0) continue;
+    map[u] = numberCoarse;
+    map[match[u]] = numberCoarse;
+    members.push_back(u);
+    members.push_back(match[u]);
+    numberCoarse++;
+  }
+
+  //Coarse graph: merged adjacencies, summed weights, internal edges removed
+  coarse.xadj.assign(1, 0);
+  coarse.adjncy.clear();
+  coarse.adjwgt.clear();
+  coarse.vwgt.assign(numberCoarse, 0);
+  vector<int> position(numberCoarse, -1);
+  for (int c = 0; c < numberCoarse; c++) {
+    int start(static_cast<int>(coarse.adjncy.size()));
+    for (int m = 0; m < 2; m++) {
+      int u(members[2 * c + m]);
+      if (m == 1 && u == members[2 * c]) break;
+      coarse.vwgt[c] += graph.vwgt[u];
+      for (int e = graph.xadj[u]; e < graph.xadj[u + 1]; e++) {
+        int cv(map[graph.adjncy[e]]);
+        if (cv == c) continue;
+        if (position[cv] < start) {
+          position[cv] = static_cast<int>(coarse.adjncy.size());
+          coarse.adjncy.push_back(cv);
+          coarse.adjwgt.push_back(graph.adjwgt[e]);
+        }
+        else { coarse.adjwgt[position[cv]] += graph.adjwgt[e]; }
+      }
+    }
+    coarse.xadj.push_back(static_cast<int>(coarse.adjncy.size()));
+  }
+}
+
+//***********************************************************************
+
+void GraphPartitioner::initialBisection(const Graph &graph, const double &fraction, vector<int> &side) const
+{
+  int n(graph.numberVertices());
+  double target(fraction * graph.totalWeight());
+
+  //Pseudo-peripheral vertex: last vertex reached by a breadth-first search
+  int peripheral(0);
+  {
+    vector<bool> visited(n, false);
+    vector<int> queue(1, 0);
+    visited[0] = true;
+    for (unsigned int q = 0; q < queue.size(); q++) {
+      int u(queue[q]);
+      for (int e = graph.xadj[u]; e < graph.xadj[u + 1]; e++) {
+        int v(graph.adjncy[e]);
+        if (!visited[v]) { visited[v] = true; queue.push_back(v); }
+      }
+    }
+    peripheral = queue.back();
+  }
+
+  //Greedy graph growing from several seeds, the best refined bisection is kept
+  int numberTrials(min(4, n));
+  int bestCut(-1);
+  for (int trial = 0; trial < numberTrials; trial++) {
+    int seed(trial == 0 ? peripheral : (trial * n) / numberTrials);
+    vector<int> sideTrial(n, 1);
+    vector<bool> queued(n, false);
+    vector<int> queue(1, seed);
+    queued[seed] = true;
+    double weight0(0.);
+    unsigned int q(0);
+    int nextSeed(0);
+    while (weight0 < target) {
+      if (q == queue.size()) {
+        //Disconnected graph: growing restarts from a vertex not yet reached
+        while (nextSeed < n && queued[nextSeed]) nextSeed++;
+        if (nextSeed == n) break;
+        queue.push_back(nextSeed);
+        queued[nextSeed] = true;
+      }
+      int u(queue[q++]);
+      //Stopping if adding the vertex moves away from the target
+      if (weight0 > 0. && weight0 + graph.vwgt[u] - target > target - weight0) break;
+      sideTrial[u] = 0;
+      weight0 += graph.vwgt[u];
+      for (int e = graph.xadj[u]; e < graph.xadj[u + 1]; e++) {
+        int v(graph.adjncy[e]);
+        if (!queued[v]) { queued[v] = true; queue.push_back(v); }
+      }
+    }
+    this->refine(graph, fraction, sideTrial);
+    int cutTrial(this->cut(graph, sideTrial));
+    if (bestCut < 0 || cutTrial < bestCut) { bestCut = cutTrial; side.swap(sideTrial); }
+  }
+}
+
+//***********************************************************************
+
+void GraphPartitioner::refine(const Graph &graph, const double &fraction, vector<int> &side) const
+{
+  int n(graph.numberVertices());
+  double total(graph.totalWeight());
+  double target[2] = { fraction * total, (1. - fraction) * total };
+  int maxVertexWeight(0);
+  for (int v = 0; v < n; v++) { maxVertexWeight = max(maxVertexWeight, graph.vwgt[v]); }
+  //Allowed weight of each side: 3% above the target, at least one vertex
+  double allowed[2];
+  for (int s = 0; s < 2; s++) { allowed[s] = max(1.03 * target[s], target[s] + maxVertexWeight); }
+  double weight[2] = { 0., 0. };
+  for (int v = 0; v < n; v++) { weight[side[v]] += graph.vwgt[v]; }
+
+  //1) Greedy passes on boundary vertices: moves decreasing the cut, or keeping it and improving the balance
+  for (int pass = 0; pass < 10; pass++) {
+    int numberMoves(0);
+    for (int v = 0; v < n; v++) {
+      int s(side[v]);
+      int internal(0), external(0);
+      for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+        if (side[graph.adjncy[e]] == s) internal += graph.adjwgt[e];
+        else external += graph.adjwgt[e];
+      }
+      if (external == 0) continue;
+      int gain(external - internal);
+      double weightOther(weight[1 - s] + graph.vwgt[v]);
+      bool improvesBalance(weight[s] - target[s] > weightOther - target[1 - s]);
+      if ((gain > 0 && weightOther <= allowed[1 - s]) || (gain == 0 && improvesBalance)) {
+        side[v] = 1 - s;
+        weight[s] -= graph.vwgt[v];
+        weight[1 - s] += graph.vwgt[v];
+        numberMoves++;
+      }
+    }
+    if (numberMoves == 0) break;
+  }
+
+  //2) Balancing: vertices of the overloaded side are moved by decreasing gain
+  for (int s = 0; s < 2; s++) {
+    if (weight[s] <= allowed[s]) continue;
+    vector< pair<int, int> > candidates;
+    for (int v = 0; v < n; v++) {
+      if (side[v] != s) continue;
+      int gain(0);
+      for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+        gain += (side[graph.adjncy[e]] == s) ? -graph.adjwgt[e] : graph.adjwgt[e];
+      }
+      candidates.push_back(make_pair(-gain, v));
+    }
+    sort(candidates.begin(), candidates.end());
+    for (unsigned int c = 0; c < candidates.size() && weight[s] > allowed[s]; c++) {
+      int v(candidates[c].second);
+      if (weight[1 - s] + graph.vwgt[v] > allowed[1 - s]) continue;
+      side[v] = 1 - s;
+      weight[s] -= graph.vwgt[v];
+      weight[1 - s] += graph.vwgt[v];
+    }
+  }
+}
+
+//***********************************************************************
+
+int GraphPartitioner::cut(const Graph &graph, const vector<int> &side) const
+{
+  int cutWeight(0);
+  for (int v = 0; v < graph.numberVertices(); v++) {
+    for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+      if (side[v] != side[graph.adjncy[e]]) cutWeight += graph.adjwgt[e];
+    }
+  }
+  return cutWeight / 2;
+}
+
+//***********************************************************************
+
+void GraphPartitioner::extractSubgraph(const Graph &graph, const vector<int> &side, const int &whichSide, Graph &subgraph, vector<int> &localToParent) const
+{
+  vector<int> parentToLocal(graph.numberVertices(), -1);
+  localToParent.clear();
+  for (int v = 0; v < graph.numberVertices(); v++) {
+    if (side[v] == whichSide) {
+      parentToLocal[v] = static_cast<int>(localToParent.size());
+      localToParent.push_back(v);
+    }
+  }
+  subgraph.xadj.assign(1, 0);
+  subgraph.adjncy.clear();
+  subgraph.adjwgt.clear();
+  subgraph.vwgt.resize(localToParent.size());
+  for (unsigned int l = 0; l < localToParent.size(); l++) {
+    int v(localToParent[l]);
+    subgraph.vwgt[l] = graph.vwgt[v];
+    for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+      int local(parentToLocal[graph.adjncy[e]]);
+      if (local >= 0) {
+        subgraph.adjncy.push_back(local);
+        subgraph.adjwgt.push_back(graph.adjwgt[e]);
+      }
+    }
+    subgraph.xadj.push_back(static_cast<int>(subgraph.adjncy.size()));
+  }
+}
@@ -0,0 +1,82 @@
+//  
+//       ,---.     ,--,    .---.     ,--,    ,---.    .-. .-. 
+//       | .-'   .' .')   / .-. )  .' .'     | .-'    |  \| | 
+//       | `-.   |  |(_)  | | |(_) |  |  __  | `-.    |   | | 
+//       | .-'   \  \     | | | |  \  \ ( _) | .-'    | |\  | 
+//       |  `--.  \  `-.  \ `-' /   \  `-) ) |  `--.  | | |)| 
+//       /( __.'   \____\  )---'    )\____/  /( __.'  /(  (_) 
+//      (__)              (_)      (__)     (__)     (__)     
+//
+//  This file is part of ECOGEN.
+//
+//  ECOGEN is the legal property of its developers, whose names 
+//  are listed in the copyright file included with this source 
+//  distribution.
+//
+//  ECOGEN is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, 
+//  or (at your option) any later version.
+//  
+//  ECOGEN is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with ECOGEN (file LICENSE).  
+//  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GRAPHPARTITIONER_H
+#define GRAPHPARTITIONER_H
+
+//! \file      GraphPartitioner.h
+//! \version   1.0
+
+#include <vector>
+
+//! \class     GraphPartitioner
+//! \brief     Multilevel recursive bisection of a graph given in compressed (CSR) format
+//! \details   Used to partition the dual graph of an unstructured mesh (one vertex per cell, one edge per face shared by two cells).
+//!            Each bisection coarsens the graph by heavy edge matching, bisects the coarsest graph by greedy graph growing
+//!            and refines the projected bisection on each finer graph with a boundary greedy algorithm.
+class GraphPartitioner
+{
+public:
+  //! \param     xadj             index of the first neighbour of each vertex in adjncy (size: number of vertices + 1)
+  //! \param     adjncy           neighbours of the vertices
+  GraphPartitioner(const std::vector<int> &xadj, const std::vector<int> &adjncy);
+  virtual ~GraphPartitioner();
+
+  //! \brief     Partition of the graph
+  //! \param     numberParts      requested number of parts
+  //! \param     part             part attributed to each vertex (between 0 and numberParts - 1)
+  void partition(const int &numberParts, std::vector<int> &part) const;
+  //! \brief     Number of edges between vertices of different parts
+  int computeEdgeCut(const std::vector<int> &part) const;
+  //! \brief     Ratio between the heaviest part and the average part
+  double computeImbalance(const std::vector<int> &part, const int &numberParts) const;
+
+private:
+  //! \brief     Graph with weighted vertices and edges, used at each level of coarsening
+  struct Graph {
+    std::vector<int> xadj;
+    std::vector<int> adjncy;
+    std::vector<int> vwgt;
+    std::vector<int> adjwgt;
+    int numberVertices() const { return static_cast<int>(xadj.size()) - 1; };
+    int totalWeight() const;
+  };
+
+  void recursiveBisection(const Graph &graph, const std::vector<int> &vertices, const int &numberParts, const int &firstPart, std::vector<int> &part) const;
+  void bisection(const Graph &graph, const double &fraction, std::vector<int> &side) const;
+  void coarsen(const Graph &graph, Graph &coarse, std::vector<int> &map) const;
+  void initialBisection(const Graph &graph, const double &fraction, std::vector<int> &side) const;
+  void refine(const Graph &graph, const double &fraction, std::vector<int> &side) const;
+  int cut(const Graph &graph, const std::vector<int> &side) const;
+  void extractSubgraph(const Graph &graph, const std::vector<int> &side, const int &whichSide, Graph &subgraph, std::vector<int> &localToParent) const;
+
+  Graph m_graph;
+};
+
+#endif // GRAPHPARTITIONER_H
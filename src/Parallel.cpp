@@ -34,18 +34,28 @@
 
 #include "Parallel.h"
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
 #include "Eos/Eos.h"
+#include "timeStats.h"
 
 //Variables linked to parallel computation
 Parallel parallel;
 int rankCpu, Ncpu;
+MPI_Comm commCompute(MPI_COMM_WORLD);
+int groupCpu(-1);
 
 using namespace std;
 
 //***********************************************************************
 
 Parallel::Parallel() :
-  m_stateCPU(1)
+  m_stateCPU(1),
+  m_nodeComm(MPI_COMM_NULL),
+  m_winPrimitives(MPI_WIN_NULL),
+  m_winSequence(MPI_WIN_NULL)
 {}
 
 //***********************************************************************
@@ -60,17 +70,42 @@ void Parallel::initialization(int &argc, char* argv[])
 
   m_isNeighbour = new bool[Ncpu];
   m_whichCpuAmIForNeighbour = new string[Ncpu];
+  m_whichCpuAmIForElementToSend = new vector<string>[Ncpu];
 	m_elementsToSend = new int*[Ncpu];
   m_elementsToReceive = new int*[Ncpu];
   m_numberElementsToSendToNeighbour = new int[Ncpu];
   m_numberElementsToReceiveFromNeighbour = new int[Ncpu]; // A priori can be different if weird mesh !
 
+  m_bufferSendScalar.push_back(new double*[Ncpu]);
+  m_bufferReceiveScalar.push_back(new double*[Ncpu]);
+  m_reqSendScalar.push_back(new MPI_Request*[Ncpu]);
+  m_reqReceiveScalar.push_back(new MPI_Request*[Ncpu]);
+
+  for (int i = 0; i < Ncpu; i++) {
+    m_isNeighbour[i] = false;
+    m_whichCpuAmIForNeighbour[i] = "";
+    m_numberElementsToSendToNeighbour[i] = 0;
+    m_numberElementsToReceiveFromNeighbour[i] = 0;
+		m_elementsToSend[i] = NULL;
+    m_elementsToReceive[i] = NULL;
+    m_bufferSendScalar[0][i] = NULL;
+    m_bufferReceiveScalar[0][i] = NULL;
+    m_reqSendScalar[0][i] = NULL;
+    m_reqReceiveScalar[0][i] = NULL;
+  } 
+  this->allocateCommunicationsLvl0();
+
+  m_statsCommunications.assign(numberTypesCommunication*Ncpu, StatsCommunication());
+}
+
+//***********************************************************************
+
+void Parallel::allocateCommunicationsLvl0()
+{
   m_bufferSend.push_back(new double*[Ncpu]);
   m_bufferReceive.push_back(new double*[Ncpu]);
 	m_bufferSendSlopes.push_back(new double*[Ncpu]);
 	m_bufferReceiveSlopes.push_back(new double*[Ncpu]);
-  m_bufferSendScalar.push_back(new double*[Ncpu]);
-  m_bufferReceiveScalar.push_back(new double*[Ncpu]);
   m_bufferSendVector.push_back(new double*[Ncpu]);
   m_bufferReceiveVector.push_back(new double*[Ncpu]);
   m_bufferSendTransports.push_back(new double*[Ncpu]);
@@ -81,13 +116,12 @@ void Parallel::initialization(int &argc, char* argv[])
 	m_bufferReceiveSplit.push_back(new bool*[Ncpu]);
 	m_bufferNumberElementsToSendToNeighbor = new int[Ncpu];
 	m_bufferNumberElementsToReceiveFromNeighbour = new int[Ncpu];
+  m_buffersBytes.push_back(vector<long long>(Ncpu, 0));
 
   m_reqSend.push_back(new MPI_Request*[Ncpu]);
   m_reqReceive.push_back(new MPI_Request*[Ncpu]);
 	m_reqSendSlopes.push_back(new MPI_Request*[Ncpu]);
 	m_reqReceiveSlopes.push_back(new MPI_Request*[Ncpu]);
-  m_reqSendScalar.push_back(new MPI_Request*[Ncpu]);
-  m_reqReceiveScalar.push_back(new MPI_Request*[Ncpu]);
   m_reqSendVector.push_back(new MPI_Request*[Ncpu]);
   m_reqReceiveVector.push_back(new MPI_Request*[Ncpu]);
   m_reqSendTransports.push_back(new MPI_Request*[Ncpu]);
@@ -100,12 +134,6 @@ void Parallel::initialization(int &argc, char* argv[])
 	m_reqNumberElementsToReceiveFromNeighbour = new MPI_Request*[Ncpu];
 
   for (int i = 0; i < Ncpu; i++) {
-    m_isNeighbour[i] = false;
-    m_whichCpuAmIForNeighbour[i] = "";
-    m_numberElementsToSendToNeighbour[i] = 0;
-    m_numberElementsToReceiveFromNeighbour[i] = 0;
-		m_elementsToSend[i] = NULL;
-    m_elementsToReceive[i] = NULL;
     m_bufferSend[0][i] = NULL;
     m_bufferReceive[0][i] = NULL;
     m_reqSend[0][i] = NULL;
@@ -114,10 +142,6 @@ void Parallel::initialization(int &argc, char* argv[])
 		m_bufferReceiveSlopes[0][i] = NULL;
 		m_reqSendSlopes[0][i] = NULL;
 		m_reqReceiveSlopes[0][i] = NULL;
-    m_bufferSendScalar[0][i] = NULL;
-    m_bufferReceiveScalar[0][i] = NULL;
-    m_reqSendScalar[0][i] = NULL;
-    m_reqReceiveScalar[0][i] = NULL;
     m_bufferSendVector[0][i] = NULL;
     m_bufferReceiveVector[0][i] = NULL;
     m_reqSendVector[0][i] = NULL;
@@ -138,7 +162,31 @@ void Parallel::initialization(int &argc, char* argv[])
 		m_bufferNumberElementsToReceiveFromNeighbour[i] = 0;
 		m_reqNumberElementsToSendToNeighbor[i] = NULL;
 		m_reqNumberElementsToReceiveFromNeighbour[i] = NULL;
-  } 
+  }
+}
+
+//***********************************************************************
+
+void Parallel::resetNeighbours()
+{
+  if (Ncpu == 1) return;
+
+  //Neighbours and elements to exchange are given again by the mesh
+  for (int i = 0; i < Ncpu; i++) {
+    m_isNeighbour[i] = false;
+    m_whichCpuAmIForNeighbour[i] = "";
+    m_whichCpuAmIForElementToSend[i].clear();
+    m_numberElementsToSendToNeighbour[i] = 0;
+    m_numberElementsToReceiveFromNeighbour[i] = 0;
+    delete[] m_elementsToSend[i];
+    delete[] m_elementsToReceive[i];
+    m_elementsToSend[i] = NULL;
+    m_elementsToReceive[i] = NULL;
+  }
+
+  //Level 0 of the persistent communications, the AMR levels being released by finalizeAMR
+  m_buffersBytes.clear();
+  this->allocateCommunicationsLvl0();
 }
 
 //***********************************************************************
@@ -152,8 +200,17 @@ void Parallel::setNeighbour(const int neighbour, string whichCpuAmIForNeighbour)
 //***********************************************************************
 
 void Parallel::setElementsToSend(const int neighbour, int* numberElement, const int &numberElements)
+{
+  vector<string> whichCpuAmIForElement(numberElements, m_whichCpuAmIForNeighbour[neighbour]);
+  this->setElementsToSend(neighbour, numberElement, numberElements, whichCpuAmIForElement);
+}
+
+//***********************************************************************
+
+void Parallel::setElementsToSend(const int neighbour, int* numberElement, const int &numberElements, const vector<string> &whichCpuAmIForElement)
 {
   m_numberElementsToSendToNeighbour[neighbour] = numberElements;
+  m_whichCpuAmIForElementToSend[neighbour] = whichCpuAmIForElement;
 
   //We size the table where will be stored the numbers of elements to send to neighbour "neighbour"
 	m_elementsToSend[neighbour] = new int[numberElements];
@@ -186,7 +243,7 @@ void Parallel::initializePersistentCommunications(const int &numberPrimitiveVari
     m_numberSlopeVariables = numberSlopeVariables;
     m_numberTransportVariables = numberTransportVariables;
 		//Initialization of communications of primitive variables from resolved model
-		parallel.initializePersistentCommunicationsPrimitives();
+		parallel.initializePersistentCommunicationsPrimitives(true);
 		//Initialization of communications of slopes for second order
 		parallel.initializePersistentCommunicationsSlopes();
 		//Initialization of communications necessary for additional physics (vectors of dim=3)
@@ -194,15 +251,16 @@ void Parallel::initializePersistentCommunications(const int &numberPrimitiveVari
     //Initialization of communications of transported variables
     parallel.initializePersistentCommunicationsTransports();
 	}
-	MPI_Barrier(MPI_COMM_WORLD);
+	MPI_Barrier(commCompute);
 }
 
 //***********************************************************************
 
 void Parallel::computeDt(double &dt)
 {
+  PROFILE_SCOPE("communications time step");
 	double dt_temp = dt;
-	MPI_Allreduce(&dt_temp, &dt, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+	MPI_Allreduce(&dt_temp, &dt, 1, MPI_DOUBLE, MPI_MIN, commCompute);
 }
 
 //***********************************************************************
@@ -210,8 +268,8 @@ void Parallel::computeDt(double &dt)
 void Parallel::computePMax(double &pMax, double &pMaxWall)
 {
   double pMax_temp(pMax), pMaxWall_temp(pMaxWall);
-  MPI_Allreduce(&pMax_temp, &pMax, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-  MPI_Allreduce(&pMaxWall_temp, &pMaxWall, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Allreduce(&pMax_temp, &pMax, 1, MPI_DOUBLE, MPI_MAX, commCompute);
+  MPI_Allreduce(&pMaxWall_temp, &pMaxWall, 1, MPI_DOUBLE, MPI_MAX, commCompute);
 }
 
 //***********************************************************************
@@ -224,14 +282,14 @@ void Parallel::finalize(const int &lvlMax)
 		this->finalizePersistentCommunicationsVector(lvlMax);
     this->finalizePersistentCommunicationsTransports(lvlMax);
 	}
-	MPI_Barrier(MPI_COMM_WORLD);
+	MPI_Barrier(commCompute);
 }
 
 //***********************************************************************
 
 void Parallel::stopRun()
 {
-	MPI_Barrier(MPI_COMM_WORLD);
+	MPI_Barrier(commCompute);
 	MPI_Finalize();
 	exit(0);
 }
@@ -240,24 +298,176 @@ void Parallel::stopRun()
 
 void Parallel::verifyStateCPUs()
 {
+  PROFILE_SCOPE("communications errors");
 	//Gathering of errors
 	int nbErr_temp(0);
 	int nbErr(errors.size());
-	MPI_Allreduce(&nbErr, &nbErr_temp, 1, MPI_INTEGER, MPI_SUM, MPI_COMM_WORLD);
+	MPI_Allreduce(&nbErr, &nbErr_temp, 1, MPI_INTEGER, MPI_SUM, commCompute);
 	//Stop if error on one CPU
 	if (nbErr_temp) {
 		Errors::arretCodeApresError(errors);
 	}
 }
 
+//****************************************************************************
+//******************** Communications instrumentation ************************
+//****************************************************************************
+
+void Parallel::recordCommunication(const TypeCommunication &type, const int &neighbour, const long long &bytesSent, const long long &bytesReceived,
+  const double &timePack, const double &timeWait, const double &timeUnpack, const int &messages)
+{
+  StatsCommunication &stats(m_statsCommunications[type*Ncpu + neighbour]);
+  stats.messages += messages;
+  stats.bytesSent += bytesSent;
+  stats.bytesReceived += bytesReceived;
+  stats.timePack += timePack;
+  stats.timeWait += timeWait;
+  stats.timeUnpack += timeUnpack;
+}
+
+//***********************************************************************
+
+void Parallel::ecritStatsCommunications(const string &folder) const
+{
+  if (Ncpu == 1) return;
+  const char* nameTypes[numberTypesCommunication] = { "primitives", "slopes", "vectors", "transports", "xi", "split", "ghostCells" };
+
+  //1) Table of the exchanges of the CPU
+  //------------------------------------
+  stringstream name;
+  name << folder << "communications_CPU" << rankCpu << ".out";
+  ofstream fileStream(name.str().c_str(), ios::out | ios::trunc);
+  fileStream << "# Exchanges of CPU " << rankCpu << " (times in s)" << endl;
+  fileStream << left << setw(12) << "# type" << right << setw(10) << "neighbour" << setw(12) << "messages" << setw(16) << "bytesSent" << setw(16) << "bytesReceived"
+    << setw(14) << "timePack" << setw(14) << "timeWait" << setw(14) << "timeUnpack" << endl;
+  StatsCommunication total = StatsCommunication();
+  for (int type = 0; type < numberTypesCommunication; type++) {
+    for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
+      const StatsCommunication &stats(m_statsCommunications[type*Ncpu + neighbour]);
+      if (stats.messages == 0 && stats.timeWait == 0.) continue;
+      fileStream << left << setw(12) << nameTypes[type] << right << setw(10) << neighbour << setw(12) << stats.messages << setw(16) << stats.bytesSent << setw(16) << stats.bytesReceived
+        << setw(14) << stats.timePack << setw(14) << stats.timeWait << setw(14) << stats.timeUnpack << endl;
+      total.messages += stats.messages; total.bytesSent += stats.bytesSent; total.bytesReceived += stats.bytesReceived;
+      total.timePack += stats.timePack; total.timeWait += stats.timeWait; total.timeUnpack += stats.timeUnpack;
+    }
+  }
+  fileStream << left << setw(12) << "total" << right << setw(10) << "all" << setw(12) << total.messages << setw(16) << total.bytesSent << setw(16) << total.bytesReceived
+    << setw(14) << total.timePack << setw(14) << total.timeWait << setw(14) << total.timeUnpack << endl;
+  fileStream.close();
+
+  //2) Communication matrix of all the CPUs (line: CPU, column: neighbour)
+  //----------------------------------------------------------------------
+  vector<double> bytesSent(Ncpu, 0.), messages(Ncpu, 0.), timeWait(Ncpu, 0.);
+  for (int type = 0; type < numberTypesCommunication; type++) {
+    for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
+      const StatsCommunication &stats(m_statsCommunications[type*Ncpu + neighbour]);
+      bytesSent[neighbour] += static_cast<double>(stats.bytesSent);
+      messages[neighbour] += static_cast<double>(stats.messages);
+      timeWait[neighbour] += stats.timeWait;
+    }
+  }
+  vector<double> matrixBytes, matrixMessages, matrixWait;
+  if (rankCpu == 0) { matrixBytes.resize(Ncpu*Ncpu); matrixMessages.resize(Ncpu*Ncpu); matrixWait.resize(Ncpu*Ncpu); }
+  MPI_Gather(&bytesSent[0], Ncpu, MPI_DOUBLE, matrixBytes.data(), Ncpu, MPI_DOUBLE, 0, commCompute);
+  MPI_Gather(&messages[0], Ncpu, MPI_DOUBLE, matrixMessages.data(), Ncpu, MPI_DOUBLE, 0, commCompute);
+  MPI_Gather(&timeWait[0], Ncpu, MPI_DOUBLE, matrixWait.data(), Ncpu, MPI_DOUBLE, 0, commCompute);
+  if (rankCpu != 0) return;
+  fileStream.open((folder + "communicationMatrix.out").c_str(), ios::out | ios::trunc);
+  fileStream.precision(12);
+  const vector<double>* matrices[3] = { &matrixBytes, &matrixMessages, &matrixWait };
+  const char* titles[3] = { "Bytes sent by CPU (line) to CPU (column)", "Messages sent by CPU (line) to CPU (column)",
+    "Waiting time (s) of CPU (line) in the exchanges with CPU (column)" };
+  for (int m = 0; m < 3; m++) {
+    fileStream << "# " << titles[m] << endl;
+    for (int cpu = 0; cpu < Ncpu; cpu++) {
+      for (int neighbour = 0; neighbour < Ncpu; neighbour++) { fileStream << (*matrices[m])[cpu*Ncpu + neighbour] << " "; }
+      fileStream << endl;
+    }
+    fileStream << endl << endl;
+  }
+  fileStream.close();
+}
+
+//***********************************************************************
+
+long long Parallel::getBuffersBytes() const
+{
+  long long bytes(0);
+  for (unsigned int lvl = 0; lvl < m_buffersBytes.size(); lvl++) {
+    for (unsigned int neighbour = 0; neighbour < m_buffersBytes[lvl].size(); neighbour++) { bytes += m_buffersBytes[lvl][neighbour]; }
+  }
+  return bytes;
+}
+
 //****************************************************************************
 //**************** Methods for all the primitive variables *******************
 //****************************************************************************
 
-void Parallel::initializePersistentCommunicationsPrimitives()
+void Parallel::initializePersistentCommunicationsPrimitives(const bool &sharedWindow)
 {
+  m_nodeRankOfCpu = new int[Ncpu];
+  m_offsetSharedSend = new int[Ncpu];
+  m_sharedReceive = new double*[Ncpu];
+  m_sizeSharedNeighbour = new int[Ncpu];
+  m_sequenceNeighbour = new long long*[Ncpu];
   for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
-    if (m_isNeighbour[neighbour]) {
+    m_nodeRankOfCpu[neighbour] = MPI_UNDEFINED;
+    m_offsetSharedSend[neighbour] = 0;
+    m_sharedReceive[neighbour] = NULL;
+    m_sizeSharedNeighbour[neighbour] = 0;
+    m_sequenceNeighbour[neighbour] = NULL;
+  }
+  m_sizeSharedSend = 0;
+  m_sharedHalf = 0;
+
+  if (sharedWindow) {
+    //Node-local communicator: neighbours sharing this node exchange primitives through a shared window
+    MPI_Comm_split_type(commCompute, MPI_COMM_TYPE_SHARED, rankCpu, MPI_INFO_NULL, &m_nodeComm);
+    MPI_Group computeGroup, nodeGroup;
+    MPI_Comm_group(commCompute, &computeGroup);
+    MPI_Comm_group(m_nodeComm, &nodeGroup);
+    int *computeRanks = new int[Ncpu];
+    for (int i = 0; i < Ncpu; i++) { computeRanks[i] = i; }
+    MPI_Group_translate_ranks(computeGroup, Ncpu, computeRanks, nodeGroup, m_nodeRankOfCpu);
+    MPI_Group_free(&computeGroup);
+    MPI_Group_free(&nodeGroup);
+    delete[] computeRanks;
+
+    //Own window: one packed block per neighbour on the node, twice for double buffering
+    for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
+      if (this->isSharedNeighbour(neighbour)) {
+        m_offsetSharedSend[neighbour] = m_sizeSharedSend;
+        m_sizeSharedSend += m_numberPrimitiveVariables*m_numberElementsToSendToNeighbour[neighbour];
+      }
+    }
+    MPI_Win_allocate_shared(2 * m_sizeSharedSend * sizeof(double), sizeof(double), MPI_INFO_NULL, m_nodeComm, &m_sharedSend, &m_winPrimitives);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, m_winPrimitives);
+    m_buffersBytes[0][rankCpu] += 2 * m_sizeSharedSend * sizeof(double);
+    //Number of exchanges published by each CPU, read by its neighbours on the node instead of a node-wide barrier
+    MPI_Win_allocate_shared(sizeof(long long), sizeof(long long), MPI_INFO_NULL, m_nodeComm, &m_sequence, &m_winSequence);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, m_winSequence);
+    *m_sequence = 0;
+    MPI_Win_sync(m_winSequence);
+
+    //Each neighbour of the node tells where its block for this CPU is located in its window
+    for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
+      if (this->isSharedNeighbour(neighbour)) {
+        int offsetNeighbour(0);
+        MPI_Sendrecv(&m_offsetSharedSend[neighbour], 1, MPI_INT, neighbour, neighbour, &offsetNeighbour, 1, MPI_INT, neighbour, rankCpu, commCompute, MPI_STATUS_IGNORE);
+        MPI_Aint sizeWindow; int dispUnit; double *baseNeighbour;
+        MPI_Win_shared_query(m_winPrimitives, m_nodeRankOfCpu[neighbour], &sizeWindow, &dispUnit, &baseNeighbour);
+        m_sizeSharedNeighbour[neighbour] = static_cast<int>(sizeWindow / (2 * sizeof(double)));
+        m_sharedReceive[neighbour] = baseNeighbour + offsetNeighbour;
+        MPI_Win_shared_query(m_winSequence, m_nodeRankOfCpu[neighbour], &sizeWindow, &dispUnit, &m_sequenceNeighbour[neighbour]);
+      }
+    }
+    //Initial numbers of exchanges visible to all the neighbours before the first exchange
+    MPI_Barrier(m_nodeComm);
+  }
+
+  //Message path for the neighbours on other nodes only
+  for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
+    if (m_isNeighbour[neighbour] && !this->isSharedNeighbour(neighbour)) {
       //Determination of the number of variables to communicate
       int numberSend = m_numberPrimitiveVariables*m_numberElementsToSendToNeighbour[neighbour];
       int numberReceive = m_numberPrimitiveVariables*m_numberElementsToReceiveFromNeighbour[neighbour];
@@ -265,12 +475,13 @@ void Parallel::initializePersistentCommunicationsPrimitives()
       //New sending request and its associated buffer
       m_reqSend[0][neighbour] = new MPI_Request;
       m_bufferSend[0][neighbour] = new double[numberSend];
-      MPI_Send_init(m_bufferSend[0][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSend[0][neighbour]);
+      MPI_Send_init(m_bufferSend[0][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSend[0][neighbour]);
 
       //New receiving request and its associated buffer
       m_reqReceive[0][neighbour] = new MPI_Request;
       m_bufferReceive[0][neighbour] = new double[numberReceive];
-      MPI_Recv_init(m_bufferReceive[0][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceive[0][neighbour]);
+      m_buffersBytes[0][neighbour] += (numberSend + numberReceive)*sizeof(double);
+      MPI_Recv_init(m_bufferReceive[0][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceive[0][neighbour]);
     }
   }
 }
@@ -281,7 +492,7 @@ void Parallel::finalizePersistentCommunicationsPrimitives(const int &lvlMax)
 {
 	for (int lvl = 0; lvl <= lvlMax; lvl++) {
 		for (int neighbour = 0; neighbour < Ncpu; neighbour++)	{
-			if (m_isNeighbour[neighbour]) {
+			if (m_isNeighbour[neighbour] && m_reqSend[lvl][neighbour] != NULL) {
 				MPI_Request_free(m_reqSend[lvl][neighbour]);
 				MPI_Request_free(m_reqReceive[lvl][neighbour]);
         delete m_reqSend[lvl][neighbour];
@@ -299,23 +510,77 @@ void Parallel::finalizePersistentCommunicationsPrimitives(const int &lvlMax)
   m_bufferSend.clear();
   m_reqReceive.clear();
   m_bufferReceive.clear();
+
+  if (m_winPrimitives != MPI_WIN_NULL) {
+    MPI_Win_unlock_all(m_winPrimitives);
+    MPI_Win_free(&m_winPrimitives);
+    MPI_Win_unlock_all(m_winSequence);
+    MPI_Win_free(&m_winSequence);
+    MPI_Comm_free(&m_nodeComm);
+  }
+  delete[] m_nodeRankOfCpu;
+  delete[] m_offsetSharedSend;
+  delete[] m_sharedReceive;
+  delete[] m_sizeSharedNeighbour;
+  delete[] m_sequenceNeighbour;
 }
 
 //***********************************************************************
 
 void Parallel::communicationsPrimitives(Cell **cells, Eos **eos, Prim type)
 {
+  PROFILE_SCOPE("communications primitives");
   int count(0);
   MPI_Status status;
 
+  if (m_winPrimitives != MPI_WIN_NULL) {
+    //Neighbours on the same node: packing directly in the shared window
+    for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
+      if (this->isSharedNeighbour(neighbour)) {
+        double tStart(MPI_Wtime());
+        double *block = m_sharedSend + m_sharedHalf*m_sizeSharedSend + m_offsetSharedSend[neighbour];
+        count = -1;
+        for (int i = 0; i < m_numberElementsToSendToNeighbour[neighbour]; i++) {
+          cells[m_elementsToSend[neighbour][i]]->fillBufferPrimitives(block, count, type);
+        }
+        this->recordCommunication(comPrimitives, neighbour, (count + 1)*sizeof(double), 0, MPI_Wtime() - tStart, 0., 0.);
+      }
+    }
+    //Publication of the packed blocks, then each neighbour of the node is awaited individually
+    //The two halves alternate: a neighbour having published the next exchange has finished reading the half about to be overwritten
+    MPI_Win_sync(m_winPrimitives);
+    (*m_sequence)++;
+    MPI_Win_sync(m_winSequence);
+    for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
+      if (this->isSharedNeighbour(neighbour)) {
+        double tWait(MPI_Wtime());
+        volatile long long *sequenceNeighbour(m_sequenceNeighbour[neighbour]);
+        while (*sequenceNeighbour < *m_sequence) { this_thread::yield(); MPI_Win_sync(m_winSequence); }
+        MPI_Win_sync(m_winPrimitives);
+        double tReceive(MPI_Wtime());
+        double *block = m_sharedReceive[neighbour] + m_sharedHalf*m_sizeSharedNeighbour[neighbour];
+        count = -1;
+        for (int i = 0; i < m_numberElementsToReceiveFromNeighbour[neighbour]; i++) {
+          cells[m_elementsToReceive[neighbour][i]]->getBufferPrimitives(block, count, eos, type);
+        }
+        this->recordCommunication(comPrimitives, neighbour, 0, (count + 1)*sizeof(double), 0., tReceive - tWait, MPI_Wtime() - tReceive, 0);
+      }
+    }
+    m_sharedHalf = 1 - m_sharedHalf;
+  }
+
+  //Neighbours on other nodes: message path
   for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
-    if (m_isNeighbour[neighbour]) {
+    if (m_isNeighbour[neighbour] && !this->isSharedNeighbour(neighbour)) {
+      double tStart(MPI_Wtime());
       //Prepation of sendings
       count = -1;
       for (int i = 0; i < m_numberElementsToSendToNeighbour[neighbour]; i++) {
 				cells[m_elementsToSend[neighbour][i]]->fillBufferPrimitives(m_bufferSend[0][neighbour], count, type);
       }
 
+      int numberSend(count + 1);
+      double tSend(MPI_Wtime());
       //Sending request
       MPI_Start(m_reqSend[0][neighbour]);
       //Receiving request
@@ -323,16 +588,25 @@ void Parallel::communicationsPrimitives(Cell **cells, Eos **eos, Prim type)
       //Waiting
       MPI_Wait(m_reqSend[0][neighbour], &status);
       MPI_Wait(m_reqReceive[0][neighbour], &status);
+      double tReceive(MPI_Wtime());
 
       //Receivings
       count = -1;
       for (int i = 0; i < m_numberElementsToReceiveFromNeighbour[neighbour]; i++) {
 				cells[m_elementsToReceive[neighbour][i]]->getBufferPrimitives(m_bufferReceive[0][neighbour], count, eos, type);
       }
+      this->recordCommunication(comPrimitives, neighbour, numberSend*sizeof(double), (count + 1)*sizeof(double), tSend - tStart, tReceive - tSend, MPI_Wtime() - tReceive);
     }
   }
 }
 
+//***********************************************************************
+
+bool Parallel::isSharedNeighbour(const int neighbour) const
+{
+  return (m_isNeighbour[neighbour] && m_nodeRankOfCpu[neighbour] != MPI_UNDEFINED);
+}
+
 //****************************************************************************
 //********************** Methods for all the slopes **************************
 //****************************************************************************
@@ -348,12 +622,13 @@ void Parallel::initializePersistentCommunicationsSlopes()
 			//New sending request and its associated buffer
 			m_reqSendSlopes[0][neighbour] = new MPI_Request;
 			m_bufferSendSlopes[0][neighbour] = new double[numberSend];
-			MPI_Send_init(m_bufferSendSlopes[0][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendSlopes[0][neighbour]);
+			MPI_Send_init(m_bufferSendSlopes[0][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSendSlopes[0][neighbour]);
 
 			//New receiving request and its associated buffer
 			m_reqReceiveSlopes[0][neighbour] = new MPI_Request;
 			m_bufferReceiveSlopes[0][neighbour] = new double[numberReceive];
-			MPI_Recv_init(m_bufferReceiveSlopes[0][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveSlopes[0][neighbour]);
+			m_buffersBytes[0][neighbour] += (numberSend + numberReceive)*sizeof(double);
+			MPI_Recv_init(m_bufferReceiveSlopes[0][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceiveSlopes[0][neighbour]);
 		}
 	}
 }
@@ -388,17 +663,21 @@ void Parallel::finalizePersistentCommunicationsSlopes(const int &lvlMax)
 
 void Parallel::communicationsSlopes(Cell **cells)
 {
+  PROFILE_SCOPE("communications slopes");
 	int count(0);
 	MPI_Status status;
 
 	for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
 		if (m_isNeighbour[neighbour]) {
+			double tStart(MPI_Wtime());
 			//Prepation of sendings
 			count = -1;
 			for (int i = 0; i < m_numberElementsToSendToNeighbour[neighbour]; i++) {
-				cells[m_elementsToSend[neighbour][i]]->fillBufferSlopes(m_bufferSendSlopes[0][neighbour], count, m_whichCpuAmIForNeighbour[neighbour]);
+				cells[m_elementsToSend[neighbour][i]]->fillBufferSlopes(m_bufferSendSlopes[0][neighbour], count, m_whichCpuAmIForElementToSend[neighbour][i]);
 			}
       
+			int numberSend(count + 1);
+			double tSend(MPI_Wtime());
 			//Sending request
 			MPI_Start(m_reqSendSlopes[0][neighbour]);
 			//Receiving request
@@ -406,12 +685,14 @@ void Parallel::communicationsSlopes(Cell **cells)
 			//Waiting
 			MPI_Wait(m_reqSendSlopes[0][neighbour], &status);
 			MPI_Wait(m_reqReceiveSlopes[0][neighbour], &status);
+			double tReceive(MPI_Wtime());
 
 			//Receivings
 			count = -1;
 			for (int i = 0; i < m_numberElementsToReceiveFromNeighbour[neighbour]; i++) {
 				cells[m_elementsToReceive[neighbour][i]]->getBufferSlopes(m_bufferReceiveSlopes[0][neighbour], count);
 			}
+			this->recordCommunication(comSlopes, neighbour, numberSend*sizeof(double), (count + 1)*sizeof(double), tSend - tStart, tReceive - tSend, MPI_Wtime() - tReceive);
 		}
 	}
 }
@@ -434,12 +715,13 @@ void Parallel::initializePersistentCommunicationsScalar()
       //New sending request and its associated buffer
       m_reqSendScalar[0][neighbour] = new MPI_Request;
       m_bufferSendScalar[0][neighbour] = new double[numberSend];
-      MPI_Send_init(m_bufferSendScalar[0][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendScalar[0][neighbour]);
+      MPI_Send_init(m_bufferSendScalar[0][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSendScalar[0][neighbour]);
 
       //New receiving request and its associated buffer
       m_reqReceiveScalar[0][neighbour] = new MPI_Request;
       m_bufferReceiveScalar[0][neighbour] = new double[numberReceive];
-      MPI_Recv_init(m_bufferReceiveScalar[0][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveScalar[0][neighbour]);
+      m_buffersBytes[0][neighbour] += (numberSend + numberReceive)*sizeof(double);
+      MPI_Recv_init(m_bufferReceiveScalar[0][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceiveScalar[0][neighbour]);
     }
   }
 }
@@ -485,12 +767,13 @@ void Parallel::initializePersistentCommunicationsVector(const int &dim)
 			//New sending request and its associated buffer
 			m_reqSendVector[0][neighbour] = new MPI_Request;
 			m_bufferSendVector[0][neighbour] = new double[numberSend];
-			MPI_Send_init(m_bufferSendVector[0][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendVector[0][neighbour]);
+			MPI_Send_init(m_bufferSendVector[0][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSendVector[0][neighbour]);
 
 			//New receiving request and its associated buffer
 			m_reqReceiveVector[0][neighbour] = new MPI_Request;
 			m_bufferReceiveVector[0][neighbour] = new double[numberReceive];
-			MPI_Recv_init(m_bufferReceiveVector[0][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveVector[0][neighbour]);
+			m_buffersBytes[0][neighbour] += (numberSend + numberReceive)*sizeof(double);
+			MPI_Recv_init(m_bufferReceiveVector[0][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceiveVector[0][neighbour]);
 		}
 	}
 }
@@ -525,11 +808,13 @@ void Parallel::finalizePersistentCommunicationsVector(const int &lvlMax)
 
 void Parallel::communicationsVector(Cell **cells, string nameVector, const int &dim, int num, int index)
 {
+  PROFILE_SCOPE("communications vectors");
 	int count(0);
 	MPI_Status status;
 
 	for (int neighbour = 0; neighbour < Ncpu; neighbour++)	{
 		if (m_isNeighbour[neighbour]) {
+			double tStart(MPI_Wtime());
 			//Prepation of sendings
 			count = -1;
 			for (int i = 0; i < m_numberElementsToSendToNeighbour[neighbour]; i++)	{
@@ -537,6 +822,8 @@ void Parallel::communicationsVector(Cell **cells, string nameVector, const int &
 				cells[m_elementsToSend[neighbour][i]]->fillBufferVector(m_bufferSendVector[0][neighbour], count, dim, nameVector, num, index);
 			}
 
+			int numberSend(count + 1);
+			double tSend(MPI_Wtime());
 			//Sending request
 			MPI_Start(m_reqSendVector[0][neighbour]);
 			//Receiving request
@@ -544,6 +831,7 @@ void Parallel::communicationsVector(Cell **cells, string nameVector, const int &
 			//Waiting
 			MPI_Wait(m_reqSendVector[0][neighbour], &status);
 			MPI_Wait(m_reqReceiveVector[0][neighbour], &status);
+			double tReceive(MPI_Wtime());
 
 			//Receivings
 			count = -1;
@@ -551,6 +839,7 @@ void Parallel::communicationsVector(Cell **cells, string nameVector, const int &
 			  //Automatic filing of m_bufferReceiveVector in function of the gradient coordinates
 				cells[m_elementsToReceive[neighbour][i]]->getBufferVector(m_bufferReceiveVector[0][neighbour], count, dim, nameVector, num, index);
 			}
+			this->recordCommunication(comVectors, neighbour, numberSend*sizeof(double), (count + 1)*sizeof(double), tSend - tStart, tReceive - tSend, MPI_Wtime() - tReceive);
 		} //End neighbour
 	}
 }
@@ -570,12 +859,13 @@ void Parallel::initializePersistentCommunicationsTransports()
       //New sending request and its associated buffer
       m_reqSendTransports[0][neighbour] = new MPI_Request;
       m_bufferSendTransports[0][neighbour] = new double[numberSend];
-      MPI_Send_init(m_bufferSendTransports[0][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendTransports[0][neighbour]);
+      MPI_Send_init(m_bufferSendTransports[0][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSendTransports[0][neighbour]);
 
       //New receiving request and its associated buffer
       m_reqReceiveTransports[0][neighbour] = new MPI_Request;
       m_bufferReceiveTransports[0][neighbour] = new double[numberReceive];
-      MPI_Recv_init(m_bufferReceiveTransports[0][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveTransports[0][neighbour]);
+      m_buffersBytes[0][neighbour] += (numberSend + numberReceive)*sizeof(double);
+      MPI_Recv_init(m_bufferReceiveTransports[0][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceiveTransports[0][neighbour]);
     }
   }
 }
@@ -611,17 +901,21 @@ void Parallel::finalizePersistentCommunicationsTransports(const int &lvlMax)
 
 void Parallel::communicationsTransports(Cell **cells)
 {
+  PROFILE_SCOPE("communications transports");
   int count(0);
   MPI_Status status;
 
   for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
     if (m_isNeighbour[neighbour]) {
+      double tStart(MPI_Wtime());
       //Prepation of sendings
       count = -1;
       for (int i = 0; i < m_numberElementsToSendToNeighbour[neighbour]; i++) {
         cells[m_elementsToSend[neighbour][i]]->fillBufferTransports(m_bufferSendTransports[0][neighbour], count);
       }
 
+      int numberSend(count + 1);
+      double tSend(MPI_Wtime());
       //Sending request
       MPI_Start(m_reqSendTransports[0][neighbour]);
       //Receiving request
@@ -629,12 +923,14 @@ void Parallel::communicationsTransports(Cell **cells)
       //Waiting
       MPI_Wait(m_reqSendTransports[0][neighbour], &status);
       MPI_Wait(m_reqReceiveTransports[0][neighbour], &status);
+      double tReceive(MPI_Wtime());
 
       //Receivings
       count = -1;
       for (int i = 0; i < m_numberElementsToReceiveFromNeighbour[neighbour]; i++) {
         cells[m_elementsToReceive[neighbour][i]]->getBufferTransports(m_bufferReceiveTransports[0][neighbour], count);
       }
+      this->recordCommunication(comTransports, neighbour, numberSend*sizeof(double), (count + 1)*sizeof(double), tSend - tStart, tReceive - tSend, MPI_Wtime() - tReceive);
     }
   }
 }
@@ -649,8 +945,8 @@ void Parallel::initializePersistentCommunicationsAMR(const int &numberPrimitiveV
 		m_numberPrimitiveVariables = numberPrimitiveVariables;
 		m_numberSlopeVariables = numberSlopeVariables;
     m_numberTransportVariables = numberTransportVariables;
-		//Initialization of communications of primitive variables from resolved model
-		parallel.initializePersistentCommunicationsPrimitives();
+		//Initialization of communications of primitive variables from resolved model (the AMR exchanges keep the message path)
+		parallel.initializePersistentCommunicationsPrimitives(false);
 		//Initialization of communications of slopes for second order
 		parallel.initializePersistentCommunicationsSlopes();
 		//Initialization of communications necessary for additional physics (vectors of dim=3)
@@ -664,7 +960,7 @@ void Parallel::initializePersistentCommunicationsAMR(const int &numberPrimitiveV
 		//Initialization of communications for the levels superior to 0
 		parallel.initializePersistentCommunicationsLvlAMR(lvlMax);
 	}
-	MPI_Barrier(MPI_COMM_WORLD);
+	MPI_Barrier(commCompute);
 }
 
 //***********************************************************************
@@ -685,6 +981,7 @@ void Parallel::initializePersistentCommunicationsLvlAMR(const int &lvlMax)
 		m_bufferReceiveXi.push_back(new double*[Ncpu]);
 		m_bufferSendSplit.push_back(new bool*[Ncpu]);
 		m_bufferReceiveSplit.push_back(new bool*[Ncpu]);
+		m_buffersBytes.push_back(vector<long long>(Ncpu, 0));
 
 		m_reqSend.push_back(new MPI_Request*[Ncpu]);
 		m_reqReceive.push_back(new MPI_Request*[Ncpu]);
@@ -739,72 +1036,78 @@ void Parallel::initializePersistentCommunicationsLvlAMR(const int &lvlMax)
 				//New sending request and its associated buffer
 				m_reqSend[lvl][neighbour] = new MPI_Request;
 				m_bufferSend[lvl][neighbour] = new double[numberSend];
-				MPI_Send_init(m_bufferSend[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSend[lvl][neighbour]);
+				MPI_Send_init(m_bufferSend[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSend[lvl][neighbour]);
 
 				//New receiving request and its associated buffer
 				m_reqReceive[lvl][neighbour] = new MPI_Request;
 				m_bufferReceive[lvl][neighbour] = new double[numberReceive];
-				MPI_Recv_init(m_bufferReceive[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceive[lvl][neighbour]);
+				m_buffersBytes[lvl][neighbour] += (numberSend + numberReceive)*sizeof(double);
+				MPI_Recv_init(m_bufferReceive[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceive[lvl][neighbour]);
 
 				//Slope variables
 				//---------------
 				//New sending request and its associated buffer
 				m_reqSendSlopes[lvl][neighbour] = new MPI_Request;
 				m_bufferSendSlopes[lvl][neighbour] = new double[numberSend];
-				MPI_Send_init(m_bufferSendSlopes[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendSlopes[lvl][neighbour]);
+				MPI_Send_init(m_bufferSendSlopes[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSendSlopes[lvl][neighbour]);
 
 				//New receiving request and its associated buffer
 				m_reqReceiveSlopes[lvl][neighbour] = new MPI_Request;
 				m_bufferReceiveSlopes[lvl][neighbour] = new double[numberReceive];
-				MPI_Recv_init(m_bufferReceiveSlopes[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveSlopes[lvl][neighbour]);
+				m_buffersBytes[lvl][neighbour] += (numberSend + numberReceive)*sizeof(double);
+				MPI_Recv_init(m_bufferReceiveSlopes[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceiveSlopes[lvl][neighbour]);
 
 				//Vector variables
 				//----------------
 				//New sending request and its associated buffer
 				m_reqSendVector[lvl][neighbour] = new MPI_Request;
 				m_bufferSendVector[lvl][neighbour] = new double[numberSend];
-				MPI_Send_init(m_bufferSendVector[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendVector[lvl][neighbour]);
+				MPI_Send_init(m_bufferSendVector[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSendVector[lvl][neighbour]);
 
 				//New receiving request and its associated buffer
 				m_reqReceiveVector[lvl][neighbour] = new MPI_Request;
 				m_bufferReceiveVector[lvl][neighbour] = new double[numberReceive];
-				MPI_Recv_init(m_bufferReceiveVector[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveVector[lvl][neighbour]);
+				m_buffersBytes[lvl][neighbour] += (numberSend + numberReceive)*sizeof(double);
+				MPI_Recv_init(m_bufferReceiveVector[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceiveVector[lvl][neighbour]);
 
         //Transported variables
         //---------------------
         //New sending request and its associated buffer
         m_reqSendTransports[lvl][neighbour] = new MPI_Request;
         m_bufferSendTransports[lvl][neighbour] = new double[numberSend];
-        MPI_Send_init(m_bufferSendTransports[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendTransports[lvl][neighbour]);
+        MPI_Send_init(m_bufferSendTransports[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSendTransports[lvl][neighbour]);
 
         //New receiving request and its associated buffer
         m_reqReceiveTransports[lvl][neighbour] = new MPI_Request;
         m_bufferReceiveTransports[lvl][neighbour] = new double[numberReceive];
-        MPI_Recv_init(m_bufferReceiveTransports[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveTransports[lvl][neighbour]);
+        m_buffersBytes[lvl][neighbour] += (numberSend + numberReceive)*sizeof(double);
+        MPI_Recv_init(m_bufferReceiveTransports[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceiveTransports[lvl][neighbour]);
 
 				//Xi variable
 				//-----------
 				//New sending request and its associated buffer
 				m_reqSendXi[lvl][neighbour] = new MPI_Request;
 				m_bufferSendXi[lvl][neighbour] = new double[numberSend];
-				MPI_Send_init(m_bufferSendXi[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendXi[lvl][neighbour]);
+				MPI_Send_init(m_bufferSendXi[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSendXi[lvl][neighbour]);
 
 				//New receiving request and its associated buffer
 				m_reqReceiveXi[lvl][neighbour] = new MPI_Request;
 				m_bufferReceiveXi[lvl][neighbour] = new double[numberReceive];
-				MPI_Recv_init(m_bufferReceiveXi[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveXi[lvl][neighbour]);
+				m_buffersBytes[lvl][neighbour] += (numberSend + numberReceive)*sizeof(double);
+				MPI_Recv_init(m_bufferReceiveXi[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceiveXi[lvl][neighbour]);
 
 				//Split variable
 				//--------------
 				//New sending request and its associated buffer
 				m_reqSendSplit[lvl][neighbour] = new MPI_Request;
 				m_bufferSendSplit[lvl][neighbour] = new bool[numberSend];
-				MPI_Send_init(m_bufferSendSplit[lvl][neighbour], numberSend, MPI_C_BOOL, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendSplit[lvl][neighbour]);
+				MPI_Send_init(m_bufferSendSplit[lvl][neighbour], numberSend, MPI_C_BOOL, neighbour, neighbour, commCompute, m_reqSendSplit[lvl][neighbour]);
 
 				//New receiving request and its associated buffer
 				m_reqReceiveSplit[lvl][neighbour] = new MPI_Request;
 				m_bufferReceiveSplit[lvl][neighbour] = new bool[numberReceive];
-				MPI_Recv_init(m_bufferReceiveSplit[lvl][neighbour], numberReceive, MPI_C_BOOL, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveSplit[lvl][neighbour]);
+				m_buffersBytes[lvl][neighbour] += (numberSend + numberReceive)*sizeof(bool);
+				MPI_Recv_init(m_bufferReceiveSplit[lvl][neighbour], numberReceive, MPI_C_BOOL, neighbour, rankCpu, commCompute, m_reqReceiveSplit[lvl][neighbour]);
 			}
 		}
 	}
@@ -814,6 +1117,7 @@ void Parallel::initializePersistentCommunicationsLvlAMR(const int &lvlMax)
 
 void Parallel::updatePersistentCommunicationsLvl(int lvl, const int &dim)
 {
+  PROFILE_SCOPE("communications AMR update");
 	int numberSend(0), numberReceive(0);
 	for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
 		if (m_isNeighbour[neighbour]) {
@@ -846,6 +1150,7 @@ void Parallel::updatePersistentCommunicationsLvl(int lvl, const int &dim)
 			delete m_reqSendSplit[lvl][neighbour];
 			delete m_reqReceiveSplit[lvl][neighbour];
 
+			m_buffersBytes[lvl][neighbour] = 0;
 			delete[] m_bufferSend[lvl][neighbour];
 			delete[] m_bufferReceive[lvl][neighbour];
 			delete[] m_bufferSendSlopes[lvl][neighbour];
@@ -870,12 +1175,13 @@ void Parallel::updatePersistentCommunicationsLvl(int lvl, const int &dim)
 			//New sending request and its associated buffer
 			m_reqSend[lvl][neighbour] = new MPI_Request;
 			m_bufferSend[lvl][neighbour] = new double[numberSend];
-			MPI_Send_init(m_bufferSend[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSend[lvl][neighbour]);
+			MPI_Send_init(m_bufferSend[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSend[lvl][neighbour]);
 
 			//New receiving request and its associated buffer
 			m_reqReceive[lvl][neighbour] = new MPI_Request;
 			m_bufferReceive[lvl][neighbour] = new double[numberReceive];
-			MPI_Recv_init(m_bufferReceive[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceive[lvl][neighbour]);
+			m_buffersBytes[lvl][neighbour] += (numberSend + numberReceive)*sizeof(double);
+			MPI_Recv_init(m_bufferReceive[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceive[lvl][neighbour]);
 
 			//Slope variables
 			//---------------
@@ -884,12 +1190,13 @@ void Parallel::updatePersistentCommunicationsLvl(int lvl, const int &dim)
 			//New sending request and its associated buffer
 			m_reqSendSlopes[lvl][neighbour] = new MPI_Request;
 			m_bufferSendSlopes[lvl][neighbour] = new double[numberSend];
-			MPI_Send_init(m_bufferSendSlopes[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendSlopes[lvl][neighbour]);
+			MPI_Send_init(m_bufferSendSlopes[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSendSlopes[lvl][neighbour]);
 
 			//New receiving request and its associated buffer
 			m_reqReceiveSlopes[lvl][neighbour] = new MPI_Request;
 			m_bufferReceiveSlopes[lvl][neighbour] = new double[numberReceive];
-			MPI_Recv_init(m_bufferReceiveSlopes[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveSlopes[lvl][neighbour]);
+			m_buffersBytes[lvl][neighbour] += (numberSend + numberReceive)*sizeof(double);
+			MPI_Recv_init(m_bufferReceiveSlopes[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceiveSlopes[lvl][neighbour]);
 
 			//Vector variables
 			//----------------
@@ -898,12 +1205,13 @@ void Parallel::updatePersistentCommunicationsLvl(int lvl, const int &dim)
 			//New sending request and its associated buffer
 			m_reqSendVector[lvl][neighbour] = new MPI_Request;
 			m_bufferSendVector[lvl][neighbour] = new double[numberSend];
-			MPI_Send_init(m_bufferSendVector[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendVector[lvl][neighbour]);
+			MPI_Send_init(m_bufferSendVector[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSendVector[lvl][neighbour]);
 
 			//New receiving request and its associated buffer
 			m_reqReceiveVector[lvl][neighbour] = new MPI_Request;
 			m_bufferReceiveVector[lvl][neighbour] = new double[numberReceive];
-			MPI_Recv_init(m_bufferReceiveVector[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveVector[lvl][neighbour]);
+			m_buffersBytes[lvl][neighbour] += (numberSend + numberReceive)*sizeof(double);
+			MPI_Recv_init(m_bufferReceiveVector[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceiveVector[lvl][neighbour]);
 
       //Transported variables
       //---------------------
@@ -912,12 +1220,13 @@ void Parallel::updatePersistentCommunicationsLvl(int lvl, const int &dim)
       //New sending request and its associated buffer
       m_reqSendTransports[lvl][neighbour] = new MPI_Request;
       m_bufferSendTransports[lvl][neighbour] = new double[numberSend];
-      MPI_Send_init(m_bufferSendTransports[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendTransports[lvl][neighbour]);
+      MPI_Send_init(m_bufferSendTransports[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSendTransports[lvl][neighbour]);
 
       //New receiving request and its associated buffer
       m_reqReceiveTransports[lvl][neighbour] = new MPI_Request;
       m_bufferReceiveTransports[lvl][neighbour] = new double[numberReceive];
-      MPI_Recv_init(m_bufferReceiveTransports[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveTransports[lvl][neighbour]);
+      m_buffersBytes[lvl][neighbour] += (numberSend + numberReceive)*sizeof(double);
+      MPI_Recv_init(m_bufferReceiveTransports[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceiveTransports[lvl][neighbour]);
 
 			//Xi variable
 			//-----------
@@ -926,24 +1235,26 @@ void Parallel::updatePersistentCommunicationsLvl(int lvl, const int &dim)
 			//New sending request and its associated buffer
 			m_reqSendXi[lvl][neighbour] = new MPI_Request;
 			m_bufferSendXi[lvl][neighbour] = new double[numberSend];
-			MPI_Send_init(m_bufferSendXi[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendXi[lvl][neighbour]);
+			MPI_Send_init(m_bufferSendXi[lvl][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSendXi[lvl][neighbour]);
 
 			//New receiving request and its associated buffer
 			m_reqReceiveXi[lvl][neighbour] = new MPI_Request;
 			m_bufferReceiveXi[lvl][neighbour] = new double[numberReceive];
-			MPI_Recv_init(m_bufferReceiveXi[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveXi[lvl][neighbour]);
+			m_buffersBytes[lvl][neighbour] += (numberSend + numberReceive)*sizeof(double);
+			MPI_Recv_init(m_bufferReceiveXi[lvl][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceiveXi[lvl][neighbour]);
 
 			//Split variable
 			//--------------
 			//New sending request and its associated buffer
 			m_reqSendSplit[lvl][neighbour] = new MPI_Request;
 			m_bufferSendSplit[lvl][neighbour] = new bool[numberSend];
-			MPI_Send_init(m_bufferSendSplit[lvl][neighbour], numberSend, MPI_C_BOOL, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendSplit[lvl][neighbour]);
+			MPI_Send_init(m_bufferSendSplit[lvl][neighbour], numberSend, MPI_C_BOOL, neighbour, neighbour, commCompute, m_reqSendSplit[lvl][neighbour]);
 
 			//New receiving request and its associated buffer
 			m_reqReceiveSplit[lvl][neighbour] = new MPI_Request;
 			m_bufferReceiveSplit[lvl][neighbour] = new bool[numberReceive];
-			MPI_Recv_init(m_bufferReceiveSplit[lvl][neighbour], numberReceive, MPI_C_BOOL, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveSplit[lvl][neighbour]);
+			m_buffersBytes[lvl][neighbour] += (numberSend + numberReceive)*sizeof(bool);
+			MPI_Recv_init(m_bufferReceiveSplit[lvl][neighbour], numberReceive, MPI_C_BOOL, neighbour, rankCpu, commCompute, m_reqReceiveSplit[lvl][neighbour]);
 		}
 	}
 }
@@ -961,7 +1272,7 @@ void Parallel::finalizeAMR(const int &lvlMax)
 		this->finalizePersistentCommunicationsSplit(lvlMax);
 		this->finalizePersistentCommunicationsNumberGhostCells();
 	}
-	MPI_Barrier(MPI_COMM_WORLD);
+	MPI_Barrier(commCompute);
 }
 
 //***********************************************************************
@@ -979,12 +1290,13 @@ void Parallel::initializePersistentCommunicationsXi()
 			//New sending request and its associated buffer
 			m_reqSendXi[0][neighbour] = new MPI_Request;
 			m_bufferSendXi[0][neighbour] = new double[numberSend];
-			MPI_Send_init(m_bufferSendXi[0][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendXi[0][neighbour]);
+			MPI_Send_init(m_bufferSendXi[0][neighbour], numberSend, MPI_DOUBLE, neighbour, neighbour, commCompute, m_reqSendXi[0][neighbour]);
 
 			//New receiving request and its associated buffer
 			m_reqReceiveXi[0][neighbour] = new MPI_Request;
 			m_bufferReceiveXi[0][neighbour] = new double[numberReceive];
-			MPI_Recv_init(m_bufferReceiveXi[0][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveXi[0][neighbour]);
+			m_buffersBytes[0][neighbour] += (numberSend + numberReceive)*sizeof(double);
+			MPI_Recv_init(m_bufferReceiveXi[0][neighbour], numberReceive, MPI_DOUBLE, neighbour, rankCpu, commCompute, m_reqReceiveXi[0][neighbour]);
 		}
 	}
 }
@@ -1019,18 +1331,22 @@ void Parallel::finalizePersistentCommunicationsXi(const int &lvlMax)
 
 void Parallel::communicationsXi(Cell **cells, const int &lvl)
 {
+  PROFILE_SCOPE("communications xi");
 	int count(0);
 	MPI_Status status;
 
 	for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
 		if (m_isNeighbour[neighbour]) {
+			double tStart(MPI_Wtime());
 			//Prepation of sendings
 			count = -1;
 			for (int i = 0; i < m_numberElementsToSendToNeighbour[neighbour]; i++) {
 				//Automatic filing of m_bufferSendXi
-				cells[m_elementsToSend[neighbour][i]]->fillBufferXi(m_bufferSendXi[lvl][neighbour], count, lvl, m_whichCpuAmIForNeighbour[neighbour]);
+				cells[m_elementsToSend[neighbour][i]]->fillBufferXi(m_bufferSendXi[lvl][neighbour], count, lvl, m_whichCpuAmIForElementToSend[neighbour][i]);
 			}
 
+			int numberSend(count + 1);
+			double tSend(MPI_Wtime());
 			//Sending request
 			MPI_Start(m_reqSendXi[lvl][neighbour]);
 			//Receiving request
@@ -1038,6 +1354,7 @@ void Parallel::communicationsXi(Cell **cells, const int &lvl)
 			//Waiting
 			MPI_Wait(m_reqSendXi[lvl][neighbour], &status);
 			MPI_Wait(m_reqReceiveXi[lvl][neighbour], &status);
+			double tReceive(MPI_Wtime());
 
 			//Receivings
 			count = -1;
@@ -1045,6 +1362,7 @@ void Parallel::communicationsXi(Cell **cells, const int &lvl)
 				//Automatic filing of m_bufferReceiveXi
 				cells[m_elementsToReceive[neighbour][i]]->getBufferXi(m_bufferReceiveXi[lvl][neighbour], count, lvl);
 			}
+			this->recordCommunication(comXi, neighbour, numberSend*sizeof(double), (count + 1)*sizeof(double), tSend - tStart, tReceive - tSend, MPI_Wtime() - tReceive);
 		}
 	}
 }
@@ -1064,12 +1382,13 @@ void Parallel::initializePersistentCommunicationsSplit()
 			//New sending request and its associated buffer
 			m_reqSendSplit[0][neighbour] = new MPI_Request;
 			m_bufferSendSplit[0][neighbour] = new bool[numberSend];
-			MPI_Send_init(m_bufferSendSplit[0][neighbour], numberSend, MPI_C_BOOL, neighbour, neighbour, MPI_COMM_WORLD, m_reqSendSplit[0][neighbour]);
+			MPI_Send_init(m_bufferSendSplit[0][neighbour], numberSend, MPI_C_BOOL, neighbour, neighbour, commCompute, m_reqSendSplit[0][neighbour]);
 
 			//New receiving request and its associated buffer
 			m_reqReceiveSplit[0][neighbour] = new MPI_Request;
 			m_bufferReceiveSplit[0][neighbour] = new bool[numberReceive];
-			MPI_Recv_init(m_bufferReceiveSplit[0][neighbour], numberReceive, MPI_C_BOOL, neighbour, rankCpu, MPI_COMM_WORLD, m_reqReceiveSplit[0][neighbour]);
+			m_buffersBytes[0][neighbour] += (numberSend + numberReceive)*sizeof(bool);
+			MPI_Recv_init(m_bufferReceiveSplit[0][neighbour], numberReceive, MPI_C_BOOL, neighbour, rankCpu, commCompute, m_reqReceiveSplit[0][neighbour]);
 		}
 	}
 }
@@ -1104,18 +1423,22 @@ void Parallel::finalizePersistentCommunicationsSplit(const int &lvlMax)
 
 void Parallel::communicationsSplit(Cell **cells, const int &lvl)
 {
+  PROFILE_SCOPE("communications split");
 	int count(0);
 	MPI_Status status;
 
 	for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
 		if (m_isNeighbour[neighbour]) {
+			double tStart(MPI_Wtime());
 			//Prepation of sendings
 			count = -1;
 			for (int i = 0; i < m_numberElementsToSendToNeighbour[neighbour]; i++) {
 				//Automatic filing of m_bufferSendSplit
-				cells[m_elementsToSend[neighbour][i]]->fillBufferSplit(m_bufferSendSplit[lvl][neighbour], count, lvl, m_whichCpuAmIForNeighbour[neighbour]);
+				cells[m_elementsToSend[neighbour][i]]->fillBufferSplit(m_bufferSendSplit[lvl][neighbour], count, lvl, m_whichCpuAmIForElementToSend[neighbour][i]);
 			}
       
+			int numberSend(count + 1);
+			double tSend(MPI_Wtime());
 			//Sending request
 			MPI_Start(m_reqSendSplit[lvl][neighbour]);
 			//Receiving request
@@ -1123,6 +1446,7 @@ void Parallel::communicationsSplit(Cell **cells, const int &lvl)
 			//Waiting
 			MPI_Wait(m_reqSendSplit[lvl][neighbour], &status);
 			MPI_Wait(m_reqReceiveSplit[lvl][neighbour], &status);
+			double tReceive(MPI_Wtime());
 
 			//Receivings
 			count = -1;
@@ -1130,6 +1454,7 @@ void Parallel::communicationsSplit(Cell **cells, const int &lvl)
 				//Automatic filing of m_bufferReceiveSplit
 				cells[m_elementsToReceive[neighbour][i]]->getBufferSplit(m_bufferReceiveSplit[lvl][neighbour], count, lvl);
 			}
+			this->recordCommunication(comSplit, neighbour, numberSend*sizeof(bool), (count + 1)*sizeof(bool), tSend - tStart, tReceive - tSend, MPI_Wtime() - tReceive);
 		}
 	}
 }
@@ -1147,12 +1472,12 @@ void Parallel::initializePersistentCommunicationsNumberGhostCells()
 			//New sending request and its associated buffer
 			m_reqNumberElementsToSendToNeighbor[neighbour] = new MPI_Request;
 			m_bufferNumberElementsToSendToNeighbor[neighbour] = 0;
-			MPI_Send_init(&m_bufferNumberElementsToSendToNeighbor[neighbour], numberSend, MPI_INT, neighbour, neighbour, MPI_COMM_WORLD, m_reqNumberElementsToSendToNeighbor[neighbour]);
+			MPI_Send_init(&m_bufferNumberElementsToSendToNeighbor[neighbour], numberSend, MPI_INT, neighbour, neighbour, commCompute, m_reqNumberElementsToSendToNeighbor[neighbour]);
 
 			//New receiving request and its associated buffer
 			m_reqNumberElementsToReceiveFromNeighbour[neighbour] = new MPI_Request;
 			m_bufferNumberElementsToReceiveFromNeighbour[neighbour] = 0;
-			MPI_Recv_init(&m_bufferNumberElementsToReceiveFromNeighbour[neighbour], numberReceive, MPI_INT, neighbour, rankCpu, MPI_COMM_WORLD, m_reqNumberElementsToReceiveFromNeighbour[neighbour]);
+			MPI_Recv_init(&m_bufferNumberElementsToReceiveFromNeighbour[neighbour], numberReceive, MPI_INT, neighbour, rankCpu, commCompute, m_reqNumberElementsToReceiveFromNeighbour[neighbour]);
 		}
 	}
 }
@@ -1179,18 +1504,20 @@ void Parallel::finalizePersistentCommunicationsNumberGhostCells()
 
 void Parallel::communicationsNumberGhostCells(Cell **cells, const int &lvl)
 {
+  PROFILE_SCOPE("communications ghost cells");
 	MPI_Status status;
 
 	for (int neighbour = 0; neighbour < Ncpu; neighbour++)
 	{
 		if (m_isNeighbour[neighbour]) {
+			double tStart(MPI_Wtime());
 			//Prepation de l'envoi
 			m_bufferNumberElementsToSendToNeighbor[neighbour] = 0;
 			for (int i = 0; i < m_numberElementsToSendToNeighbour[neighbour]; i++) {
 				//Automatic filing of m_bufferSendSplit
-				cells[m_elementsToSend[neighbour][i]]->fillNumberElementsToSendToNeighbour(m_bufferNumberElementsToSendToNeighbor[neighbour], lvl, m_whichCpuAmIForNeighbour[neighbour]);
+				cells[m_elementsToSend[neighbour][i]]->fillNumberElementsToSendToNeighbour(m_bufferNumberElementsToSendToNeighbor[neighbour], lvl, m_whichCpuAmIForElementToSend[neighbour][i]);
 			}
-
+			double tSend(MPI_Wtime());
 
 			//Sending request
 			MPI_Start(m_reqNumberElementsToSendToNeighbor[neighbour]);
@@ -1201,6 +1528,7 @@ void Parallel::communicationsNumberGhostCells(Cell **cells, const int &lvl)
 			MPI_Wait(m_reqNumberElementsToReceiveFromNeighbour[neighbour], &status);
 
 			//No supplementary receivings to treat
+			this->recordCommunication(comGhostCells, neighbour, sizeof(int), sizeof(int), tSend - tStart, MPI_Wtime() - tSend, 0.);
 
 		}
 	}
@@ -1210,17 +1538,21 @@ void Parallel::communicationsNumberGhostCells(Cell **cells, const int &lvl)
 
 void Parallel::communicationsPrimitivesAMR(Cell **cells, Eos **eos, const int &lvl, Prim type)
 {
+  PROFILE_SCOPE("communications primitives");
 	int count(0);
 	MPI_Status status;
 
 	for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
 		if (m_isNeighbour[neighbour]) {
+			double tStart(MPI_Wtime());
 			//Prepation of sendings
 			count = -1;
       for (int i = 0; i < m_numberElementsToSendToNeighbour[neighbour]; i++) {
-        cells[m_elementsToSend[neighbour][i]]->fillBufferPrimitivesAMR(m_bufferSend[lvl][neighbour], count, lvl, m_whichCpuAmIForNeighbour[neighbour], type);
+        cells[m_elementsToSend[neighbour][i]]->fillBufferPrimitivesAMR(m_bufferSend[lvl][neighbour], count, lvl, m_whichCpuAmIForElementToSend[neighbour][i], type);
       }
 
+			int numberSend(count + 1);
+			double tSend(MPI_Wtime());
 			//Sending request
 			MPI_Start(m_reqSend[lvl][neighbour]);
 			//Receiving request
@@ -1228,12 +1560,14 @@ void Parallel::communicationsPrimitivesAMR(Cell **cells, Eos **eos, const int &l
 			//Waiting
 			MPI_Wait(m_reqSend[lvl][neighbour], &status);
 			MPI_Wait(m_reqReceive[lvl][neighbour], &status);
+			double tReceive(MPI_Wtime());
       
 			//Receivings
 			count = -1;
 			for (int i = 0; i < m_numberElementsToReceiveFromNeighbour[neighbour]; i++) {
 				cells[m_elementsToReceive[neighbour][i]]->getBufferPrimitivesAMR(m_bufferReceive[lvl][neighbour], count, lvl, eos, type);
 			}
+			this->recordCommunication(comPrimitives, neighbour, numberSend*sizeof(double), (count + 1)*sizeof(double), tSend - tStart, tReceive - tSend, MPI_Wtime() - tReceive);
 		}
 	}
 }
@@ -1242,17 +1576,21 @@ void Parallel::communicationsPrimitivesAMR(Cell **cells, Eos **eos, const int &l
 
 void Parallel::communicationsSlopesAMR(Cell **cells, const int &lvl)
 {
+  PROFILE_SCOPE("communications slopes");
 	int count(0);
 	MPI_Status status;
 
 	for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
 		if (m_isNeighbour[neighbour]) {
+			double tStart(MPI_Wtime());
 			//Prepation of sendings
 			count = -1;
 			for (int i = 0; i < m_numberElementsToSendToNeighbour[neighbour]; i++) {
-				cells[m_elementsToSend[neighbour][i]]->fillBufferSlopesAMR(m_bufferSendSlopes[lvl][neighbour], count, lvl, m_whichCpuAmIForNeighbour[neighbour]);
+				cells[m_elementsToSend[neighbour][i]]->fillBufferSlopesAMR(m_bufferSendSlopes[lvl][neighbour], count, lvl, m_whichCpuAmIForElementToSend[neighbour][i]);
 			}
 
+			int numberSend(count + 1);
+			double tSend(MPI_Wtime());
 			//Sending request
 			MPI_Start(m_reqSendSlopes[lvl][neighbour]);
 			//Receiving request
@@ -1260,12 +1598,14 @@ void Parallel::communicationsSlopesAMR(Cell **cells, const int &lvl)
 			//Waiting
 			MPI_Wait(m_reqSendSlopes[lvl][neighbour], &status);
 			MPI_Wait(m_reqReceiveSlopes[lvl][neighbour], &status);
+			double tReceive(MPI_Wtime());
 
 			//Receivings
 			count = -1;
 			for (int i = 0; i < m_numberElementsToReceiveFromNeighbour[neighbour]; i++) {
 				cells[m_elementsToReceive[neighbour][i]]->getBufferSlopesAMR(m_bufferReceiveSlopes[lvl][neighbour], count, lvl);
 			}
+			this->recordCommunication(comSlopes, neighbour, numberSend*sizeof(double), (count + 1)*sizeof(double), tSend - tStart, tReceive - tSend, MPI_Wtime() - tReceive);
 		}
 	}
 }
@@ -1274,18 +1614,22 @@ void Parallel::communicationsSlopesAMR(Cell **cells, const int &lvl)
 
 void Parallel::communicationsVectorAMR(Cell **cells, string nameVector, const int &dim, const int &lvl, int num, int index)
 {
+  PROFILE_SCOPE("communications vectors");
 	int count(0);
 	MPI_Status status;
 
 	for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
 		if (m_isNeighbour[neighbour]) {
+			double tStart(MPI_Wtime());
 			//Prepation of sendings
 			count = -1;
 			for (int i = 0; i < m_numberElementsToSendToNeighbour[neighbour]; i++) {
 				//Automatic filing of m_bufferSendVector function of gradient coordinates
-				cells[m_elementsToSend[neighbour][i]]->fillBufferVectorAMR(m_bufferSendVector[lvl][neighbour], count, lvl, m_whichCpuAmIForNeighbour[neighbour], dim, nameVector, num, index);
+				cells[m_elementsToSend[neighbour][i]]->fillBufferVectorAMR(m_bufferSendVector[lvl][neighbour], count, lvl, m_whichCpuAmIForElementToSend[neighbour][i], dim, nameVector, num, index);
 			}
 
+			int numberSend(count + 1);
+			double tSend(MPI_Wtime());
 			//Sending request
 			MPI_Start(m_reqSendVector[lvl][neighbour]);
 			//Receiving request
@@ -1293,12 +1637,14 @@ void Parallel::communicationsVectorAMR(Cell **cells, string nameVector, const in
 			//Waiting
 			MPI_Wait(m_reqSendVector[lvl][neighbour], &status);
 			MPI_Wait(m_reqReceiveVector[lvl][neighbour], &status);
+			double tReceive(MPI_Wtime());
 			//Receivings
 			count = -1;
 			for (int i = 0; i < m_numberElementsToReceiveFromNeighbour[neighbour]; i++) {
 				//Automatic filing of m_bufferReceiveVector function of gradient coordinates
 				cells[m_elementsToReceive[neighbour][i]]->getBufferVectorAMR(m_bufferReceiveVector[lvl][neighbour], count, lvl, dim, nameVector, num, index);
 			}
+			this->recordCommunication(comVectors, neighbour, numberSend*sizeof(double), (count + 1)*sizeof(double), tSend - tStart, tReceive - tSend, MPI_Wtime() - tReceive);
 		}
 	}
 }
@@ -1307,17 +1653,21 @@ void Parallel::communicationsVectorAMR(Cell **cells, string nameVector, const in
 
 void Parallel::communicationsTransportsAMR(Cell **cells, const int &lvl)
 {
+  PROFILE_SCOPE("communications transports");
   int count(0);
   MPI_Status status;
 
   for (int neighbour = 0; neighbour < Ncpu; neighbour++) {
     if (m_isNeighbour[neighbour]) {
+      double tStart(MPI_Wtime());
       //Prepation of sendings
       count = -1;
       for (int i = 0; i < m_numberElementsToSendToNeighbour[neighbour]; i++) {
-        cells[m_elementsToSend[neighbour][i]]->fillBufferTransportsAMR(m_bufferSendTransports[lvl][neighbour], count, lvl, m_whichCpuAmIForNeighbour[neighbour]);
+        cells[m_elementsToSend[neighbour][i]]->fillBufferTransportsAMR(m_bufferSendTransports[lvl][neighbour], count, lvl, m_whichCpuAmIForElementToSend[neighbour][i]);
       }
 
+      int numberSend(count + 1);
+      double tSend(MPI_Wtime());
       //Sending request
       MPI_Start(m_reqSendTransports[lvl][neighbour]);
       //Receiving request
@@ -1325,12 +1675,14 @@ void Parallel::communicationsTransportsAMR(Cell **cells, const int &lvl)
       //Waiting
       MPI_Wait(m_reqSendTransports[lvl][neighbour], &status);
       MPI_Wait(m_reqReceiveTransports[lvl][neighbour], &status);
+      double tReceive(MPI_Wtime());
 
       //Receivings
       count = -1;
       for (int i = 0; i < m_numberElementsToReceiveFromNeighbour[neighbour]; i++) {
         cells[m_elementsToReceive[neighbour][i]]->getBufferTransportsAMR(m_bufferReceiveTransports[lvl][neighbour], count, lvl);
       }
+      this->recordCommunication(comTransports, neighbour, numberSend*sizeof(double), (count + 1)*sizeof(double), tSend - tStart, tReceive - tSend, MPI_Wtime() - tReceive);
     }
   }
 }
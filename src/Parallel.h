@@ -39,6 +39,20 @@
 #include "Models/Phase.h"
 #include "Cell.h"
 
+//! \brief    Types of exchanges recorded by the communications instrumentation
+enum TypeCommunication { comPrimitives, comSlopes, comVectors, comTransports, comXi, comSplit, comGhostCells, numberTypesCommunication };
+
+//! \brief    Statistics of the exchanges of one type with one neighbour
+struct StatsCommunication
+{
+  long long messages;                      //!<Number of exchanges
+  long long bytesSent;                     //!<Bytes sent to the neighbour
+  long long bytesReceived;                 //!<Bytes received from the neighbour
+  double timePack;                         //!<Time spent filling the sending buffers (s)
+  double timeWait;                         //!<Time spent waiting for the completion of the exchanges (s)
+  double timeUnpack;                       //!<Time spent reading the receiving buffers (s)
+};
+
 class Parallel
 {
 public:
@@ -48,6 +62,8 @@ public:
   void initialization(int &argc, char *argv[]);
   void setNeighbour(const int neighbour, std::string whichCpuAmIForNeighbour);
   void setElementsToSend(const int neighbour, int* numberElement, const int &numberElements);
+  //! \brief    Elements to send with the side of this CPU for the neighbour given per element (neighbour sharing several sides)
+  void setElementsToSend(const int neighbour, int* numberElement, const int &numberElements, const std::vector<std::string> &whichCpuAmIForElement);
   void setElementsToReceive(const int neighbour, int* numberElement, const int &numberElements);
 	void initializePersistentCommunications(const int &numberPrimitiveVariables, const int &numberSlopeVariables, const int &numberTransportVariables, const int &dim);
 	void computeDt(double &dt);
@@ -55,11 +71,23 @@ public:
 	void finalize(const int &lvlMax);
 	void stopRun();
 	void verifyStateCPUs();
+
+  //Communications instrumentation
+  //! \brief    Accumulate the statistics of one exchange with a neighbour
+  void recordCommunication(const TypeCommunication &type, const int &neighbour, const long long &bytesSent, const long long &bytesReceived,
+    const double &timePack, const double &timeWait, const double &timeUnpack, const int &messages = 1);
+  //! \brief    Print the per-CPU table of the exchanges (communications_CPU<rank>.out) and the communication matrix of all CPUs
+  //!           (communicationMatrix.out) in the given folder (to be called by all CPUs)
+  void ecritStatsCommunications(const std::string &folder) const;
+  //! \brief    Bytes currently held by the communication buffers of this CPU (all levels and neighbours, shared window included)
+  long long getBuffersBytes() const;
   
   //Methodes pour toutes les variables primitives
-  void initializePersistentCommunicationsPrimitives();
+  //! \param    sharedWindow   neighbours on the same node exchange through a shared window (level 0 of non-AMR meshes only)
+  void initializePersistentCommunicationsPrimitives(const bool &sharedWindow);
   void finalizePersistentCommunicationsPrimitives(const int &lvlMax);
   void communicationsPrimitives(Cell **cells, Eos **eos, Prim type = vecPhases);
+  bool isSharedNeighbour(const int neighbour) const;
 
 	//Methodes pour toutes les slopes
 	void initializePersistentCommunicationsSlopes();
@@ -85,6 +113,8 @@ public:
 	void initializePersistentCommunicationsLvlAMR(const int &lvlMax);
 	void updatePersistentCommunicationsLvl(int lvl, const int &dim);
 	void finalizeAMR(const int &lvlMax);
+  //! \brief    Forget the neighbours and elements to exchange after finalizeAMR, before a new partition is given by the mesh
+  void resetNeighbours();
 
 	void initializePersistentCommunicationsXi();
 	void finalizePersistentCommunicationsXi(const int &lvlMax);
@@ -104,10 +134,12 @@ public:
   void communicationsTransportsAMR(Cell **cells, const int &lvl);
 
 private:
+  void allocateCommunicationsLvl0();
     
   int m_stateCPU;
   bool *m_isNeighbour;
   std::string *m_whichCpuAmIForNeighbour;
+  std::vector<std::string> *m_whichCpuAmIForElementToSend; /*Side of this CPU for the neighbour, per element to send*/
 	int ** m_elementsToSend;
 	int ** m_elementsToReceive;
 	int * m_numberElementsToSendToNeighbour;
@@ -132,7 +164,24 @@ private:
 	std::vector<bool **> m_bufferSendSplit;
 	int * m_bufferNumberElementsToSendToNeighbor;
 	int * m_bufferNumberElementsToReceiveFromNeighbour;
+	std::vector<std::vector<long long> > m_buffersBytes; /*Bytes of the sending and receiving buffers per AMR level and neighbour*/
   
+	//Intra-node shared memory path for the primitive variables (level 0)
+	MPI_Comm m_nodeComm;                     /*Communicator gathering the CPUs sharing the same node*/
+	MPI_Win m_winPrimitives;                 /*Shared window holding the packed primitive blocks of this CPU (double buffered)*/
+	int * m_nodeRankOfCpu;                   /*Rank in m_nodeComm of each CPU, MPI_UNDEFINED if on another node*/
+	int * m_offsetSharedSend;                /*Offset in own window of the block packed for each neighbour*/
+	double ** m_sharedReceive;               /*Direct pointer to the block packed by each neighbour for this CPU*/
+	int * m_sizeSharedNeighbour;             /*Size of one half of each neighbour window*/
+	double * m_sharedSend;                   /*Base of own window*/
+	int m_sizeSharedSend;                    /*Size of one half of own window*/
+	int m_sharedHalf;                        /*Half of the windows in use (0 or 1)*/
+	MPI_Win m_winSequence;                   /*Shared window holding the number of exchanges published by each CPU of the node*/
+	long long * m_sequence;                  /*Number of exchanges published by this CPU*/
+	long long ** m_sequenceNeighbour;        /*Direct pointer to the number of exchanges published by each neighbour on the node*/
+
+	std::vector<StatsCommunication> m_statsCommunications; /*Exchanges statistics indexed by type*Ncpu + neighbour*/
+
 	std::vector<MPI_Request **> m_reqSend;
 	std::vector<MPI_Request **> m_reqReceive;
 	std::vector<MPI_Request **> m_reqSendSlopes;
@@ -153,7 +202,9 @@ private:
 };
 
 extern Parallel parallel;
-extern int rankCpu;
-extern int Ncpu;
+extern int rankCpu;                   //Rank in commCompute
+extern int Ncpu;                      //Size of commCompute
+extern MPI_Comm commCompute;          //CPUs running the current test case (MPI_COMM_WORLD unless test cases are run concurrently)
+extern int groupCpu;                  //Group of CPUs running the current test case (-1 unless test cases are run concurrently)
 
 #endif // PARALLEL_H
\ No newline at end of file
@@ -40,8 +40,8 @@ using namespace tinyxml2;
 
 //***********************************************************************
 
-Run::Run(std::string nameCasTest, const int &number) : m_numberTransports(0), m_resumeSimulation(0), m_dt(1.e-15), m_physicalTime(0.), m_iteration(0),
-  m_simulationName(nameCasTest), m_numTest(number), m_MRF(-1)
+Run::Run(std::string nameCasTest, const int &number) : m_numTest(number), m_simulationName(nameCasTest), m_numberTransports(0), m_MRF(-1),
+  m_loadBalancingFreq(0), m_loadBalancingThreshold(1.2), m_dt(1.e-15), m_physicalTime(0.), m_iteration(0), m_resumeSimulation(0), m_resumeCheckpoint(0), m_checkpoint(0)
 {
   m_stat.initialize();
 }
@@ -58,7 +58,7 @@ void Run::initialize(int argc, char* argv[])
   //----------------------------------------------------------------
   parallel.initialization(argc, argv);
   if (Ncpu > 1){
-    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Barrier(commCompute);
     if (rankCpu == 0) cout << "T" << m_numTest << " | Number of CPU : " << Ncpu << endl;
   }
 
@@ -110,6 +110,8 @@ void Run::initialize(int argc, char* argv[])
   cellRight->allocate(m_numberPhases, m_numberTransports, m_addPhys, m_model);
   domains[0]->fillIn(cellLeft, m_numberPhases, m_numberTransports);
   domains[0]->fillIn(cellRight, m_numberPhases, m_numberTransports);
+  //Bytes of one cell and one cell interface for memory accounting
+  m_memory.calibrate(m_order, m_numberPhases, m_numberTransports, m_addPhys, m_model, m_mesh->getType());
 
   //7) Creation of Cells and Boundary level arrays (one per AMR level, also requested for non-AMR)
   //----------------------------------------------------------------------------------------------
@@ -134,14 +136,14 @@ void Run::initialize(int argc, char* argv[])
 
   //11) Resume simulation
   //---------------------
-  if (m_resumeSimulation > 0) {
+  if (m_resumeSimulation > 0 || m_resumeCheckpoint > 0) {
     try { this->resumeSimulation(m_iteration, m_dt, m_physicalTime); }
     catch (ErrorECOGEN &) { throw; }
   }
 
   //12) Printing t0 solution
   //------------------------
-  if (m_resumeSimulation == 0) {
+  if (m_resumeSimulation == 0 && m_resumeCheckpoint == 0) {
     try {
       m_outPut->prepareOutputInfos();
       if (rankCpu == 0) m_outPut->ecritInfos();
@@ -150,7 +152,7 @@ void Run::initialize(int argc, char* argv[])
       if (m_mesh->getType() == AMR) m_outPut->printTree(m_mesh, m_cellsLvl);
       for (unsigned int c = 0; c < m_cuts.size(); c++) m_cuts[c]->ecritSolution(m_mesh, m_cellsLvl);
       for (unsigned int p = 0; p < m_probes.size(); p++) {
-        if (m_probes[p]->possesses()) m_probes[p]->ecritSolution(m_mesh, m_cellsLvl);
+        if (m_probes[p]->possesses()) { m_probes[p]->ecritSolution(m_mesh, m_cellsLvl); m_probes[p]->flushBuffer(); }
       }
     }
     catch (ErrorXML &) { throw; }
@@ -164,11 +166,17 @@ void Run::resumeSimulation(int &iteration, double &dt, double &tempsPhysique)
 {
   ifstream fileStream;
 
-  cout << "Resuming simulation from result files number: " << m_resumeSimulation << " ...";
   try {
-    m_outPut->readInfos();
-    if (m_mesh->getType() == AMR) m_outPut->readTree(m_mesh, m_cellsLvl, m_boundariesLvl, m_resumeSimulation, m_addPhys, m_model, m_nbCellsTotalAMR);
-    m_outPut->readResults(m_mesh, m_cellsLvl, m_resumeSimulation);
+    if (m_resumeCheckpoint > 0) {
+      cout << "Resuming simulation from checkpoint number: " << m_resumeCheckpoint << " ...";
+      m_checkpoint->readCheckpoint(m_mesh, m_cellsLvl, m_boundariesLvl, m_resumeCheckpoint);
+    }
+    else {
+      cout << "Resuming simulation from result files number: " << m_resumeSimulation << " ...";
+      m_outPut->readInfos();
+      if (m_mesh->getType() == AMR) m_outPut->readTree(m_mesh, m_cellsLvl, m_boundariesLvl, m_resumeSimulation, m_addPhys, m_model, m_nbCellsTotalAMR);
+      m_outPut->readResults(m_mesh, m_cellsLvl, m_resumeSimulation);
+    }
   }
   catch (ErrorECOGEN &) { fileStream.close(); throw; }
   fileStream.close();
@@ -210,7 +218,12 @@ void Run::solver()
   //-------------------
   bool computeFini(false); bool print(false);
   double printSuivante(m_physicalTime+m_timeFreq);
+  profiler.reset();
+  m_throughputHeartbeat.reset(m_stat.getCellUpdates(), this->computeProgress());
+  m_throughputOutputs.reset(m_stat.getCellUpdates(), this->computeProgress());
   while (!computeFini) {
+    tracer.newIteration(m_iteration);
+    TRACE_SCOPE("iteration", -1);
     //Errors checking
     try {
       this->verifyErrors();
@@ -224,11 +237,21 @@ void Run::solver()
     dtMax = 1.e10;
     int lvlDep = 0;
     this->integrationProcedure(m_dt, lvlDep, dtMax, m_nbCellsTotalAMR);
+    this->updateMemory();
 
     //-------------------- CONTROL ITERATIONS/TIME ---------------------
 
     //Still alive...
-    if (m_iteration !=0 && m_iteration % 1000 == 0 && rankCpu == 0) { cout << "Iteration " << m_iteration << " / Timestep " << m_dt << " / Progress " << m_physicalTime / m_finalPhysicalTime*100. << "%" << endl; }
+    if (m_iteration !=0 && m_iteration % 1000 == 0) {
+      m_throughputHeartbeat.update(m_stat.getCellUpdates(), this->computeProgress());
+      if (rankCpu == 0) {
+        cout << "Iteration " << m_iteration << " / Timestep " << m_dt << " / Progress " << this->computeProgress()*100. << "%";
+        cout << " / Cell updates/s " << m_throughputHeartbeat.getCellUpdatesPerSecondGlobal();
+        if (Ncpu > 1) cout << " (per CPU " << m_throughputHeartbeat.getCellUpdatesPerSecondMin() << " to " << m_throughputHeartbeat.getCellUpdatesPerSecondMax() << ")";
+        if (m_throughputHeartbeat.getRemainingTime() >= 0.) cout << " / Remaining " << timeStats::formatTime(m_throughputHeartbeat.getRemainingTime());
+        cout << endl;
+      }
+    }
 
     m_physicalTime += m_dt;
     m_iteration++;
@@ -247,7 +270,9 @@ void Run::solver()
     //------------------------ OUTPUT FILES PRINTING -------------------------
     nbCellsTotalAMRMax = max(nbCellsTotalAMRMax, m_nbCellsTotalAMR);
     if (print) {
+      PROFILE_SCOPE("output");
       m_stat.updateComputationTime();
+      m_throughputOutputs.update(m_stat.getCellUpdates(), this->computeProgress());
       //General printings
       //if (Ncpu > 1) { parallel.computePMax(m_pMax[0], m_pMaxWall[0]); }
       if (rankCpu == 0) m_outPut->ecritInfos();
@@ -256,12 +281,24 @@ void Run::solver()
       if (m_mesh->getType() == AMR) m_outPut->printTree(m_mesh, m_cellsLvl);
       //Cuts printing
       for (unsigned int c = 0; c < m_cuts.size(); c++) { m_cuts[c]->ecritSolution(m_mesh, m_cellsLvl); }
+      //Probes samples recorded since the last output
+      for (unsigned int p = 0; p < m_probes.size(); p++) { m_probes[p]->flushBuffer(); }
       if (rankCpu == 0) cout << " ...OK" << endl;
+      //Load balance between CPUs for AMR simulations
+      m_mesh->printLoadBalance(m_numTest);
+      //Wall-clock profile of the computation phases and communications statistics
+      profiler.printStats(m_numTest, m_stat.getComputationTimeSeconds());
+      m_outPut->ecritStatsCommunications();
+      m_outPut->ecritStatsMemory();
+      m_outPut->ecritStatsCounters();
       print = false;
     }
     //Printing probes data
-    for (unsigned int p = 0; p < m_probes.size(); p++) {
-      if((m_probes[p]->possesses()) && m_probes[p]->getNextTime()<=m_physicalTime) m_probes[p]->ecritSolution(m_mesh, m_cellsLvl);
+    {
+      PROFILE_SCOPE("probes");
+      for (unsigned int p = 0; p < m_probes.size(); p++) {
+        if((m_probes[p]->possesses()) && m_probes[p]->getNextTime()<=m_physicalTime) m_probes[p]->ecritSolution(m_mesh, m_cellsLvl);
+      }
     }
 
     //-------------------------- TIME STEP UPDATING --------------------------
@@ -269,21 +306,56 @@ void Run::solver()
     m_dt = m_cfl * dtMax;
     if (Ncpu > 1) { parallel.computeDt(m_dt); }
 
+    //Repartition of the AMR level-0 cells between CPUs along the space-filling curve
+    if (m_loadBalancingFreq > 0 && m_iteration % m_loadBalancingFreq == 0) {
+      PROFILE_SCOPE("load balancing");
+      m_outPut->attendEcritureSolution();
+      for (unsigned int p = 0; p < m_probes.size(); p++) { m_probes[p]->flushBuffer(); }
+      if (m_mesh->repartitionCells(&m_cells, &m_boundaries, &m_cellsLvl, &m_boundariesLvl, m_addPhys, m_model, m_eos, m_nbCellsTotalAMR,
+        m_loadBalancingThreshold, m_order, m_numTest)) {
+        for (unsigned int c = 0; c < m_cuts.size(); c++) { m_cuts[c]->relocateInMesh(); }
+        for (unsigned int p = 0; p < m_probes.size(); p++) { m_probes[p]->relocateInMesh(); }
+      }
+    }
+
+    //Printing checkpoint for restart (after time step updating to resume on the next iteration)
+    if (m_checkpoint->isCheckpointIteration(m_iteration)) {
+      PROFILE_SCOPE("checkpoint");
+      for (unsigned int p = 0; p < m_probes.size(); p++) { m_probes[p]->flushBuffer(); }
+      m_checkpoint->ecritCheckpoint(m_mesh, m_cellsLvl);
+    }
+
   } //time iterative loop end
+  //Remaining probes samples
+  for (unsigned int p = 0; p < m_probes.size(); p++) { m_probes[p]->flushBuffer(); }
+  //Last solution printed in background
+  {
+    PROFILE_SCOPE("output");
+    m_outPut->attendEcritureSolution();
+  }
+  m_stat.updateComputationTime();
+  profiler.printStats(m_numTest, m_stat.getComputationTimeSeconds());
+  m_outPut->ecritStatsCommunications();
+  m_outPut->ecritStatsMemory();
+  m_outPut->ecritStatsCounters();
+  tracer.finalize();
   if (rankCpu == 0) cout << "T" << m_numTest << " | ---------------------------------------" << endl;
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(commCompute);
   cout << "T" << m_numTest << " | Maximum cells number on CPU " << rankCpu << " : " << nbCellsTotalAMRMax << endl;
+  m_mesh->printLoadBalance(m_numTest);
 }
 
 //***********************************************************************
 
 void Run::integrationProcedure(double &dt, int lvl, double &dtMax, int &nbCellsTotalAMR)
 {
+  TRACE_SCOPE("AMR level", lvl);
   //1) AMR Level time step determination
   double dtLvl = dt * pow(2., -(double)lvl);
 
   //2) (Un)Reffinement procedure
   if (m_lvlMax > 0) {
+    PROFILE_SCOPE("AMR refinement");
     m_stat.startAMRTime();
     m_mesh->procedureRaffinement(m_cellsLvl, m_boundariesLvl, lvl, m_addPhys, m_model, nbCellsTotalAMR, m_cells, m_eos);
     m_stat.endAMRTime();
@@ -291,6 +363,7 @@ void Run::integrationProcedure(double &dt, int lvl, double &dtMax, int &nbCellsT
 
   //3) Slopes determination for second order and gradients for additional physics
   if (m_order == "SECONDORDER") {
+    PROFILE_SCOPE("slopes");
     for (unsigned int i = 0; i < m_boundariesLvl[lvl].size(); i++) { if (!m_boundariesLvl[lvl][i]->getSplit()) { m_boundariesLvl[lvl][i]->computeSlopes(m_numberPhases, m_numberTransports); } }
     if (Ncpu > 1) {
       m_mesh->communicationsSlopes(m_cells, lvl);
@@ -299,6 +372,7 @@ void Run::integrationProcedure(double &dt, int lvl, double &dtMax, int &nbCellsT
   }
   if (lvl < m_lvlMax) {
     if (m_numberAddPhys) {
+      PROFILE_SCOPE("additional physics");
 			for (unsigned int i = 0; i < m_cellsLvl[lvl].size(); i++) { if (!m_cellsLvl[lvl][i]->getSplit()) { m_cellsLvl[lvl][i]->prepareAddPhys(); } }
     }
     //4) Recursive call for level up integration procedure
@@ -307,10 +381,12 @@ void Run::integrationProcedure(double &dt, int lvl, double &dtMax, int &nbCellsT
 
   //5) Advancement procedure
   this->advancingProcedure(dtLvl, lvl, dtMax);
+  this->countCellUpdates(lvl);
 
   //6) Additional calculations for AMR levels > 0
   if (lvl > 0) {
     if (m_order == "SECONDORDER") {
+      PROFILE_SCOPE("slopes");
       for (unsigned int i = 0; i < m_boundariesLvl[lvl].size(); i++) { if (!m_boundariesLvl[lvl][i]->getSplit()) { m_boundariesLvl[lvl][i]->computeSlopes(m_numberPhases, m_numberTransports); } }
       if (Ncpu > 1) {
         m_mesh->communicationsSlopes(m_cells, lvl);
@@ -319,7 +395,42 @@ void Run::integrationProcedure(double &dt, int lvl, double &dtMax, int &nbCellsT
     }
     if (lvl < m_lvlMax) { this->integrationProcedure(dt, lvl + 1, dtMax, nbCellsTotalAMR); }
     this->advancingProcedure(dtLvl, lvl, dtMax);
+    this->countCellUpdates(lvl);
+  }
+}
+
+//***********************************************************************
+
+void Run::countCellUpdates(const int &lvl)
+{
+  if (m_lvlMax == 0) { m_stat.addCellUpdates(m_cellsLvl[0].size()); return; }
+  long long leafCells(0);
+  for (unsigned int i = 0; i < m_cellsLvl[lvl].size(); i++) { if (!m_cellsLvl[lvl][i]->getSplit()) { leafCells++; } }
+  m_stat.addCellUpdates(leafCells);
+}
+
+//***********************************************************************
+
+double Run::computeProgress() const
+{
+  if (m_controleIterations) return static_cast<double>(m_iteration) / max(m_nbIte, 1);
+  return m_physicalTime / m_finalPhysicalTime;
+}
+
+//***********************************************************************
+
+void Run::updateMemory()
+{
+  long long numberCells(m_mesh->getNumberCellsGhost()), numberInterfaces(0);
+  for (int lvl = 0; lvl <= m_lvlMax; lvl++) {
+    numberCells += m_cellsLvl[lvl].size();
+    numberInterfaces += m_boundariesLvl[lvl].size();
   }
+  long long bytesOutputs(m_outPut->getMemoryStaging());
+  for (unsigned int c = 0; c < m_cuts.size(); c++) { bytesOutputs += m_cuts[c]->getMemoryStaging(); }
+  for (unsigned int p = 0; p < m_probes.size(); p++) { bytesOutputs += m_probes[p]->getMemoryStaging(); }
+  m_memory.update(numberCells, numberInterfaces, parallel.getBuffersBytes(), bytesOutputs);
+  if (m_lvlMax > 0) { m_mesh->setRefinementAllowed(m_memory.refinementAllowed(m_numTest, m_iteration)); }
 }
 
 //***********************************************************************
@@ -330,13 +441,13 @@ void Run::advancingProcedure(double &dt, int &lvl, double &dtMax) const
   if (m_order == "FIRSTORDER") { this->solveHyperbolic(dt, lvl, dtMax); }
   else { this->solveHyperbolicO2(dt, lvl, dtMax); }
   //2) Finite volume scheme for additional physics
-  if (m_numberAddPhys) this->solveAdditionalPhysics(dt, lvl);
+  if (m_numberAddPhys) { PROFILE_SCOPE("additional physics"); this->solveAdditionalPhysics(dt, lvl); }
   //3) Source terms integration before relaxations
-  if (m_numberSources) this->solveSourceTerms(dt, lvl);
+  if (m_numberSources) { PROFILE_SCOPE("source terms"); this->solveSourceTerms(dt, lvl); }
   //4) Relaxations to equilibria
-  if (m_numberPhases > 1) this->solveRelaxations(lvl);
+  if (m_numberPhases > 1) { PROFILE_SCOPE("relaxations"); this->solveRelaxations(lvl); }
   //5) Averaging childs cells in mother cell (if AMR)
-  if (lvl < m_lvlMax) { for (unsigned int i = 0; i < m_cellsLvl[lvl].size(); i++) { m_cellsLvl[lvl][i]->averageChildrenInParent(); } }
+  if (lvl < m_lvlMax) { PROFILE_SCOPE("AMR averaging"); for (unsigned int i = 0; i < m_cellsLvl[lvl].size(); i++) { m_cellsLvl[lvl][i]->averageChildrenInParent(); } }
   //6) Final communications
   if (Ncpu > 1) { m_mesh->communicationsPrimitives(m_cells, m_eos, lvl); }
 }
@@ -345,6 +456,7 @@ void Run::advancingProcedure(double &dt, int &lvl, double &dtMax) const
 
 void Run::solveHyperbolicO2(double &dt, int &lvl, double &dtMax) const
 {
+  PROFILE_SCOPE("hyperbolic");
   //1) m_cons saves for AMR/second order combination
   //------------------------------------------------
   for (unsigned int i = 0; i < m_cellsLvl[lvl].size(); i++) { if (!m_cellsLvl[lvl][i]->getSplit()) { m_cellsLvl[lvl][i]->saveCons(m_numberPhases, m_numberTransports); } }
@@ -352,15 +464,21 @@ void Run::solveHyperbolicO2(double &dt, int &lvl, double &dtMax) const
   //2) Spatial second order scheme
   //------------------------------
   //Fluxes are determined at each cells interfaces and stored in the m_cons variableof corresponding cells. Hyperbolic maximum time step determination
-  for (unsigned int i = 0; i < m_boundariesLvl[lvl].size(); i++) { if (!m_boundariesLvl[lvl][i]->getSplit()) { m_boundariesLvl[lvl][i]->computeFlux(m_numberPhases, m_numberTransports, dtMax, *m_globalLimiter, *m_interfaceLimiter, *m_globalVolumeFractionLimiter, *m_interfaceVolumeFractionLimiter, m_physicalTime); } }
+  {
+    PROFILE_SCOPE("flux");
+    for (unsigned int i = 0; i < m_boundariesLvl[lvl].size(); i++) { if (!m_boundariesLvl[lvl][i]->getSplit()) { m_boundariesLvl[lvl][i]->computeFlux(m_numberPhases, m_numberTransports, dtMax, *m_globalLimiter, *m_interfaceLimiter, *m_globalVolumeFractionLimiter, *m_interfaceVolumeFractionLimiter, m_physicalTime); } }
+  }
 
   //3)Prediction step using slopes
   //------------------------------
-  for (unsigned int i = 0; i < m_cellsLvl[lvl].size(); i++) { if (!m_cellsLvl[lvl][i]->getSplit()) { m_cellsLvl[lvl][i]->predictionOrdre2(dt, m_numberPhases, m_numberTransports, m_symmetry); } }
+  {
+    PROFILE_SCOPE("prediction");
+    for (unsigned int i = 0; i < m_cellsLvl[lvl].size(); i++) { if (!m_cellsLvl[lvl][i]->getSplit()) { m_cellsLvl[lvl][i]->predictionOrdre2(dt, m_numberPhases, m_numberTransports, m_symmetry); } }
 
-  //4) m_cons recovery for AMR/second order combination (substotute to setToZeroCons)
-  //---------------------------------------------------------------------------------
-  for (unsigned int i = 0; i < m_cellsLvl[lvl].size(); i++) { if (!m_cellsLvl[lvl][i]->getSplit()) { m_cellsLvl[lvl][i]->recuperationCons(m_numberPhases, m_numberTransports); } }
+    //4) m_cons recovery for AMR/second order combination (substotute to setToZeroCons)
+    //---------------------------------------------------------------------------------
+    for (unsigned int i = 0; i < m_cellsLvl[lvl].size(); i++) { if (!m_cellsLvl[lvl][i]->getSplit()) { m_cellsLvl[lvl][i]->recuperationCons(m_numberPhases, m_numberTransports); } }
+  }
 
   //5) vecPhasesO2 communications
   //-----------------------------
@@ -368,19 +486,26 @@ void Run::solveHyperbolicO2(double &dt, int &lvl, double &dtMax) const
 
   //6) Optional new slopes determination (improves code stability)
   //--------------------------------------------------------------
-  for (unsigned int i = 0; i < m_boundariesLvl[lvl].size(); i++) { if (!m_boundariesLvl[lvl][i]->getSplit()) { m_boundariesLvl[lvl][i]->computeSlopes(m_numberPhases, m_numberTransports, vecPhasesO2); } }
-  if (Ncpu > 1) {
-    m_mesh->communicationsSlopes(m_cells, lvl);
-    if (lvl > 0) { m_mesh->communicationsSlopes(m_cells, lvl - 1); }
+  {
+    PROFILE_SCOPE("slopes");
+    for (unsigned int i = 0; i < m_boundariesLvl[lvl].size(); i++) { if (!m_boundariesLvl[lvl][i]->getSplit()) { m_boundariesLvl[lvl][i]->computeSlopes(m_numberPhases, m_numberTransports, vecPhasesO2); } }
+    if (Ncpu > 1) {
+      m_mesh->communicationsSlopes(m_cells, lvl);
+      if (lvl > 0) { m_mesh->communicationsSlopes(m_cells, lvl - 1); }
+    }
   }
 
   //7) Spatial scheme on predicted variables
   //----------------------------------------
   //Fluxes are determined at each cells interfaces and stored in the m_cons variableof corresponding cells. Hyperbolic maximum time step determination
-  for (unsigned int i = 0; i < m_boundariesLvl[lvl].size(); i++) { if (!m_boundariesLvl[lvl][i]->getSplit()) { m_boundariesLvl[lvl][i]->computeFlux(m_numberPhases, m_numberTransports, dtMax, *m_globalLimiter, *m_interfaceLimiter, *m_globalVolumeFractionLimiter, *m_interfaceVolumeFractionLimiter, m_physicalTime, vecPhasesO2); } }
+  {
+    PROFILE_SCOPE("flux");
+    for (unsigned int i = 0; i < m_boundariesLvl[lvl].size(); i++) { if (!m_boundariesLvl[lvl][i]->getSplit()) { m_boundariesLvl[lvl][i]->computeFlux(m_numberPhases, m_numberTransports, dtMax, *m_globalLimiter, *m_interfaceLimiter, *m_globalVolumeFractionLimiter, *m_interfaceVolumeFractionLimiter, m_physicalTime, vecPhasesO2); } }
+  }
 
   //8) Time evolution
   //-----------------
+  PROFILE_SCOPE("time evolution");
   for (unsigned int i = 0; i < m_cellsLvl[lvl].size(); i++) {
     if (!m_cellsLvl[lvl][i]->getSplit()) {
       m_cellsLvl[lvl][i]->timeEvolution(dt, m_numberPhases, m_numberTransports, m_symmetry, vecPhasesO2);   //Obtention des cons pour shema sur (Un+1-Un)/dt
@@ -394,13 +519,18 @@ void Run::solveHyperbolicO2(double &dt, int &lvl, double &dtMax) const
 
 void Run::solveHyperbolic(double &dt, int &lvl, double &dtMax) const
 {
+  PROFILE_SCOPE("hyperbolic");
   //1) Spatial scheme
   //-----------------
   //Fluxes are determined at each cells interfaces and stored in the m_cons variableof corresponding cells. Hyperbolic maximum time step determination
-  for (unsigned int i = 0; i < m_boundariesLvl[lvl].size(); i++) { if (!m_boundariesLvl[lvl][i]->getSplit()) { m_boundariesLvl[lvl][i]->computeFlux(m_numberPhases, m_numberTransports, dtMax, *m_globalLimiter, *m_interfaceLimiter, *m_globalVolumeFractionLimiter, *m_interfaceVolumeFractionLimiter, m_physicalTime); } }
+  {
+    PROFILE_SCOPE("flux");
+    for (unsigned int i = 0; i < m_boundariesLvl[lvl].size(); i++) { if (!m_boundariesLvl[lvl][i]->getSplit()) { m_boundariesLvl[lvl][i]->computeFlux(m_numberPhases, m_numberTransports, dtMax, *m_globalLimiter, *m_interfaceLimiter, *m_globalVolumeFractionLimiter, *m_interfaceVolumeFractionLimiter, m_physicalTime); } }
+  }
 
   //2) Time evolution
   //-----------------
+  PROFILE_SCOPE("time evolution");
   for (unsigned int i = 0; i < m_cellsLvl[lvl].size(); i++) {
     if (!m_cellsLvl[lvl][i]->getSplit()) {
       m_cellsLvl[lvl][i]->timeEvolution(dt, m_numberPhases, m_numberTransports, m_symmetry);   //Obtention des cons pour shema sur (Un+1-Un)/dt
@@ -494,6 +624,8 @@ void Run::verifyErrors() const
 
 void Run::finalize()
 {
+  //Main output first: its destructor joins the background writer of the last snapshot
+  delete m_outPut;
   //Global desallocations
   for (int i = 0; i < m_mesh->getNumberFaces(); i++) { delete m_boundaries[i]; } delete[] m_boundaries;
   for (int i = 0; i < m_mesh->getNumberCellsTotal(); i++) { delete m_cells[i]; } delete[] m_cells;
@@ -521,7 +653,7 @@ void Run::finalize()
   delete m_model;
   delete m_globalLimiter; delete m_interfaceLimiter; delete m_globalVolumeFractionLimiter; delete m_interfaceVolumeFractionLimiter;
   delete m_input;
-  delete m_outPut;
+  delete m_checkpoint;
   for (unsigned int s = 0; s < m_cuts.size(); s++) { delete m_cuts[s]; }
   //Desallocations AMR
   delete[] m_cellsLvl;
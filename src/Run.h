@@ -59,7 +59,9 @@ class Run;
 
 #include "InputOutput/Input.h"
 #include "InputOutput/Output.h"
+#include "InputOutput/Checkpoint.h"
 #include "timeStats.h"
+#include "memoryStats.h"
 
 #include "Relaxations/HeaderRelaxations.h"
 
@@ -93,12 +95,18 @@ class Run
     //Specific solvers
     void integrationProcedure(double &dt, int lvl, double &dtMax, int &nbCellsTotalAMR);
     void advancingProcedure(double &dt, int &lvl, double &dtMax) const;
+    //! \brief    Count the leaf cells of the level updated by the last advancing procedure
+    void countCellUpdates(const int &lvl);
     void solveHyperbolic(double &dt, int &lvl, double &dtMax) const;
     void solveHyperbolicO2(double &dt, int &lvl, double &dtMax) const;
     void solveAdditionalPhysics(double &dt, int &lvl) const;
     void solveSourceTerms(double &dt, int &lvl) const;
     void solveRelaxations(int &lvl) const;
     void verifyErrors() const;
+    //! \brief    Fraction of the computation already done (physical time or iterations according to the time control mode)
+    double computeProgress() const;
+    //! \brief    Memory accounting of the subsystems and soft limit on the AMR refinement (to be called by all CPUs)
+    void updateMemory();
 
     int m_numTest;                             //!<Number of the simulation
 
@@ -122,6 +130,8 @@ class Run
     int m_nbCellsTotalAMR;                     //!<Number de mailles total maximum durant la simulation
     std::vector<Cell *> *m_cellsLvl;           //!<Tableau de vecteurs contenant les cells de compute, un vecteur par niveau.
     std::vector<CellInterface *> *m_boundariesLvl;   //!<Tableau de vecteurs contenant les boundaries de compute, un vecteur par niveau.
+    int m_loadBalancingFreq;                   //!<Number of iterations between two repartitions of the level-0 cells between CPUs (0: no repartition)
+    double m_loadBalancingThreshold;           //!<Imbalance of the CPU loads (max/avg) above which the level-0 cells are moved
 
     //Geometrical attributes
     bool m_parallelPreTreatment;               //!<Choice for mesh parallel pre-treatment  (needed for first simulation on a new parallel unstructured geometry)
@@ -147,13 +157,18 @@ class Run
     double m_physicalTime;                     //!<Physical time
     int m_iteration;                           //!<time iteration number
     int m_resumeSimulation;                    //!<File number for restarting a simulation
+    int m_resumeCheckpoint;                    //!<Checkpoint number for restarting a simulation (0: no restart from checkpoint)
 
     //Input/Output attributes
 	  Input* m_input;						                 //!<Input object
     Output* m_outPut;                          //!<Main output object
     std::vector<Output *> m_cuts;              //!<Vector of output objects for cuts
     std::vector<Output *> m_probes;            //!<Vector of output objects for probes
+    Checkpoint *m_checkpoint;                  //!<Binary checkpoints for restart
     timeStats m_stat;                          //!<Object linked to computational time statistics
+    Throughput m_throughputHeartbeat;          //!<Cell updates per second between two heartbeat printings
+    Throughput m_throughputOutputs;            //!<Cell updates per second between two output files
+    memoryStats m_memory;                      //!<Memory accounting per subsystem
     double *m_pMax, *m_pMaxWall;             //!<Maximal pressure found between each written output and its corresponding coordinate (only for few test case)
 
     //variable inlet conditions
@@ -164,6 +179,8 @@ class Run
     friend class OutputXML;
     friend class OutputGNU;
     friend class OutputProbeGNU;
+    friend class OutputCutGNU;
+    friend class Checkpoint;
     friend class Mesh;
 };
 
@@ -58,8 +58,11 @@ int main(int argc, char* argv[])
 
   //Parallel initialization
   MPI_Init(&argc, &argv);
-  MPI_Comm_rank(MPI_COMM_WORLD, &rankCpu);
-  MPI_Comm_size(MPI_COMM_WORLD, &Ncpu);
+  int rankWorld, NcpuWorld;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rankWorld);
+  MPI_Comm_size(MPI_COMM_WORLD, &NcpuWorld);
+  rankCpu = rankWorld;
+  Ncpu = NcpuWorld;
 
   if(rankCpu == 0) displayHeader();
   MPI_Barrier(MPI_COMM_WORLD);
@@ -74,11 +77,61 @@ int main(int argc, char* argv[])
   XMLNode *xmlNode = xmlEcogen.FirstChildElement("ecogen");
   //if (xmlNode == NULL) throw ErrorXMLRacine("ecogen", fileName.str(), __FILE__, __LINE__);
 
+  //Concurrent execution of the test cases by groups of CPUs (optional)
+  //ex : <batch groups="4"/>
+  //-------------------------------------------------------------------
+  int numberGroups(1), group(0);
+  XMLElement *elementBatch = xmlNode->FirstChildElement("batch");
+  if (elementBatch != NULL) {
+    if (elementBatch->QueryIntAttribute("groups", &numberGroups) != XML_NO_ERROR || numberGroups < 1) {
+      if (rankWorld == 0) cerr << "Warning: invalid number of groups in batch markup of " << fileName.str() << ", test cases run successively" << endl;
+      numberGroups = 1;
+    }
+    numberGroups = min(numberGroups, NcpuWorld);
+  }
+  MPI_Win winNextTestCase(MPI_WIN_NULL);
+  int *nextTestCase(0);
+  if (numberGroups > 1) {
+    //Contiguous ranks in each group, so that a group stays on as few nodes as possible
+    group = static_cast<int>(static_cast<long long>(rankWorld) * numberGroups / NcpuWorld);
+    MPI_Comm_split(MPI_COMM_WORLD, group, rankWorld, &commCompute);
+    MPI_Comm_rank(commCompute, &rankCpu);
+    MPI_Comm_size(commCompute, &Ncpu);
+    groupCpu = group;
+    //Index of the next test case to execute, held by the CPU 0 of MPI_COMM_WORLD and fetched by the CPU 0 of each group
+    MPI_Win_allocate((rankWorld == 0) ? sizeof(int) : 0, sizeof(int), MPI_INFO_NULL, MPI_COMM_WORLD, &nextTestCase, &winNextTestCase);
+    if (rankWorld == 0) {
+      MPI_Win_lock(MPI_LOCK_EXCLUSIVE, 0, 0, winNextTestCase);
+      *nextTestCase = 0;
+      MPI_Win_unlock(0, winNextTestCase);
+      cout << "Test cases executed concurrently by " << numberGroups << " groups of CPUs" << endl;
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+
   //Loop on the test cases to execute
   //---------------------------------
-  int numTestCase(0);
+  vector<XMLElement*> elementsTestCase;
   XMLElement *elementTestCase = xmlNode->FirstChildElement("testCase");
   while (elementTestCase != NULL) {
+    elementsTestCase.push_back(elementTestCase);
+    elementTestCase = elementTestCase->NextSiblingElement("testCase");
+  }
+  int indexTestCase(-1), numTestCase(0);
+  while (true) {
+    //Test cases distributed dynamically among the groups: a group takes the next one as soon as it is free
+    if (numberGroups > 1) {
+      if (rankCpu == 0) {
+        int one(1);
+        MPI_Win_lock(MPI_LOCK_SHARED, 0, 0, winNextTestCase);
+        MPI_Fetch_and_op(&one, &indexTestCase, MPI_INT, 0, 0, MPI_SUM, winNextTestCase);
+        MPI_Win_unlock(0, winNextTestCase);
+      }
+      MPI_Bcast(&indexTestCase, 1, MPI_INT, 0, commCompute);
+    }
+    else { indexTestCase++; }
+    if (indexTestCase >= static_cast<int>(elementsTestCase.size())) break;
+    elementTestCase = elementsTestCase[indexTestCase];
     try {
       XMLNode* xmlNode2 = elementTestCase->FirstChild();
       if (xmlNode2 == NULL) throw ErrorXMLElement("testCase", fileName.str(), __FILE__, __LINE__);
@@ -86,28 +139,29 @@ int main(int argc, char* argv[])
       if (xmlText == NULL) throw ErrorXMLElement("testCase", fileName.str(), __FILE__, __LINE__);
 
       //1) Creation of the test case
-      numTestCase++;
+      numTestCase = indexTestCase + 1;
       run = new Run(xmlText->Value(), numTestCase);
-      MPI_Barrier(MPI_COMM_WORLD);
+      MPI_Barrier(commCompute);
       if (rankCpu == 0) {
         cout << "************************************************************" << endl;
         cout << "          EXECUTION OF THE TEST CASE NUMBER : " << numTestCase << endl;
+        if (numberGroups > 1) cout << "          ON GROUP " << group << " (" << Ncpu << " CPU(s))" << endl;
         cout << "************************************************************" << endl;
         cout << "T" << numTestCase << " | Test case : " << xmlText->Value() << endl;
       }
-      MPI_Barrier(MPI_COMM_WORLD);
+      MPI_Barrier(commCompute);
       //2) Execution of the test case
       //if (rankCpu == 0) { cout << "wait launch test" << endl;  system("pause"); }
-      //MPI_Barrier(MPI_COMM_WORLD);
+      //MPI_Barrier(commCompute);
       run->initialize(argc, argv);
       run->solver();
       //if (rankCpu == 0) { cout << "wait end test" << endl; system("pause"); }
-      //MPI_Barrier(MPI_COMM_WORLD);
+      //MPI_Barrier(commCompute);
       run->finalize();
       //3) Removal of the test case
       delete run;
       //if (rankCpu == 0) { cout << "test finished" << endl; system("pause"); }
-      //MPI_Barrier(MPI_COMM_WORLD);
+      //MPI_Barrier(commCompute);
     }
     //Gestion of the exceptions
     //-------------------------
@@ -125,8 +179,14 @@ int main(int argc, char* argv[])
         delete run;
       }
     }
-    elementTestCase = elementTestCase->NextSiblingElement("testCase");
   }//End of the loop on test cases
+  if (numberGroups > 1) {
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Win_free(&winNextTestCase);
+    MPI_Comm_free(&commCompute);
+    commCompute = MPI_COMM_WORLD;
+    groupCpu = -1;
+  }
   MPI_Barrier(MPI_COMM_WORLD);
   MPI_Finalize();
   return 0;
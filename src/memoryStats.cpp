@@ -0,0 +1,239 @@
+//  
+//       ,---.     ,--,    .---.     ,--,    ,---.    .-. .-. 
+//       | .-'   .' .')   / .-. )  .' .'     | .-'    |  \| | 
+//       | `-.   |  |(_)  | | |(_) |  |  __  | `-.    |   | | 
+//       | .-'   \  \     | | | |  \  \ ( _) | .-'    | |\  | 
+//       |  `--.  \  `-.  \ `-' /   \  `-) ) |  `--.  | | |)| 
+//       /( __.'   \____\  )---'    )\____/  /( __.'  /(  (_) 
+//      (__)              (_)      (__)     (__)     (__)     
+//
+//  This file is part of ECOGEN.
+//
+//  ECOGEN is the legal property of its developers, whose names 
+//  are listed in the copyright file included with this source 
+//  distribution.
+//
+//  ECOGEN is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, 
+//  or (at your option) any later version.
+//  
+//  ECOGEN is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with ECOGEN (file LICENSE).  
+//  If not, see <http://www.gnu.org/licenses/>.
+
+
+//! \file      memoryStats.cpp
+//! \version   1.0
+
+#include "memoryStats.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <malloc.h>
+#include "Parallel.h"
+#include "Cell.h"
+#include "CellInterface.h"
+#include "Ordre2/CellO2.h"
+#include "Ordre2/CellInterfaceO2.h"
+#include "Meshes/ElementCartesian.h"
+#include "Meshes/FaceCartesian.h"
+#include "Meshes/MeshUnStruct/ElementNS.h"
+#include "Meshes/MeshUnStruct/FaceNS.h"
+
+//mallinfo2 is available since glibc 2.33
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#define MEMORY_HEAP_MEASURE
+#endif
+
+using namespace std;
+
+static const char* namesMemory[numberTypesMemory] = { "cells", "O2 cell copies", "interfaces/faces", "slopes", "communication buffers", "output staging" };
+
+//***********************************************************************
+
+//! \brief    Bytes currently allocated on the heap (0 if unknown)
+static long long heapBytes()
+{
+#ifdef MEMORY_HEAP_MEASURE
+  struct mallinfo2 infos(mallinfo2());
+  return static_cast<long long>(infos.uordblks + infos.hblkhd);
+#else
+  return 0;
+#endif
+}
+
+//***********************************************************************
+
+memoryStats::memoryStats() : m_bytesCell(0), m_bytesCellO2(0), m_bytesInterface(0), m_bytesSlopes(0), m_heapMeasured(false),
+  m_bytes(numberTypesMemory + 1, 0), m_highWater(numberTypesMemory + 1, 0), m_softLimit(0.), m_checkFrequency(10), m_refinementAllowed(true)
+{}
+
+//***********************************************************************
+
+memoryStats::~memoryStats(){}
+
+//***********************************************************************
+
+void memoryStats::calibrate(const string &order, const int &numberPhases, const int &numberTransports, const vector<AddPhys*> &addPhys,
+  Model *model, const TypeM &typeMesh)
+{
+  //Geometrical part (elements and faces are not allocated with the cells and interfaces)
+  long long bytesElement(sizeof(ElementCartesian)), bytesFace(sizeof(FaceCartesian));
+  if (typeMesh == UNS) { bytesElement = sizeof(ElementNS); bytesFace = sizeof(FaceNS); }
+
+  //Probe objects, the heap measure including the model dependent allocations
+  long long heap(heapBytes());
+  Cell *cell = new Cell;
+  cell->allocate(numberPhases, numberTransports, addPhys, model);
+  m_bytesCell = heapBytes() - heap;
+  heap = heapBytes();
+  CellInterface *cellInterface = new CellInterface;
+  m_bytesInterface = heapBytes() - heap;
+  m_heapMeasured = (m_bytesCell > 0 && m_bytesInterface > 0);
+  if (!m_heapMeasured) { m_bytesCell = sizeof(Cell); m_bytesInterface = sizeof(CellInterface); }
+  if (order == "SECONDORDER") {
+    heap = heapBytes();
+    Cell *cellO2 = new CellO2;
+    cellO2->allocate(numberPhases, numberTransports, addPhys, model);
+    m_bytesCellO2 = (m_heapMeasured) ? heapBytes() - heap - m_bytesCell : sizeof(CellO2) - sizeof(Cell);
+    heap = heapBytes();
+    CellInterface *interfaceO2 = new CellInterfaceO2;
+    interfaceO2->initializeGauche(cellO2);
+    int allocateSlopeLocal(1); //Buffers shared by all interfaces already allocated
+    interfaceO2->allocateSlopes(numberPhases, numberTransports, allocateSlopeLocal);
+    m_bytesSlopes = (m_heapMeasured) ? heapBytes() - heap - m_bytesInterface : sizeof(CellInterfaceO2) - sizeof(CellInterface);
+    delete interfaceO2;
+    delete cellO2;
+  }
+  delete cellInterface;
+  delete cell;
+  m_bytesCell += bytesElement;
+  m_bytesInterface += bytesFace;
+}
+
+//***********************************************************************
+
+void memoryStats::update(const long long &numberCells, const long long &numberInterfaces, const long long &bytesCommunications, const long long &bytesOutputs)
+{
+  m_bytes[memCells] = numberCells*m_bytesCell;
+  m_bytes[memCellsO2] = numberCells*m_bytesCellO2;
+  m_bytes[memInterfaces] = numberInterfaces*m_bytesInterface;
+  m_bytes[memSlopes] = numberInterfaces*m_bytesSlopes;
+  m_bytes[memCommunications] = bytesCommunications;
+  m_bytes[memOutputs] = bytesOutputs;
+  m_bytes[numberTypesMemory] = 0;
+  for (int m = 0; m < numberTypesMemory; m++) { m_bytes[numberTypesMemory] += m_bytes[m]; }
+  for (int m = 0; m <= numberTypesMemory; m++) { m_highWater[m] = max(m_highWater[m], m_bytes[m]); }
+}
+
+//***********************************************************************
+
+bool memoryStats::refinementAllowed(const int &numTest, const int &iteration)
+{
+  if (m_softLimit <= 0.) return true;
+  //Same iteration on all CPUs: the reduction is skipped by all of them
+  if (iteration % m_checkFrequency != 0) return m_refinementAllowed;
+  long long bytes(residentMemory());
+  if (bytes == 0) bytes = m_bytes[numberTypesMemory];
+  int reached(bytes > static_cast<long long>(m_softLimit*1048576.)), reachedGlobal(reached);
+  if (Ncpu > 1) { MPI_Allreduce(&reached, &reachedGlobal, 1, MPI_INT, MPI_MAX, commCompute); }
+  if (m_refinementAllowed == (reachedGlobal != 0) && rankCpu == 0) {
+    if (reachedGlobal) cout << "T" << numTest << " | Warning: memory soft limit of " << m_softLimit << " MB reached, AMR refinement stopped" << endl;
+    else cout << "T" << numTest << " | Memory back under the soft limit of " << m_softLimit << " MB, AMR refinement resumed" << endl;
+  }
+  m_refinementAllowed = (reachedGlobal == 0);
+  return m_refinementAllowed;
+}
+
+//***********************************************************************
+
+void memoryStats::printStats(const int &numTest, const string &folder) const
+{
+  //Per-CPU values gathered on CPU 0: current bytes, high-water marks, resident memory and its peak
+  int numberValues(2 * (numberTypesMemory + 1) + 2);
+  vector<double> local(numberValues);
+  for (int m = 0; m <= numberTypesMemory; m++) {
+    local[m] = static_cast<double>(m_bytes[m]);
+    local[numberTypesMemory + 1 + m] = static_cast<double>(m_highWater[m]);
+  }
+  local[numberValues - 2] = static_cast<double>(residentMemory());
+  local[numberValues - 1] = static_cast<double>(max(residentMemoryPeak(), residentMemory()));
+  vector<double> all(local);
+  if (Ncpu > 1) {
+    if (rankCpu == 0) all.resize(numberValues*Ncpu);
+    MPI_Gather(local.data(), numberValues, MPI_DOUBLE, all.data(), numberValues, MPI_DOUBLE, 0, commCompute);
+  }
+  if (rankCpu != 0) return;
+
+  //Maximum over the CPUs
+  vector<double> maxValues(local);
+  vector<int> maxCpu(numberValues, 0);
+  for (int r = 0; r < Ncpu; r++) {
+    for (int v = 0; v < numberValues; v++) {
+      if (all[r*numberValues + v] > maxValues[v]) { maxValues[v] = all[r*numberValues + v]; maxCpu[v] = r; }
+    }
+  }
+  const double MB(1048576.);
+  ios::fmtflags flags(cout.flags());
+  streamsize precision(cout.precision());
+  cout << "T" << numTest << " | ------------------------------------------" << endl;
+  cout << "T" << numTest << " | MEMORY ON " << Ncpu << " CPU(s) (MB, maximum over the CPUs)" << endl;
+  cout << "T" << numTest << " |     " << left << setw(36) << "subsystem" << right << setw(11) << "current" << setw(11) << "high-water" << setw(8) << "CPU" << endl;
+  cout << fixed << setprecision(2);
+  for (int m = 0; m <= numberTypesMemory; m++) {
+    cout << "T" << numTest << " |     " << left << setw(36) << ((m < numberTypesMemory) ? namesMemory[m] : "total accounted") << right
+      << setw(11) << maxValues[m] / MB << setw(11) << maxValues[numberTypesMemory + 1 + m] / MB << setw(8) << maxCpu[numberTypesMemory + 1 + m] << endl;
+  }
+  if (maxValues[numberValues - 1] > 0.) {
+    cout << "T" << numTest << " |     " << left << setw(36) << "resident (process)" << right
+      << setw(11) << maxValues[numberValues - 2] / MB << setw(11) << maxValues[numberValues - 1] / MB << setw(8) << maxCpu[numberValues - 1] << endl;
+  }
+  if (!m_heapMeasured) cout << "T" << numTest << " |     (heap allocations of cells and interfaces not measured: lower bounds)" << endl;
+  if (m_softLimit > 0.) cout << "T" << numTest << " |     soft limit per CPU = " << m_softLimit << " MB" << endl;
+  cout.flags(flags);
+  cout.precision(precision);
+  cout << "T" << numTest << " | ------------------------------------------" << endl;
+
+  //High-water marks of each CPU
+  ofstream fileStream((folder + "memory.out").c_str());
+  fileStream << "#High-water marks per CPU (MB):";
+  fileStream << " CPU";
+  for (int m = 0; m < numberTypesMemory; m++) { fileStream << " | " << namesMemory[m]; }
+  fileStream << " | total accounted | resident peak" << endl;
+  fileStream << fixed << setprecision(3);
+  for (int r = 0; r < Ncpu; r++) {
+    fileStream << r;
+    for (int m = 0; m <= numberTypesMemory; m++) { fileStream << " " << all[r*numberValues + numberTypesMemory + 1 + m] / MB; }
+    fileStream << " " << all[r*numberValues + numberValues - 1] / MB << endl;
+  }
+  fileStream.close();
+}
+
+//***********************************************************************
+
+long long memoryStats::residentMemory()
+{
+  long long pages(0), residentPages(0);
+  ifstream fileStream("/proc/self/statm");
+  if (!(fileStream >> pages >> residentPages)) return 0;
+  return residentPages*sysconf(_SC_PAGESIZE);
+}
+
+//***********************************************************************
+
+long long memoryStats::residentMemoryPeak()
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+  return static_cast<long long>(usage.ru_maxrss)*1024; //kB on Linux
+}
+
+//***********************************************************************
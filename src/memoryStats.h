@@ -0,0 +1,110 @@
+//  
+//       ,---.     ,--,    .---.     ,--,    ,---.    .-. .-. 
+//       | .-'   .' .')   / .-. )  .' .'     | .-'    |  \| | 
+//       | `-.   |  |(_)  | | |(_) |  |  __  | `-.    |   | | 
+//       | .-'   \  \     | | | |  \  \ ( _) | .-'    | |\  | 
+//       |  `--.  \  `-.  \ `-' /   \  `-) ) |  `--.  | | |)| 
+//       /( __.'   \____\  )---'    )\____/  /( __.'  /(  (_) 
+//      (__)              (_)      (__)     (__)     (__)     
+//
+//  This file is part of ECOGEN.
+//
+//  ECOGEN is the legal property of its developers, whose names 
+//  are listed in the copyright file included with this source 
+//  distribution.
+//
+//  ECOGEN is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, 
+//  or (at your option) any later version.
+//  
+//  ECOGEN is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//  
+//  You should have received a copy of the GNU General Public License
+//  along with ECOGEN (file LICENSE).  
+//  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef MEMORYSTATS_H
+#define MEMORYSTATS_H
+
+//! \file      memoryStats.h
+//! \version   1.0
+
+#include <string>
+#include <vector>
+#include "Tools.h"
+
+class Model;
+class AddPhys;
+
+//! \brief    Subsystems accounted by the memory statistics
+enum TypeMemory { memCells, memCellsO2, memInterfaces, memSlopes, memCommunications, memOutputs, numberTypesMemory };
+
+//! \class     memoryStats
+//! \brief     Memory accounting per subsystem with high-water marks, and soft limit stopping the AMR refinement
+//! \details   Cells and cell interfaces are accounted from their numbers and the bytes of one object of the run, measured once
+//!            on a probe object. The additional bytes of second order objects are accounted separately (O2 cell copies and slopes).
+//!            Communication buffers and output staging are accounted from their actual sizes.
+class memoryStats
+{
+  public:
+    memoryStats();
+    virtual ~memoryStats();
+
+    //! \brief    Measure the bytes of one cell and one cell interface of the run
+    //! \details  Heap allocations (phases, mixture, fluxes, slopes...) are measured on probe objects when the C library gives the
+    //!           allocated bytes (glibc), only the sizes of the objects are accounted otherwise.
+    //! \param    order             "FIRSTORDER" or "SECONDORDER"
+    //! \param    numberPhases      number of phases
+    //! \param    numberTransports  number of transported variables
+    //! \param    addPhys           additional physics
+    //! \param    model             flow model
+    //! \param    typeMesh          type of mesh (elements and faces of Cartesian or unstructured meshes)
+    void calibrate(const std::string &order, const int &numberPhases, const int &numberTransports, const std::vector<AddPhys*> &addPhys,
+      Model *model, const TypeM &typeMesh);
+    //! \brief    Soft limit on the memory of each CPU
+    //! \param    limit             soft limit in MB (0: no limit)
+    //! \param    checkFrequency    number of iterations between two checks of the soft limit
+    void setSoftLimit(const double &limit, const int &checkFrequency) { m_softLimit = limit; m_checkFrequency = checkFrequency; };
+    double getSoftLimit() const { return m_softLimit; };
+    //! \brief    Update the bytes of each subsystem and their high-water marks
+    //! \param    numberCells          cells of this CPU (all AMR levels, ghost cells included)
+    //! \param    numberInterfaces     cell interfaces of this CPU (all AMR levels)
+    //! \param    bytesCommunications  bytes of the communication buffers
+    //! \param    bytesOutputs         bytes held for printing
+    void update(const long long &numberCells, const long long &numberInterfaces, const long long &bytesCommunications, const long long &bytesOutputs);
+    //! \brief    Check the soft limit on the resident memory (accounted memory if unknown) of all CPUs (to be called by all CPUs)
+    //! \details  The check is done every m_checkFrequency iterations only, the result of the last check is returned otherwise.
+    //! \param    numTest           number of the test case, for the printing prefix
+    //! \param    iteration         current iteration
+    //! \return   false while the soft limit is reached on any CPU (a message is printed at each change)
+    bool refinementAllowed(const int &numTest, const int &iteration);
+    //! \brief    Print the current bytes and high-water marks of each subsystem (maximum over the CPUs) and the per-CPU high-water
+    //!           marks in the file memory.out (to be called by all CPUs)
+    //! \param    numTest           number of the test case, for the printing prefix
+    //! \param    folder            results folder
+    void printStats(const int &numTest, const std::string &folder) const;
+
+    //! \brief    Resident memory of the process in bytes (0 if unknown)
+    static long long residentMemory();
+    //! \brief    Peak resident memory of the process in bytes (0 if unknown)
+    static long long residentMemoryPeak();
+
+  private:
+    long long m_bytesCell;                          //!<Bytes of one cell (element included)
+    long long m_bytesCellO2;                        //!<Additional bytes of one second order cell
+    long long m_bytesInterface;                     //!<Bytes of one cell interface (face included)
+    long long m_bytesSlopes;                        //!<Additional bytes of one second order cell interface
+    bool m_heapMeasured;                            //!<Bytes per object measured on the heap
+    std::vector<long long> m_bytes;                 //!<Current bytes per subsystem, the last one being the total
+    std::vector<long long> m_highWater;             //!<High-water marks per subsystem, the last one being the total
+    double m_softLimit;                             //!<Soft limit in MB (0: no limit)
+    int m_checkFrequency;                           //!<Number of iterations between two checks of the soft limit
+    bool m_refinementAllowed;                       //!<Soft limit not reached at the last check
+};
+
+#endif // MEMORYSTATS_H
@@ -34,9 +34,24 @@
 
 #include "timeStats.h"
 #include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <map>
+#include <cstring>
+#include <algorithm>
+#include "Parallel.h"
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
+Profiler profiler;
+Tracer tracer;
+
 //***********************************************************************
 
 timeStats::timeStats(){}
@@ -49,56 +64,70 @@ timeStats::~timeStats(){}
 
 void timeStats::initialize()
 {
-  m_InitialTime = clock();
-  m_computationTime = 0;
-  m_AMRTime = 0;
+  m_InitialTime = wallTime();
+  m_computationTime = 0.;
+  m_AMRTime = 0.;
+  m_cellUpdates = 0;
 }
 
 //***********************************************************************
 
 void timeStats::updateComputationTime()
 {
-  m_computationTime += (clock() - m_InitialTime);
-  m_InitialTime = clock();
+  double time(wallTime());
+  m_computationTime += (time - m_InitialTime);
+  m_InitialTime = time;
 }
 
 //***********************************************************************
 
 void timeStats::startAMRTime()
 {
-  m_AMRRefTime = clock();
+  m_AMRRefTime = wallTime();
 }
 
 //***********************************************************************
 
 void timeStats::endAMRTime()
 {
-  m_AMRTime += (clock() - m_AMRRefTime);
+  m_AMRTime += (wallTime() - m_AMRRefTime);
 }
 
 //***********************************************************************
 
-void timeStats::setCompTime(const clock_t &time) { m_computationTime = time; }
+void timeStats::setCompTime(const clock_t &time) { m_computationTime = static_cast<double>(time) / CLOCKS_PER_SEC; }
 
 //***********************************************************************
 
-clock_t timeStats::getComputationTime() const { return m_computationTime; }
+clock_t timeStats::getComputationTime() const { return static_cast<clock_t>(m_computationTime * CLOCKS_PER_SEC); }
 
 //***********************************************************************
 
-void timeStats::printScreenStats(const int &numTest) const
+double timeStats::wallTime()
+{
+  return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//***********************************************************************
+
+void timeStats::printScreenStats(const int &numTest, const Throughput &throughput) const
 {
   printScreenTime(m_computationTime, "Elapsed time", numTest);
   printScreenTime(m_AMRTime, "AMR time", numTest);
 
-  //Estimation temps restant
-  //A faire...
+  //Throughput since the previous output and remaining time estimation
+  if (throughput.getCellUpdatesPerSecondGlobal() > 0.) {
+    cout << "T" << numTest << " |     Cell updates/s      = " << throughput.getCellUpdatesPerSecondGlobal();
+    if (Ncpu > 1) cout << " (per CPU " << throughput.getCellUpdatesPerSecondMin() << " to " << throughput.getCellUpdatesPerSecondMax() << ")";
+    cout << endl;
+  }
+  if (throughput.getRemainingTime() >= 0.) printScreenTime(throughput.getRemainingTime(), "Remaining time", numTest);
   cout << "T" << numTest << " | ------------------------------------------" << endl;
 }
 
 //***********************************************************************
 
-void timeStats::printScreenTime(const clock_t &time, string chaine, const int &numTest) const
+void timeStats::printScreenTime(const double &time, string chaine, const int &numTest) const
 {
   //Managing string size
   string timeName(" |     " + chaine.substr(0,18));
@@ -108,12 +137,18 @@ void timeStats::printScreenTime(const clock_t &time, string chaine, const int &n
   timeName += " = ";
 
   //printing time
-  double convDouble = static_cast<double>(time) / CLOCKS_PER_SEC;
-  int convTime = static_cast<int>(convDouble);
-  int seconde(convTime);
+  cout << "T" << numTest << timeName << formatTime(time) << " " << endl;
+}
+
+//***********************************************************************
+
+string timeStats::formatTime(const double &time)
+{
+  stringstream chaine;
+  int seconde(static_cast<int>(time));
   if (seconde < 60)
   {
-    cout << "T" << numTest << timeName << convDouble << " s " << endl;
+    chaine << time << " s";
   }
   else
   {
@@ -121,15 +156,609 @@ void timeStats::printScreenTime(const clock_t &time, string chaine, const int &n
     seconde = seconde % 60;
     if (minute <60)
     {
-      cout << "T" << numTest << timeName << minute << " min " << seconde << " s " << endl;
+      chaine << minute << " min " << seconde << " s";
     }
     else
     {
       int heure(minute / 60);
       minute = minute % 60;
-      cout << "T" << numTest << timeName << heure << " h " << minute << " min " << seconde << " s " << endl;
+      chaine << heure << " h " << minute << " min " << seconde << " s";
     }
   }
+  return chaine.str();
+}
+
+//***********************************************************************
+//***********************************************************************
+
+Throughput::Throughput() : m_startTime(timeStats::wallTime()), m_startCellUpdates(0), m_startProgress(0.), m_rate(0.), m_rateMin(0.), m_rateMax(0.),
+  m_rateGlobal(0.), m_cellUpdatesGlobal(0.), m_remainingTime(-1.) {}
+
+//***********************************************************************
+
+Throughput::~Throughput(){}
+
+//***********************************************************************
+
+void Throughput::reset(const long long &cellUpdates, const double &progress)
+{
+  m_startTime = timeStats::wallTime();
+  m_startCellUpdates = cellUpdates;
+  m_startProgress = progress;
 }
 
-//***********************************************************************
\ No newline at end of file
+//***********************************************************************
+
+void Throughput::update(const long long &cellUpdates, const double &progress)
+{
+  double time(timeStats::wallTime());
+  double duration(max(time - m_startTime, 1.e-12));
+  double localCellUpdates(static_cast<double>(cellUpdates - m_startCellUpdates));
+  m_rate = localCellUpdates / duration;
+  m_rateMin = m_rate; m_rateMax = m_rate;
+  m_cellUpdatesGlobal = localCellUpdates;
+  if (Ncpu > 1) {
+    double local[3] = { -m_rate, m_rate, localCellUpdates }, global[3];
+    MPI_Allreduce(local, global, 2, MPI_DOUBLE, MPI_MAX, commCompute);
+    MPI_Allreduce(&local[2], &global[2], 1, MPI_DOUBLE, MPI_SUM, commCompute);
+    m_rateMin = -global[0]; m_rateMax = global[1];
+    m_cellUpdatesGlobal = global[2];
+  }
+  m_rateGlobal = m_cellUpdatesGlobal / duration;
+  //Remaining time at the pace of the window
+  m_remainingTime = -1.;
+  if (progress > m_startProgress) { m_remainingTime = max(1. - progress, 0.) * duration / (progress - m_startProgress); }
+  this->reset(cellUpdates, progress);
+}
+
+//***********************************************************************
+//***********************************************************************
+
+HardwareCounters::HardwareCounters() : m_active(false), m_numberOpened(0)
+{
+  for (int c = 0; c < numberTypesCounter; c++) { m_fd[c] = -1; m_position[c] = -1; }
+}
+
+//***********************************************************************
+
+HardwareCounters::~HardwareCounters() { this->deactivate(); }
+
+//***********************************************************************
+
+bool HardwareCounters::initialize()
+{
+  this->deactivate();
+  bool requested[numberTypesCounter];
+  for (int c = 0; c < numberTypesCounter; c++) { requested[c] = true; }
+  this->open(requested);
+
+  //Only the counters available on all the CPUs are kept, so that the statistics are comparable
+  int available[numberTypesCounter], availableEverywhere[numberTypesCounter];
+  for (int c = 0; c < numberTypesCounter; c++) { available[c] = availableEverywhere[c] = (m_fd[c] >= 0) ? 1 : 0; }
+  if (Ncpu > 1) MPI_Allreduce(available, availableEverywhere, numberTypesCounter, MPI_INT, MPI_MIN, commCompute);
+  bool reopen(false);
+  for (int c = 0; c < numberTypesCounter; c++) {
+    requested[c] = (availableEverywhere[c] == 1);
+    if (available[c] != availableEverywhere[c]) reopen = true;
+    if (!requested[c] && rankCpu == 0) cout << "Warning: hardware counter " << getName(c) << " unavailable" << endl;
+  }
+  if (reopen) { this->deactivate(); this->open(requested); }
+  m_active = (m_numberOpened > 0);
+  return m_active;
+}
+
+//***********************************************************************
+
+int HardwareCounters::open(const bool *requested)
+{
+  m_numberOpened = 0;
+#ifdef __linux__
+  const unsigned long long config[numberTypesCounter] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+  int leader(-1);
+  for (int c = 0; c < numberTypesCounter; c++) {
+    if (!requested[c]) continue;
+    struct perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = config[c];
+    attributes.exclude_kernel = 1; //User space only: allowed with the default perf_event_paranoid setting
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    int fd(static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, leader, 0)));
+    if (fd < 0) continue;
+    if (leader < 0) leader = fd;
+    m_fd[c] = fd;
+    m_position[c] = m_numberOpened++;
+  }
+#endif
+  return m_numberOpened;
+}
+
+//***********************************************************************
+
+void HardwareCounters::deactivate()
+{
+#ifdef __linux__
+  //Members of the group closed before their leader
+  int leader(-1);
+  for (int c = 0; c < numberTypesCounter; c++) {
+    if (m_fd[c] < 0) continue;
+    if (m_position[c] == 0) leader = m_fd[c];
+    else close(m_fd[c]);
+  }
+  if (leader >= 0) close(leader);
+#endif
+  for (int c = 0; c < numberTypesCounter; c++) { m_fd[c] = -1; m_position[c] = -1; }
+  m_numberOpened = 0;
+  m_active = false;
+}
+
+//***********************************************************************
+
+void HardwareCounters::read(long long *values) const
+{
+  for (int c = 0; c < numberTypesCounter; c++) { values[c] = 0; }
+#ifdef __linux__
+  //Group reading: number of counters, enabled and running times, then the values in the order of opening
+  unsigned long long buffer[3 + numberTypesCounter];
+  int leader(-1);
+  for (int c = 0; c < numberTypesCounter; c++) { if (m_position[c] == 0) leader = m_fd[c]; }
+  if (leader < 0 || ::read(leader, buffer, sizeof(buffer)) <= 0) return;
+  //Scaling when the group was multiplexed with other events
+  double scale((buffer[2] > 0 && buffer[2] < buffer[1]) ? static_cast<double>(buffer[1]) / static_cast<double>(buffer[2]) : 1.);
+  for (int c = 0; c < numberTypesCounter; c++) {
+    if (m_position[c] >= 0 && m_position[c] < static_cast<int>(buffer[0])) values[c] = static_cast<long long>(scale * buffer[3 + m_position[c]]);
+  }
+#endif
+}
+
+//***********************************************************************
+
+const char* HardwareCounters::getName(const int &counter)
+{
+  switch (counter) {
+    case counterCycles: return "cycles";
+    case counterInstructions: return "instructions";
+    case counterCacheMisses: return "LLCMisses";
+    case counterBranchMisses: return "branchMisses";
+    default: return "";
+  }
+}
+
+//***********************************************************************
+
+Profiler::Profiler() { this->reset(); }
+
+//***********************************************************************
+
+Profiler::~Profiler(){}
+
+//***********************************************************************
+
+void Profiler::reset()
+{
+  m_timers.clear();
+  Timer root;
+  root.name = "";
+  root.parent = -1;
+  root.time = 0.;
+  root.startTime = 0.;
+  root.calls = 0;
+  for (int c = 0; c < numberTypesCounter; c++) { root.counts[c] = 0; root.startCounts[c] = 0; }
+  m_timers.push_back(root);
+  m_current = 0;
+}
+
+//***********************************************************************
+
+int Profiler::start(const char* name)
+{
+  //Searching the timer among the children of the running one
+  int timer(-1);
+  const vector<int> &children(m_timers[m_current].children);
+  for (unsigned int c = 0; c < children.size(); c++) {
+    if (strcmp(m_timers[children[c]].name, name) == 0) { timer = children[c]; break; }
+  }
+  //First opening in this context
+  if (timer < 0) {
+    Timer newTimer = Timer(); //Value-initialized: times, calls and counters start at zero
+    newTimer.name = name;
+    newTimer.parent = m_current;
+    timer = m_timers.size();
+    m_timers.push_back(newTimer);
+    m_timers[m_current].children.push_back(timer);
+  }
+  m_timers[timer].startTime = timeStats::wallTime();
+  if (m_counters.isActive()) m_counters.read(m_timers[timer].startCounts);
+  m_current = timer;
+  return timer;
+}
+
+//***********************************************************************
+
+void Profiler::stop(const int &timer)
+{
+  if (m_counters.isActive()) {
+    long long counts[numberTypesCounter];
+    m_counters.read(counts);
+    for (int c = 0; c < numberTypesCounter; c++) { m_timers[timer].counts[c] += counts[c] - m_timers[timer].startCounts[c]; }
+  }
+  double time(timeStats::wallTime());
+  m_timers[timer].time += time - m_timers[timer].startTime;
+  m_timers[timer].calls++;
+  m_current = m_timers[timer].parent;
+  if (tracer.isRecording()) tracer.addEvent(m_timers[timer].name, -1, m_timers[timer].startTime, time);
+}
+
+//***********************************************************************
+
+void Profiler::printStats(const int &numTest, const double &elapsedTime) const
+{
+  //1) Timers identified by their full path, so that trees differing between CPUs can be matched
+  //--------------------------------------------------------------------------------------------
+  vector<string> paths, globalPaths;
+  this->gatherPaths(paths, globalPaths);
+
+  //2) Statistics over the CPUs (timers not opened on a CPU count for zero)
+  //-----------------------------------------------------------------------
+  int numberTimers(globalPaths.size());
+  if (numberTimers == 0) return;
+  map<string, int> localIndex;
+  for (unsigned int t = 1; t < paths.size(); t++) { localIndex[paths[t]] = t; }
+  vector<double> times(numberTimers, 0.), calls(numberTimers, 0.);
+  for (int t = 0; t < numberTimers; t++) {
+    map<string, int>::const_iterator it(localIndex.find(globalPaths[t]));
+    if (it != localIndex.end()) {
+      times[t] = m_timers[it->second].time;
+      calls[t] = static_cast<double>(m_timers[it->second].calls);
+    }
+  }
+  vector<double> minTimes(times), maxTimes(times), sumTimes(times), maxCalls(calls);
+  double referenceTime(elapsedTime);
+  if (Ncpu > 1) {
+    MPI_Reduce(times.data(), minTimes.data(), numberTimers, MPI_DOUBLE, MPI_MIN, 0, commCompute);
+    MPI_Reduce(times.data(), maxTimes.data(), numberTimers, MPI_DOUBLE, MPI_MAX, 0, commCompute);
+    MPI_Reduce(times.data(), sumTimes.data(), numberTimers, MPI_DOUBLE, MPI_SUM, 0, commCompute);
+    MPI_Reduce(calls.data(), maxCalls.data(), numberTimers, MPI_DOUBLE, MPI_MAX, 0, commCompute);
+    MPI_Reduce(&elapsedTime, &referenceTime, 1, MPI_DOUBLE, MPI_MAX, 0, commCompute);
+  }
+  if (rankCpu != 0) return;
+
+  //3) Printing as a tree (children just after their parent)
+  //--------------------------------------------------------
+  vector<int> order, depth;
+  treeOrder(globalPaths, order, depth);
+
+  cout << "T" << numTest << " | ------------------------------------------" << endl;
+  cout << "T" << numTest << " | WALL-CLOCK PROFILE ON " << Ncpu << " CPU(s) (s)" << endl;
+  cout << "T" << numTest << " |     " << left << setw(36) << "timer" << right << setw(11) << "avg" << setw(11) << "min" << setw(11) << "max" << setw(8) << "% avg" << setw(12) << "calls" << endl;
+  ios::fmtflags flags(cout.flags());
+  streamsize precision(cout.precision());
+  for (unsigned int o = 0; o < order.size(); o++) {
+    int t(order[o]);
+    if (maxCalls[t] == 0.) continue; //Timer still running (first opening)
+    string name(globalPaths[t].substr(globalPaths[t].rfind('/') + 1));
+    name = string(2 * depth[o], ' ') + name;
+    double average(sumTimes[t] / Ncpu);
+    cout << "T" << numTest << " |     " << left << setw(36) << name.substr(0, 36) << right << fixed << setprecision(3)
+      << setw(11) << average << setw(11) << minTimes[t] << setw(11) << maxTimes[t]
+      << setprecision(1) << setw(8) << ((referenceTime > 0.) ? 100. * average / referenceTime : 0.)
+      << setw(12) << static_cast<long long>(maxCalls[t]) << endl;
+  }
+  cout.flags(flags);
+  cout.precision(precision);
+  cout << "T" << numTest << " | ------------------------------------------" << endl;
+}
+
+//***********************************************************************
+
+void Profiler::initializeCounters()
+{
+  if (!m_counters.initialize() && rankCpu == 0) cout << "Warning: no hardware counter available, perfCounters ignored" << endl;
+}
+
+//***********************************************************************
+
+void Profiler::deactivateCounters()
+{
+  m_counters.deactivate();
+}
+
+//***********************************************************************
+
+//! \brief    Ratio of two hardware counters (-1 if unavailable)
+static double counterRatio(const HardwareCounters &counters, const double *values, const int &numerator, const int &denominator)
+{
+  if (!counters.isAvailable(numerator) || !counters.isAvailable(denominator) || values[denominator] <= 0.) return -1.;
+  return values[numerator] / values[denominator];
+}
+
+//! \brief    Hardware counter per leaf-cell update (-1 if unavailable)
+static double counterPerCellUpdate(const HardwareCounters &counters, const double *values, const int &counter, const double &cellUpdates)
+{
+  if (!counters.isAvailable(counter) || cellUpdates <= 0.) return -1.;
+  return values[counter] / cellUpdates;
+}
+
+//***********************************************************************
+
+void Profiler::printCounters(const int &numTest, const long long &cellUpdates, const string &folder) const
+{
+  if (!m_counters.isActive()) return;
+  vector<string> paths, globalPaths;
+  this->gatherPaths(paths, globalPaths);
+  int numberTimers(globalPaths.size());
+  if (numberTimers == 0) return;
+
+  //Local counters of each timer (timers not opened on a CPU count for zero), the last value being the cell updates
+  map<string, int> localIndex;
+  for (unsigned int t = 1; t < paths.size(); t++) { localIndex[paths[t]] = t; }
+  int numberValues(numberTimers * numberTypesCounter + 1);
+  vector<double> local(numberValues, 0.);
+  for (int t = 0; t < numberTimers; t++) {
+    map<string, int>::const_iterator it(localIndex.find(globalPaths[t]));
+    if (it == localIndex.end()) continue;
+    for (int c = 0; c < numberTypesCounter; c++) { local[t * numberTypesCounter + c] = static_cast<double>(m_timers[it->second].counts[c]); }
+  }
+  local[numberValues - 1] = static_cast<double>(cellUpdates);
+  vector<double> all(local);
+  if (Ncpu > 1) {
+    if (rankCpu == 0) all.resize(numberValues * Ncpu);
+    MPI_Gather(local.data(), numberValues, MPI_DOUBLE, all.data(), numberValues, MPI_DOUBLE, 0, commCompute);
+  }
+  if (rankCpu != 0) return;
+
+  //Sum over the CPUs
+  vector<double> sum(numberValues, 0.);
+  for (int r = 0; r < Ncpu; r++) {
+    for (int v = 0; v < numberValues; v++) { sum[v] += all[r * numberValues + v]; }
+  }
+
+  //1) Screen: summed over the CPUs
+  vector<int> order, depth;
+  treeOrder(globalPaths, order, depth);
+  ios::fmtflags flags(cout.flags());
+  streamsize precision(cout.precision());
+  cout << "T" << numTest << " | ------------------------------------------" << endl;
+  cout << "T" << numTest << " | HARDWARE COUNTERS ON " << Ncpu << " CPU(s) (sum over the CPUs, misses per cell update)" << endl;
+  cout << "T" << numTest << " |     " << left << setw(36) << "timer" << right << setw(12) << "Gcycles" << setw(12) << "Ginstr" << setw(7) << "IPC"
+    << setw(12) << "LLC miss/cu" << setw(12) << "br miss/cu" << endl;
+  for (unsigned int o = 0; o < order.size(); o++) {
+    int t(order[o]);
+    const double *values(&sum[t * numberTypesCounter]);
+    if (values[counterCycles] + values[counterInstructions] + values[counterCacheMisses] + values[counterBranchMisses] == 0.) continue; //Timer still running (first opening)
+    string name(globalPaths[t].substr(globalPaths[t].rfind('/') + 1));
+    name = string(2 * depth[o], ' ') + name;
+    cout << "T" << numTest << " |     " << left << setw(36) << name.substr(0, 36) << right << fixed;
+    double items[5] = { m_counters.isAvailable(counterCycles) ? 1.e-9 * values[counterCycles] : -1.,
+      m_counters.isAvailable(counterInstructions) ? 1.e-9 * values[counterInstructions] : -1.,
+      counterRatio(m_counters, values, counterInstructions, counterCycles),
+      counterPerCellUpdate(m_counters, values, counterCacheMisses, sum[numberValues - 1]),
+      counterPerCellUpdate(m_counters, values, counterBranchMisses, sum[numberValues - 1]) };
+    int widths[5] = { 12, 12, 7, 12, 12 };
+    for (int i = 0; i < 5; i++) {
+      if (items[i] < 0.) cout << setw(widths[i]) << "n/a";
+      else cout << setprecision((i == 2) ? 2 : 3) << setw(widths[i]) << items[i];
+    }
+    cout << endl;
+  }
+  cout.flags(flags);
+  cout.precision(precision);
+  cout << "T" << numTest << " | ------------------------------------------" << endl;
+
+  //2) File: per CPU
+  string file(folder + "perfCounters.out");
+  ofstream fileStream(file.c_str(), ios::out | ios::trunc);
+  if (!fileStream) { cerr << "Warning: hardware counters file can not be opened: " << file << endl; return; }
+  fileStream << "#cpu timer";
+  for (int c = 0; c < numberTypesCounter; c++) { fileStream << " " << HardwareCounters::getName(c); }
+  fileStream << " IPC " << HardwareCounters::getName(counterCacheMisses) << "PerCellUpdate " << HardwareCounters::getName(counterBranchMisses) << "PerCellUpdate" << endl;
+  fileStream << "#timers given by their quoted path, unavailable counters: -1" << endl;
+  for (int r = 0; r < Ncpu; r++) {
+    const double *cpuValues(&all[r * numberValues]);
+    for (unsigned int o = 0; o < order.size(); o++) {
+      int t(order[o]);
+      const double *values(&cpuValues[t * numberTypesCounter]);
+      fileStream << r << " \"" << globalPaths[t] << "\"";
+      for (int c = 0; c < numberTypesCounter; c++) { fileStream << " " << (m_counters.isAvailable(c) ? static_cast<long long>(values[c]) : -1LL); }
+      fileStream << " " << counterRatio(m_counters, values, counterInstructions, counterCycles)
+        << " " << counterPerCellUpdate(m_counters, values, counterCacheMisses, cpuValues[numberValues - 1])
+        << " " << counterPerCellUpdate(m_counters, values, counterBranchMisses, cpuValues[numberValues - 1]) << endl;
+    }
+  }
+  fileStream.close();
+}
+
+//***********************************************************************
+
+void Profiler::gatherPaths(vector<string> &paths, vector<string> &globalPaths) const
+{
+  paths.assign(m_timers.size(), "");
+  for (unsigned int t = 1; t < m_timers.size(); t++) {
+    paths[t] = (m_timers[t].parent == 0) ? string(m_timers[t].name) : paths[m_timers[t].parent] + "/" + m_timers[t].name;
+  }
+
+  //Union of the paths of all CPUs (a parent is always listed before its children)
+  globalPaths.assign(paths.begin() + 1, paths.end());
+  if (Ncpu > 1) {
+    string localList;
+    for (unsigned int t = 1; t < paths.size(); t++) { localList += paths[t] + "\n"; }
+    int localSize(localList.size());
+    vector<int> sizes(Ncpu), displacements(Ncpu, 0);
+    MPI_Gather(&localSize, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, commCompute);
+    string allLists;
+    if (rankCpu == 0) {
+      for (int r = 1; r < Ncpu; r++) { displacements[r] = displacements[r - 1] + sizes[r - 1]; }
+      allLists.resize(displacements[Ncpu - 1] + sizes[Ncpu - 1]);
+    }
+    MPI_Gatherv(&localList[0], localSize, MPI_CHAR, &allLists[0], sizes.data(), displacements.data(), MPI_CHAR, 0, commCompute);
+    string globalList;
+    if (rankCpu == 0) {
+      map<string, bool> known;
+      istringstream stream(allLists);
+      string path;
+      while (getline(stream, path)) {
+        if (!known[path]) { known[path] = true; globalList += path + "\n"; }
+      }
+    }
+    int globalSize(globalList.size());
+    MPI_Bcast(&globalSize, 1, MPI_INT, 0, commCompute);
+    globalList.resize(globalSize);
+    MPI_Bcast(&globalList[0], globalSize, MPI_CHAR, 0, commCompute);
+    globalPaths.clear();
+    istringstream stream(globalList);
+    string path;
+    while (getline(stream, path)) { globalPaths.push_back(path); }
+  }
+}
+
+//***********************************************************************
+
+void Profiler::treeOrder(const vector<string> &globalPaths, vector<int> &order, vector<int> &depth)
+{
+  map<string, vector<int> > children;
+  for (unsigned int t = 0; t < globalPaths.size(); t++) {
+    size_t slash(globalPaths[t].rfind('/'));
+    children[(slash == string::npos) ? "" : globalPaths[t].substr(0, slash)].push_back(t);
+  }
+  order.clear(); depth.clear();
+  vector<int> stack;
+  vector<int> roots(children[""]);
+  for (int r = roots.size() - 1; r >= 0; r--) { stack.push_back(roots[r]); }
+  vector<int> stackDepth(stack.size(), 0);
+  while (!stack.empty()) {
+    int t(stack.back()); int d(stackDepth.back());
+    stack.pop_back(); stackDepth.pop_back();
+    order.push_back(t); depth.push_back(d);
+    map<string, vector<int> >::const_iterator it(children.find(globalPaths[t]));
+    if (it == children.end()) continue;
+    for (int c = it->second.size() - 1; c >= 0; c--) { stack.push_back(it->second[c]); stackDepth.push_back(d + 1); }
+  }
+}
+
+//***********************************************************************
+
+ScopedTimer::ScopedTimer(const char* name) : m_timer(profiler.start(name)) {}
+
+//***********************************************************************
+
+ScopedTimer::~ScopedTimer() { profiler.stop(m_timer); }
+
+//***********************************************************************
+
+Tracer::Tracer() : m_active(false), m_recording(false), m_printed(false), m_firstIteration(0), m_lastIteration(-1), m_droppedEvents(0), m_origin(0.) {}
+
+//***********************************************************************
+
+Tracer::~Tracer(){}
+
+//***********************************************************************
+
+void Tracer::initialize(const string &folder, const int &maxEvents, const int &firstIteration, const int &lastIteration)
+{
+  stringstream file;
+  file << folder << "trace_CPU" << rankCpu << ".json";
+  m_file = file.str();
+  m_firstIteration = firstIteration;
+  m_lastIteration = lastIteration;
+  m_events.clear();
+  m_events.reserve(maxEvents);
+  m_droppedEvents = 0;
+  m_active = true;
+  m_recording = false;
+  m_printed = false;
+  //Common origin for all the CPUs
+  MPI_Barrier(commCompute);
+  m_origin = timeStats::wallTime();
+}
+
+//***********************************************************************
+
+void Tracer::deactivate()
+{
+  m_active = false;
+  m_recording = false;
+  vector<Event>().swap(m_events);
+}
+
+//***********************************************************************
+
+void Tracer::newIteration(const int &iteration)
+{
+  if (!m_active || m_printed) return;
+  if (m_lastIteration >= 0 && iteration > m_lastIteration) {
+    m_recording = false;
+    this->ecritTrace();
+    return;
+  }
+  m_recording = (iteration >= m_firstIteration);
+}
+
+//***********************************************************************
+
+void Tracer::finalize()
+{
+  if (!m_active || m_printed) return;
+  m_recording = false;
+  this->ecritTrace();
+}
+
+//***********************************************************************
+
+void Tracer::addEvent(const char* name, const int &level, const double &start, const double &end)
+{
+  if (m_events.size() == m_events.capacity()) { m_droppedEvents++; return; }
+  Event event;
+  event.name = name;
+  event.level = level;
+  event.start = start;
+  event.duration = end - start;
+  m_events.push_back(event);
+}
+
+//***********************************************************************
+
+void Tracer::ecritTrace()
+{
+  ofstream fileStream(m_file.c_str(), ios::out | ios::trunc);
+  if (!fileStream) {
+    cerr << "Warning: trace file can not be opened: " << m_file << endl;
+  }
+  else {
+    //Timestamps and durations in microseconds
+    fileStream << fixed << setprecision(3);
+    fileStream << "{\"traceEvents\":[" << endl;
+    fileStream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rankCpu << ",\"tid\":0,\"args\":{\"name\":\"CPU " << rankCpu << "\"}}";
+    for (unsigned int e = 0; e < m_events.size(); e++) {
+      const Event &event(m_events[e]);
+      const char* category("solver");
+      if (event.level >= 0) category = "level";
+      else if (strncmp(event.name, "communications", 14) == 0) category = "communication";
+      fileStream << "," << endl << "{\"name\":\"" << event.name << "\",\"cat\":\"" << category << "\",\"ph\":\"X\",\"pid\":" << rankCpu << ",\"tid\":0"
+        << ",\"ts\":" << 1.e6*(event.start - m_origin) << ",\"dur\":" << 1.e6*event.duration;
+      if (event.level >= 0) fileStream << ",\"args\":{\"level\":" << event.level << "}";
+      fileStream << "}";
+    }
+    fileStream << endl << "],\"displayTimeUnit\":\"ms\",\"otherData\":{\"cpu\":" << rankCpu << ",\"droppedEvents\":" << m_droppedEvents << "}}" << endl;
+    fileStream.close();
+  }
+  if (m_droppedEvents > 0) cout << "Warning: " << m_droppedEvents << " trace events dropped on CPU " << rankCpu << " (increase maxEvents)" << endl;
+  m_printed = true;
+  vector<Event>().swap(m_events);
+}
+
+//***********************************************************************
+
+ScopedTrace::ScopedTrace(const char* name, const int &level) :
+  m_name(name), m_level(level), m_recorded(tracer.isRecording()), m_start(m_recorded ? timeStats::wallTime() : 0.) {}
+
+//***********************************************************************
+
+ScopedTrace::~ScopedTrace()
+{
+  if (m_recorded && tracer.isRecording()) tracer.addEvent(m_name, m_level, m_start, timeStats::wallTime());
+}
+
+//***********************************************************************
+
@@ -37,7 +37,46 @@
 
 #include <ctime>
 #include <string>
+#include <vector>
+#include <chrono>
 
+//! \class     Throughput
+//! \brief     Leaf-cell updates per second and remaining time estimate over a rolling window
+//! \details   Each update() computes the metrics since the previous one and starts a new window. AMR sub-steps are included
+//!            in the cell updates, so that the figure stays comparable whatever the refinement.
+class Throughput
+{
+  public:
+    Throughput();
+    virtual ~Throughput();
+
+    //! \brief    Start a window without computing any metric
+    //! \param    cellUpdates    leaf-cell updates on this CPU since initialization
+    //! \param    progress       fraction of the computation already done (physical time or iterations)
+    void reset(const long long &cellUpdates, const double &progress);
+    //! \brief    Compute the metrics over the window ended now and start a new one (to be called by all CPUs)
+    //! \param    cellUpdates    leaf-cell updates on this CPU since initialization
+    //! \param    progress       fraction of the computation already done (physical time or iterations)
+    void update(const long long &cellUpdates, const double &progress);
+
+    double getCellUpdatesPerSecond() const { return m_rate; };             //!<This CPU
+    double getCellUpdatesPerSecondMin() const { return m_rateMin; };       //!<Slowest CPU
+    double getCellUpdatesPerSecondMax() const { return m_rateMax; };       //!<Fastest CPU
+    double getCellUpdatesPerSecondGlobal() const { return m_rateGlobal; }; //!<Sum over the CPUs
+    double getCellUpdatesGlobal() const { return m_cellUpdatesGlobal; };   //!<Cell updates of all CPUs over the window
+    double getRemainingTime() const { return m_remainingTime; };           //!<Estimated wall-clock time to the end of the computation (s), negative if unknown
+
+  private:
+    double m_startTime;                   //!<Wall-clock time at the beginning of the window (s)
+    long long m_startCellUpdates;         //!<Cell updates at the beginning of the window
+    double m_startProgress;               //!<Progress at the beginning of the window
+    double m_rate, m_rateMin, m_rateMax, m_rateGlobal;
+    double m_cellUpdatesGlobal;
+    double m_remainingTime;
+};
+
+//! \class     timeStats
+//! \brief     Wall-clock statistics of the computation (total and AMR times)
 class timeStats
 {
   public:
@@ -50,19 +89,215 @@ class timeStats
     void startAMRTime();
     void endAMRTime();
 
+    //! \brief    Set the computation time (on restart)
+    //! \param    time    computation time in CLOCKS_PER_SEC units, as returned by getComputationTime()
     void setCompTime(const clock_t &time);
+    //! \brief    Computation time in CLOCKS_PER_SEC units (unit kept for infoCalcul.out and checkpoint files)
     clock_t getComputationTime() const;
-    void printScreenStats(const int &numTest) const;
-    void printScreenTime(const clock_t &time, std::string chaine, const int &numTest) const;
+    //! \brief    Computation time in seconds
+    double getComputationTimeSeconds() const { return m_computationTime; };
+    void printScreenStats(const int &numTest, const Throughput &throughput) const;
+    void printScreenTime(const double &time, std::string chaine, const int &numTest) const;
+    //! \brief    Duration in s, min s or h min s
+    static std::string formatTime(const double &time);
+
+    //! \brief    Count the leaf cells updated by one (sub-)time step
+    void addCellUpdates(const long long &number) { m_cellUpdates += number; };
+    //! \brief    Leaf-cell updates on this CPU since initialization (AMR sub-steps included)
+    long long getCellUpdates() const { return m_cellUpdates; };
+
+    //! \brief    Current wall-clock time in seconds (monotonic, arbitrary origin)
+    static double wallTime();
 
   private:
-    //Time analysis - Attributes are stored in miliseconds (to be divided by CLOCKS_PER_SEC)
-    clock_t m_InitialTime;
-    clock_t m_computationTime;            //!<Computation time
+    //Time analysis - Attributes are wall-clock times stored in seconds
+    double m_InitialTime;
+    double m_computationTime;             //!<Computation time
     
-    clock_t m_AMRRefTime;
-    clock_t m_AMRTime;                    //!<AMR additional time
+    double m_AMRRefTime;
+    double m_AMRTime;                     //!<AMR additional time
+
+    long long m_cellUpdates;              //!<Leaf-cell updates on this CPU
 
 };
 
+enum TypeCounter { counterCycles, counterInstructions, counterCacheMisses, counterBranchMisses, numberTypesCounter };
+
+//! \class     HardwareCounters
+//! \brief     Optional hardware performance counters of the process (Linux perf_event interface, user space only)
+//! \details   The counters are opened as a single group so that all of them are read by one system call. A counter not supported
+//!            by the processor, the kernel or the perf_event_paranoid setting on any CPU is reported as unavailable and the
+//!            computation goes on without it.
+class HardwareCounters
+{
+  public:
+    HardwareCounters();
+    virtual ~HardwareCounters();
+
+    //! \brief    Open the counters available on all the CPUs (to be called by all CPUs)
+    //! \return   true if at least one counter is available
+    bool initialize();
+    //! \brief    Close the counters
+    void deactivate();
+    bool isActive() const { return m_active; };
+    bool isAvailable(const int &counter) const { return m_position[counter] >= 0; };
+    //! \brief    Values of the counters since their opening (0 for the unavailable ones)
+    void read(long long *values) const;
+    static const char* getName(const int &counter);
+
+  private:
+    //! \brief    Open the given counters in a single group
+    //! \param    requested    counters to open
+    //! \return   number of opened counters
+    int open(const bool *requested);
+
+    bool m_active;                             //!<At least one counter opened
+    int m_fd[numberTypesCounter];              //!<File descriptors of the counters (-1 if not opened), the first opened one leading the group
+    int m_position[numberTypesCounter];        //!<Position of the counters in the group reading (-1 if not opened)
+    int m_numberOpened;                        //!<Number of opened counters
+};
+
+//! \class     Profiler
+//! \brief     Hierarchical wall-clock profiler
+//! \details   Timers are opened and closed through the PROFILE_SCOPE macro. A timer opened while another one is running is
+//!            recorded as its child, so that the same phase (e.g. communications) is accounted separately for each calling phase.
+//!            Statistics over the CPUs (min/max/average) are printed by printStats(). When hardware counters are activated, they
+//!            are read at each opening and closing of a timer and printed by printCounters().
+class Profiler
+{
+  public:
+    Profiler();
+    virtual ~Profiler();
+
+    //! \brief    Clear all the timers
+    void reset();
+    //! \brief    Open the timer named name as a child of the running one
+    //! \return   index of the opened timer, to be given back to stop()
+    int start(const char* name);
+    //! \brief    Close the timer opened by start()
+    void stop(const int &timer);
+    //! \brief    Print per-CPU min/max/average of each timer (to be called by all CPUs)
+    //! \param    numTest        number of the test case
+    //! \param    elapsedTime    reference wall-clock time for percentages (s)
+    void printStats(const int &numTest, const double &elapsedTime) const;
+    //! \brief    Activate the hardware counters (to be called by all CPUs)
+    void initializeCounters();
+    //! \brief    Deactivate the hardware counters
+    void deactivateCounters();
+    //! \brief    Print the hardware counters of each timer summed over the CPUs, and per CPU in perfCounters.out (to be called by all CPUs)
+    //! \param    numTest        number of the test case
+    //! \param    cellUpdates    leaf-cell updates on this CPU since the last reset
+    //! \param    folder         results folder
+    void printCounters(const int &numTest, const long long &cellUpdates, const std::string &folder) const;
+
+  private:
+    //! \brief    Full paths of the local timers and union of the paths of all CPUs (a parent always listed before its children)
+    void gatherPaths(std::vector<std::string> &paths, std::vector<std::string> &globalPaths) const;
+    //! \brief    Printing order of the timers as a tree (children just after their parent) and corresponding depths
+    static void treeOrder(const std::vector<std::string> &globalPaths, std::vector<int> &order, std::vector<int> &depth);
+
+    struct Timer
+    {
+      const char* name;                   //!<Name of the timer (string literal)
+      int parent;                         //!<Index of the parent timer (-1 for the root)
+      std::vector<int> children;          //!<Indexes of the child timers
+      double time;                        //!<Accumulated wall-clock time (s)
+      double startTime;                   //!<Wall-clock time of the last opening (s)
+      long long calls;                    //!<Number of openings
+      long long counts[numberTypesCounter];      //!<Accumulated hardware counters
+      long long startCounts[numberTypesCounter]; //!<Hardware counters at the last opening
+    };
+
+    std::vector<Timer> m_timers;          //!<Timers tree, m_timers[0] being the root
+    int m_current;                        //!<Index of the running timer
+    HardwareCounters m_counters;          //!<Optional hardware counters
+};
+
+//! \class     Tracer
+//! \brief     Optional per-CPU event tracer exported in Chrome trace format (chrome://tracing, Perfetto)
+//! \details   When recording, each closed profiler timer and each traced scope (e.g. AMR levels) is stored as a complete event
+//!            in a buffer of bounded size allocated at activation. Events exceeding the buffer are dropped and counted.
+//!            When inactive, the cost is a single test per closed timer.
+class Tracer
+{
+  public:
+    Tracer();
+    virtual ~Tracer();
+
+    //! \brief    Activate the tracer
+    //! \param    folder            results folder where trace_CPU<rank>.json is printed
+    //! \param    maxEvents         size of the events buffer
+    //! \param    firstIteration    first traced iteration
+    //! \param    lastIteration     last traced iteration (negative: until the end of the run)
+    void initialize(const std::string &folder, const int &maxEvents, const int &firstIteration, const int &lastIteration);
+    //! \brief    Deactivate the tracer and free its buffer
+    void deactivate();
+    //! \brief    Start or stop the recording according to the traced iterations window, print the trace once the window is over
+    void newIteration(const int &iteration);
+    //! \brief    Print the trace if not already done (to be called at the end of the run)
+    void finalize();
+
+    bool isRecording() const { return m_recording; };
+    //! \brief    Store a complete event (start and end wall-clock times in s)
+    void addEvent(const char* name, const int &level, const double &start, const double &end);
+
+  private:
+    //! \brief    Print the recorded events in trace_CPU<rank>.json
+    void ecritTrace();
+
+    struct Event
+    {
+      const char* name;                   //!<Name of the event (string literal)
+      int level;                          //!<AMR level (-1 if not relevant)
+      double start;                       //!<Start wall-clock time (s)
+      double duration;                    //!<Duration (s)
+    };
+
+    bool m_active;                        //!<Tracer requested for the run
+    bool m_recording;                     //!<Events currently recorded
+    bool m_printed;                       //!<Trace already printed
+    int m_firstIteration, m_lastIteration; //!<Traced iterations window
+    std::vector<Event> m_events;          //!<Events buffer (capacity fixed at activation)
+    long long m_droppedEvents;            //!<Events not recorded because the buffer was full
+    double m_origin;                      //!<Wall-clock time origin of the trace (s)
+    std::string m_file;                   //!<Trace file name
+};
+
+//! \class     ScopedTimer
+//! \brief     Timer of the profiler running during the lifetime of the object
+class ScopedTimer
+{
+  public:
+    ScopedTimer(const char* name);
+    ~ScopedTimer();
+
+  private:
+    int m_timer;
+};
+
+//! \class     ScopedTrace
+//! \brief     Event of the tracer lasting during the lifetime of the object (not accounted in the profiler)
+class ScopedTrace
+{
+  public:
+    ScopedTrace(const char* name, const int &level);
+    ~ScopedTrace();
+
+  private:
+    const char* m_name;
+    int m_level;
+    bool m_recorded;
+    double m_start;
+};
+
+extern Profiler profiler;
+extern Tracer tracer;
+
+#define PROFILE_CONCAT2(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT2(a, b)
+//! \brief    Time the enclosing scope under the given name
+#define PROFILE_SCOPE(name) ScopedTimer PROFILE_CONCAT(scopedTimer, __LINE__)(name)
+//! \brief    Trace the enclosing scope under the given name and AMR level (only recorded when the tracer is active)
+#define TRACE_SCOPE(name, level) ScopedTrace PROFILE_CONCAT(scopedTrace, __LINE__)(name, level)
+
 #endif // TIMESTATS_H
\ No newline at end of file